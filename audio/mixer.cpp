@@ -21,6 +21,7 @@
 
 #include "gui/EventRecorder.h"
 
+#include "common/profiler.h"
 #include "common/util.h"
 #include "common/textconsole.h"
 
@@ -331,6 +332,9 @@ void MixerImpl::playStream(
 int MixerImpl::mixCallback(byte *samples, uint len) {
 	assert(samples);
 
+	PROFILE_THREAD("Audio");
+	PROFILE_ZONE("mixCallback");
+
 	Common::StackLock lock(_mutex);
 
 	int16 *buf = (int16 *)samples;
@@ -25,6 +25,7 @@
 
 #include "common/system.h"
 #include "common/config-manager.h"
+#include "common/profiler.h"
 #include "common/translation.h"
 #include "backends/events/default/default-events.h"
 #include "backends/keymapper/action.h"
@@ -80,11 +81,16 @@ void DefaultEventManager::init() {
 }
 
 bool DefaultEventManager::pollEvent(Common::Event &event) {
+	PROFILE_ZONE("pollEvent");
+
 	_dispatcher.dispatch();
 
-	if (g_engine)
+	if (g_engine) {
+		PROFILE_ZONE("Engine::handleAutoSave");
+
 		// Handle autosaves if enabled
 		g_engine->handleAutoSave();
+	}
 
 	if (_eventQueue.empty()) {
 		return false;
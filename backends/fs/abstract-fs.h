@@ -182,6 +182,19 @@ public:
 	 */
 	virtual Common::SeekableReadStream *createReadStream() = 0;
 
+	/**
+	 * Creates a SeekableReadStream instance corresponding to the file
+	 * referred by this node, which may be backed by a memory mapping of
+	 * the file. Only use this for files which nothing writes to while
+	 * the stream exists, such as game data: depending on the backend,
+	 * truncating a mapped file can crash on the next read.
+	 *
+	 * The default implementation calls createReadStream().
+	 *
+	 * @return pointer to the stream object, 0 in case of a failure
+	 */
+	virtual Common::SeekableReadStream *createMappedReadStream() { return createReadStream(); }
+
 	/**
 	 * Creates a SeekableReadStream instance corresponding to an alternate
 	 * stream of the file referred by this node. This assumes that the node
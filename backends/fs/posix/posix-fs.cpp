@@ -279,6 +279,14 @@ Common::SeekableReadStream *POSIXFilesystemNode::createReadStream() {
 	return PosixIoStream::makeFromPath(getPath(), StdioStream::WriteMode_Read);
 }
 
+Common::SeekableReadStream *POSIXFilesystemNode::createMappedReadStream() {
+	Common::SeekableReadStream *stream = PosixIoStream::makeMappedFromPath(getPath());
+	if (stream)
+		return stream;
+
+	return createReadStream();
+}
+
 Common::SeekableReadStream *POSIXFilesystemNode::createReadStreamForAltStream(Common::AltStreamType altStreamType) {
 #ifdef MACOSX
 	if (altStreamType == Common::AltStreamType::MacResourceFork) {
@@ -22,8 +22,63 @@
 #define FORBIDDEN_SYMBOL_ALLOW_ALL
 
 #include "backends/fs/posix/posix-iostream.h"
+#include "common/memstream.h"
 
 #include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(_POSIX_MAPPED_FILES) && _POSIX_MAPPED_FILES > 0
+#include <fcntl.h>
+#include <sys/mman.h>
+
+namespace {
+
+// Below this, reading through stdio is cheaper than setting up a mapping
+const off_t kMinMappedSize = 64 * 1024;
+// Keep clear of the 32-bit stream size limit, and of exhausting the
+// address space on 32-bit hosts
+const off_t kMaxMappedSize = sizeof(void *) >= 8 ? 0x7FFFFFFF : 64 * 1024 * 1024;
+
+struct MunmapDeleter {
+	size_t _size;
+
+	MunmapDeleter(size_t size) : _size(size) {}
+	void operator()(byte *ptr) { munmap(ptr, _size); }
+};
+
+} // End of anonymous namespace
+
+Common::SeekableReadStream *PosixIoStream::makeMappedFromPath(const Common::String &path) {
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd == -1)
+		return nullptr;
+
+	struct stat st;
+	if (fstat(fd, &st) == -1 || !S_ISREG(st.st_mode) || st.st_size < kMinMappedSize || st.st_size > kMaxMappedSize) {
+		close(fd);
+		return nullptr;
+	}
+
+	size_t size = st.st_size;
+	void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+	// The mapping stays valid after the descriptor is closed
+	close(fd);
+
+	if (mapping == MAP_FAILED)
+		return nullptr;
+
+	Common::SharedPtr<byte> data((byte *)mapping, MunmapDeleter(size));
+	return new Common::MemoryReadStream(data, size);
+}
+
+#else
+
+Common::SeekableReadStream *PosixIoStream::makeMappedFromPath(const Common::String &path) {
+	return nullptr;
+}
+
+#endif
 
 PosixIoStream::PosixIoStream(void *handle) :
 		StdioStream(handle) {
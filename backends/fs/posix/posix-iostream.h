@@ -36,6 +36,19 @@ public:
 	}
 	PosixIoStream(void *handle);
 
+	/**
+	 * Map a file into memory for reading. The resulting stream hands out
+	 * views of the mapping from readStream() instead of copies.
+	 *
+	 * Reading from the stream after the file was truncated raises SIGBUS,
+	 * so this must only be used for files which are not written to, see
+	 * AbstractFSNode::createMappedReadStream().
+	 *
+	 * @return The stream, or nullptr if the file is too small or too big to
+	 *         be worth mapping, or mapping failed; use makeFromPath() then.
+	 */
+	static Common::SeekableReadStream *makeMappedFromPath(const Common::String &path);
+
 	int64 size() const override;
 };
 
@@ -0,0 +1,138 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "backends/imgui/IconsMaterialSymbols.h"
+#include "backends/imgui/imgui_utils.h"
+#include "common/algorithm.h"
+#include "common/savefile.h"
+#include "common/system.h"
+
+#include "backends/imgui/components/imgui_profiler.h"
+
+namespace ImGuiEx {
+
+namespace {
+
+bool compareAverage(const Common::ProfileZoneStats &a, const Common::ProfileZoneStats &b) {
+	return a.average > b.average;
+}
+
+} // End of anonymous namespace
+
+bool ImGuiProfiler::exportTrace(const Common::String &filename) {
+	Common::OutSaveFile *file = g_system->getSavefileManager()->openForSaving(filename, false);
+	if (!file)
+		return false;
+
+	bool success = Common::Profiler::instance().exportChromeTrace(*file);
+	file->finalize();
+	success = success && !file->err();
+	delete file;
+	return success;
+}
+
+void ImGuiProfiler::draw(const char *title, bool *p_open) {
+	if (!*p_open || !Common::Profiler::hasInstance())
+		return;
+
+	Common::Profiler &profiler = Common::Profiler::instance();
+
+	ImGui::SetNextWindowSize(ImVec2(480, 520), ImGuiCond_FirstUseEver);
+	if (!ImGui::Begin(title, p_open)) {
+		ImGui::End();
+		return;
+	}
+
+	bool paused = profiler.isPaused();
+	if (ImGuiEx::toggleButton(ICON_MS_PAUSE, &paused))
+		profiler.setPaused(paused);
+	ImGui::SetItemTooltip("Pause recording");
+	ImGui::SameLine();
+
+	if (ImGui::Button(ICON_MS_RESTART_ALT))
+		profiler.reset();
+	ImGui::SetItemTooltip("Reset");
+	ImGui::SameLine();
+
+	if (ImGui::Button(ICON_MS_DOWNLOAD)) {
+		const char *filename = "scummvm-trace.json";
+		if (exportTrace(filename))
+			_exportStatus = Common::String::format("Saved %s", filename);
+		else
+			_exportStatus = Common::String::format("Could not write %s", filename);
+	}
+	ImGui::SetItemTooltip("Export a Chrome trace to the save directory");
+
+	if (!_exportStatus.empty()) {
+		ImGui::SameLine();
+		ImGui::TextUnformatted(_exportStatus.c_str());
+	}
+
+	// Frame times
+	profiler.getFrameTimes(_frameTimes);
+	float average = 0.0f, peak = 0.0f;
+	for (uint i = 0; i < _frameTimes.size(); i++) {
+		average += _frameTimes[i];
+		peak = MAX(peak, _frameTimes[i]);
+	}
+	if (!_frameTimes.empty())
+		average /= _frameTimes.size();
+
+	Common::String overlay = Common::String::format("avg %.2f ms, max %.2f ms", average / 1000.0f, peak / 1000.0f);
+	ImGui::PlotHistogram("##FrameTimes", _frameTimes.begin(), _frameTimes.size(), 0, overlay.c_str(),
+	                     0.0f, MAX(peak, 1000.0f), ImVec2(-1.0f, 80.0f));
+
+	// Zones, sorted by their average time per frame
+	profiler.getZoneStats(_zoneStats);
+	Common::sort(_zoneStats.begin(), _zoneStats.end(), compareAverage);
+
+	const ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_ScrollY | ImGuiTableFlags_SizingStretchProp;
+	if (ImGui::BeginTable("Zones", 5, flags)) {
+		ImGui::TableSetupScrollFreeze(0, 1);
+		ImGui::TableSetupColumn("Zone", ImGuiTableColumnFlags_WidthStretch, 3.0f);
+		ImGui::TableSetupColumn("Calls");
+		ImGui::TableSetupColumn("Last (ms)");
+		ImGui::TableSetupColumn("Avg (ms)");
+		ImGui::TableSetupColumn("Max (ms)");
+		ImGui::TableHeadersRow();
+
+		for (uint i = 0; i < _zoneStats.size(); i++) {
+			const Common::ProfileZoneStats &stats = _zoneStats[i];
+
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(stats.name);
+			ImGui::TableNextColumn();
+			ImGui::Text("%u", stats.calls);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.3f", stats.last / 1000.0f);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.3f", stats.average / 1000.0f);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.3f", stats.peak / 1000.0f);
+		}
+		ImGui::EndTable();
+	}
+
+	ImGui::End();
+}
+
+} // namespace ImGuiEx
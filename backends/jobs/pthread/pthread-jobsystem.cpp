@@ -0,0 +1,178 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#define FORBIDDEN_SYMBOL_EXCEPTION_time_h
+#define FORBIDDEN_SYMBOL_EXCEPTION_unistd_h
+
+#include "backends/jobs/pthread/pthread-jobsystem.h"
+
+#include "common/array.h"
+#include "common/queue.h"
+#include "common/textconsole.h"
+
+#include <pthread.h>
+#include <unistd.h>
+
+/**
+ * pthreads job system: a fixed pool of workers pulling from a single queue
+ */
+class PthreadJobSystem final : public Common::JobSystem {
+public:
+	PthreadJobSystem(uint workerCount);
+	~PthreadJobSystem() override;
+
+	uint getWorkerCount() const override { return _threads.size(); }
+
+protected:
+	void submit(const Common::Job &job) override;
+	void wait(Common::JobGroup &group) override;
+	bool isDone(const Common::JobGroup &group) const override;
+
+private:
+	struct Worker {
+		PthreadJobSystem *system;
+		uint index;
+	};
+
+	static void *workerMain(void *param);
+
+	/** Run a queued job; expects the lock to be held, and keeps it held on return. */
+	void runQueuedJob(uint worker);
+
+	mutable pthread_mutex_t _mutex;
+	pthread_cond_t _workCond;
+	pthread_cond_t _doneCond;
+
+	Common::Queue<Common::Job> _queue;
+	Common::Array<pthread_t> _threads;
+	Common::Array<Worker> _workers;
+	bool _quit;
+};
+
+PthreadJobSystem::PthreadJobSystem(uint workerCount) : _quit(false) {
+	pthread_mutex_init(&_mutex, nullptr);
+	pthread_cond_init(&_workCond, nullptr);
+	pthread_cond_init(&_doneCond, nullptr);
+
+	_workers.resize(workerCount);
+	_threads.reserve(workerCount);
+
+	for (uint i = 0; i < workerCount; i++) {
+		_workers[i].system = this;
+		_workers[i].index = i + 1;
+
+		pthread_t thread;
+		if (pthread_create(&thread, nullptr, &workerMain, &_workers[i]) != 0) {
+			warning("pthread_create() failed, using %u job workers", _threads.size());
+			break;
+		}
+		_threads.push_back(thread);
+	}
+}
+
+PthreadJobSystem::~PthreadJobSystem() {
+	pthread_mutex_lock(&_mutex);
+	_quit = true;
+	pthread_cond_broadcast(&_workCond);
+	pthread_mutex_unlock(&_mutex);
+
+	for (uint i = 0; i < _threads.size(); i++)
+		pthread_join(_threads[i], nullptr);
+
+	pthread_cond_destroy(&_doneCond);
+	pthread_cond_destroy(&_workCond);
+	pthread_mutex_destroy(&_mutex);
+}
+
+void *PthreadJobSystem::workerMain(void *param) {
+	const Worker *worker = (const Worker *)param;
+	PthreadJobSystem *system = worker->system;
+
+	pthread_mutex_lock(&system->_mutex);
+
+	while (!system->_quit) {
+		if (system->_queue.empty())
+			pthread_cond_wait(&system->_workCond, &system->_mutex);
+		else
+			system->runQueuedJob(worker->index);
+	}
+
+	pthread_mutex_unlock(&system->_mutex);
+	return nullptr;
+}
+
+void PthreadJobSystem::runQueuedJob(uint worker) {
+	Common::Job job = _queue.pop();
+
+	pthread_mutex_unlock(&_mutex);
+	execute(job, worker);
+	pthread_mutex_lock(&_mutex);
+
+	if (finishJob(job))
+		pthread_cond_broadcast(&_doneCond);
+}
+
+void PthreadJobSystem::submit(const Common::Job &job) {
+	pthread_mutex_lock(&_mutex);
+	startJob(job);
+	_queue.push(job);
+	pthread_cond_signal(&_workCond);
+	pthread_mutex_unlock(&_mutex);
+}
+
+void PthreadJobSystem::wait(Common::JobGroup &group) {
+	pthread_mutex_lock(&_mutex);
+
+	// Help out instead of just sleeping; this also lets jobs wait for
+	// groups of their own without starving the pool
+	while (hasPendingJobs(group)) {
+		if (_queue.empty())
+			pthread_cond_wait(&_doneCond, &_mutex);
+		else
+			runQueuedJob(0);
+	}
+
+	pthread_mutex_unlock(&_mutex);
+}
+
+bool PthreadJobSystem::isDone(const Common::JobGroup &group) const {
+	pthread_mutex_lock(&_mutex);
+	bool done = !hasPendingJobs(group);
+	pthread_mutex_unlock(&_mutex);
+	return done;
+}
+
+Common::JobSystem *createPthreadJobSystem(uint workerCount) {
+	const uint kMaxWorkers = 15;
+
+	if (workerCount == 0) {
+#ifdef _SC_NPROCESSORS_ONLN
+		long cpuCount = sysconf(_SC_NPROCESSORS_ONLN);
+		if (cpuCount > 1)
+			workerCount = MIN<uint>(cpuCount - 1, kMaxWorkers);
+#endif
+	}
+
+	if (workerCount == 0)
+		return new Common::JobSystem();
+
+	return new PthreadJobSystem(workerCount);
+}
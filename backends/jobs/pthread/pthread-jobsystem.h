@@ -0,0 +1,36 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BACKENDS_JOBS_PTHREAD_H
+#define BACKENDS_JOBS_PTHREAD_H
+
+#include "common/jobsystem.h"
+
+/**
+ * Create a job system backed by a pool of pthreads.
+ *
+ * @param workerCount  Number of worker threads; zero picks one less than
+ *                     the number of online processors. If that ends up
+ *                     being zero, a plain inline JobSystem is returned.
+ */
+Common::JobSystem *createPthreadJobSystem(uint workerCount = 0);
+
+#endif
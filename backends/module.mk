@@ -24,6 +24,7 @@ MODULE_OBJS := \
 	midi/stmidi.o \
 	midi/timidity.o \
 	saves/savefile.o \
+	saves/default/async-save-writer.o \
 	saves/default/default-saves.o \
 	timer/default/default-timer.o
 
@@ -263,6 +264,11 @@ MODULE_OBJS += \
 	taskbar/unity/unity-taskbar.o \
 	dialogs/gtk/gtk-dialogs.o
 
+ifdef USE_PTHREADS
+MODULE_OBJS += \
+	jobs/pthread/pthread-jobsystem.o
+endif
+
 ifdef USE_SPEECH_DISPATCHER
 ifdef USE_TTS
 MODULE_OBJS += \
@@ -508,6 +514,11 @@ MODULE_OBJS += \
 	imgui/imgui_utils.o \
 	imgui/components/imgui_logger.o \
 	imgui/misc/freetype/imgui_freetype.o
+
+ifdef ENABLE_PROFILER
+MODULE_OBJS += \
+	imgui/components/imgui_profiler.o
+endif
 endif
 
 ifdef USE_SDL2
@@ -39,6 +39,10 @@
 #include "backends/taskbar/unity/unity-taskbar.h"
 #include "backends/dialogs/gtk/gtk-dialogs.h"
 
+#ifdef USE_PTHREADS
+#include "backends/jobs/pthread/pthread-jobsystem.h"
+#endif
+
 #ifdef USE_LINUXCD
 #include "backends/audiocd/linux/linux-audiocd.h"
 #endif
@@ -83,6 +87,13 @@ void OSystem_POSIX::initBackend() {
 	if (_savefileManager == 0)
 		_savefileManager = new POSIXSaveFileManager();
 
+#ifdef USE_PTHREADS
+	// Create the job system; without it, OSystem::initBackend() falls
+	// back to running jobs inline
+	if (_jobSystem == 0)
+		_jobSystem = createPthreadJobSystem();
+#endif
+
 #if defined(USE_SPEECH_DISPATCHER) && defined(USE_TTS)
 	// Initialize Text to Speech manager
 	_textToSpeechManager = new SpeechDispatcherManager();
@@ -283,6 +294,31 @@ Common::Path OSystem_POSIX::getDefaultDLCsPath() {
 	return Common::Path(prefix).join(dlcsPath);
 }
 
+Common::Path OSystem_POSIX::getDefaultThemeCachePath() {
+	Common::String themesPath;
+
+	// On POSIX systems we follow the XDG Base Directory Specification for
+	// where to store files. The version we based our code upon can be found
+	// over here: https://specifications.freedesktop.org/basedir-spec/basedir-spec-0.8.html
+	const char *prefix = getenv("XDG_CACHE_HOME");
+	if (prefix == nullptr || !*prefix) {
+		prefix = getenv("HOME");
+		if (prefix == nullptr) {
+			return Common::Path();
+		}
+
+		themesPath = ".cache/";
+	}
+
+	themesPath += "scummvm/themes";
+
+	if (!Posix::assureDirectoryExists(themesPath, prefix)) {
+		return Common::Path();
+	}
+
+	return Common::Path(prefix).join(themesPath);
+}
+
 Common::Path OSystem_POSIX::getScreenshotsPath() {
 	// If the user has configured a screenshots path, use it
 	const Common::Path path = OSystem_SDL::getScreenshotsPath();
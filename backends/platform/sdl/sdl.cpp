@@ -386,6 +386,7 @@ void OSystem_SDL::initBackend() {
 
 	ConfMan.registerDefault("iconspath", this->getDefaultIconsPath());
 	ConfMan.registerDefault("dlcspath", this->getDefaultDLCsPath());
+	ConfMan.registerDefault("themecachepath", this->getDefaultThemeCachePath());
 
 	_inited = true;
 
@@ -850,6 +851,16 @@ uint32 OSystem_SDL::getMillis(bool skipRecord) {
 	return millis;
 }
 
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+uint64 OSystem_SDL::getMicros() {
+	const uint64 counter = SDL_GetPerformanceCounter();
+	const uint64 frequency = SDL_GetPerformanceFrequency();
+
+	// Split the conversion to avoid overflowing counter * 1000000
+	return (counter / frequency) * 1000000 + (counter % frequency) * 1000000 / frequency;
+}
+#endif
+
 void OSystem_SDL::delayMillis(uint msecs) {
 #ifdef ENABLE_EVENTRECORDER
 	if (!g_eventRec.processDelayMillis())
@@ -926,6 +937,13 @@ Common::Path OSystem_SDL::getDefaultDLCsPath() {
 	return path;
 }
 
+// Not specified in base class
+Common::Path OSystem_SDL::getDefaultThemeCachePath() {
+	// Parsed themes are only cached where the platform has a place for
+	// files which can be thrown away
+	return Common::Path();
+}
+
 //Not specified in base class
 Common::Path OSystem_SDL::getScreenshotsPath() {
 	return ConfMan.getPath("screenshotpath");
@@ -0,0 +1,203 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "backends/saves/default/async-save-writer.h"
+
+#include "common/compression/deflate.h"
+#include "common/jobsystem.h"
+#include "common/memstream.h"
+#include "common/stream.h"
+#include "common/textconsole.h"
+#include "common/util.h"
+
+struct AsyncSaveWriter::PendingSave {
+	PendingSave(Common::JobSystem *jobSystem, Common::SeekableWriteStream *file, const Common::FSNode &fileNode, const Common::String &name, byte *buffer, uint32 bufferSize, bool compressed)
+		: group(jobSystem), sf(file), node(fileNode), filename(name), data(buffer), size(bufferSize), compress(compressed), started(false), success(false) {}
+
+	~PendingSave() {
+		delete sf;
+		free(data);
+	}
+
+	static void write(void *param) {
+		PendingSave *save = (PendingSave *)param;
+
+		Common::WriteStream *const stream = save->compress ? Common::wrapCompressedWriteStream(save->sf) : save->sf;
+		stream->write(save->data, save->size);
+		stream->finalize();
+		save->success = !stream->err();
+		delete stream;
+		save->sf = nullptr;
+	}
+
+	Common::JobGroup group;
+	Common::SeekableWriteStream *sf;
+	Common::FSNode node;
+	Common::String filename;
+	/** Only freed on the main thread, so that pending contents can be read back. */
+	byte *data;
+	uint32 size;
+	bool compress;
+	bool started;
+	bool success;
+};
+
+AsyncSaveWriter::AsyncSaveWriter(Common::JobSystem *jobSystem) : _jobSystem(jobSystem) {
+}
+
+AsyncSaveWriter::~AsyncSaveWriter() {
+	wait();
+}
+
+void AsyncSaveWriter::queue(Common::SeekableWriteStream *file, const Common::FSNode &node, const Common::String &filename, byte *data, uint32 size, bool compress) {
+	PendingSave *save = new PendingSave(_jobSystem, file, node, filename, data, size, compress);
+	const bool deferred = isPending(filename);
+	_pendingSaves.push_back(save);
+	if (!deferred)
+		start(save);
+}
+
+bool AsyncSaveWriter::wait(const Common::String &filename) {
+	const uint failedCount = _failedFiles.size();
+
+	for (uint i = 0; i < _pendingSaves.size(); ) {
+		PendingSave *save = _pendingSaves[i];
+		if (!filename.empty() && !save->filename.equalsIgnoreCase(filename)) {
+			i++;
+			continue;
+		}
+
+		// The previous writes to the same file were finished already
+		if (!save->started)
+			start(save);
+
+		_pendingSaves.remove_at(i);
+		finish(save);
+	}
+
+	return _failedFiles.size() == failedCount;
+}
+
+void AsyncSaveWriter::reap() {
+	for (uint i = 0; i < _pendingSaves.size(); ) {
+		PendingSave *save = _pendingSaves[i];
+		if (!save->started || !save->group.isDone()) {
+			i++;
+			continue;
+		}
+
+		_pendingSaves.remove_at(i);
+		const Common::String filename = save->filename;
+		finish(save);
+
+		// Start the next write to the same file, if any
+		for (uint j = i; j < _pendingSaves.size(); j++) {
+			if (_pendingSaves[j]->filename.equalsIgnoreCase(filename)) {
+				start(_pendingSaves[j]);
+				break;
+			}
+		}
+	}
+}
+
+bool AsyncSaveWriter::isPending(const Common::String &filename) const {
+	return findLatest(filename) != nullptr;
+}
+
+void AsyncSaveWriter::cancel(const Common::String &filename) {
+	for (uint i = 0; i < _pendingSaves.size(); ) {
+		PendingSave *save = _pendingSaves[i];
+		if (save->started || !save->filename.equalsIgnoreCase(filename)) {
+			i++;
+			continue;
+		}
+
+		_pendingSaves.remove_at(i);
+		delete save;
+	}
+}
+
+Common::SeekableReadStream *AsyncSaveWriter::createReadStream(const Common::String &filename, bool raw) const {
+	const PendingSave *save = findLatest(filename);
+	if (!save)
+		return nullptr;
+
+	if (raw && save->compress) {
+		Common::MemoryWriteStreamDynamic *buffer = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+		Common::WriteStream *const stream = Common::wrapCompressedWriteStream(buffer);
+		stream->write(save->data, save->size);
+		stream->finalize();
+		byte *const data = buffer->getData();
+		const uint32 size = buffer->size();
+		delete stream;
+		return new Common::MemoryReadStream(data, size, DisposeAfterUse::YES);
+	}
+
+	byte *const data = (byte *)malloc(MAX<uint32>(save->size, 1));
+	if (save->size)
+		memcpy(data, save->data, save->size);
+	return new Common::MemoryReadStream(data, save->size, DisposeAfterUse::YES);
+}
+
+Common::FSList AsyncSaveWriter::getPendingFiles() const {
+	Common::FSList files;
+	for (uint i = 0; i < _pendingSaves.size(); i++) {
+		if (findLatest(_pendingSaves[i]->filename) == _pendingSaves[i])
+			files.push_back(_pendingSaves[i]->node);
+	}
+
+	return files;
+}
+
+Common::StringArray AsyncSaveWriter::takeFailedFiles() {
+	Common::StringArray failedFiles;
+	SWAP(failedFiles, _failedFiles);
+	return failedFiles;
+}
+
+void AsyncSaveWriter::start(PendingSave *save) {
+	save->started = true;
+
+	if (!save->sf)
+		save->sf = save->node.createWriteStream();
+	if (save->sf)
+		save->group.run(&PendingSave::write, save, "savefile");
+}
+
+void AsyncSaveWriter::finish(PendingSave *save) {
+	save->group.wait();
+
+	if (!save->success) {
+		warning("AsyncSaveWriter: Failed to write savefile '%s'", save->filename.c_str());
+		_failedFiles.push_back(save->filename);
+	}
+
+	delete save;
+}
+
+AsyncSaveWriter::PendingSave *AsyncSaveWriter::findLatest(const Common::String &filename) const {
+	for (uint i = _pendingSaves.size(); i > 0; i--) {
+		if (_pendingSaves[i - 1]->filename.equalsIgnoreCase(filename))
+			return _pendingSaves[i - 1];
+	}
+
+	return nullptr;
+}
@@ -0,0 +1,111 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BACKEND_SAVES_ASYNC_SAVE_WRITER_H
+#define BACKEND_SAVES_ASYNC_SAVE_WRITER_H
+
+#include "common/array.h"
+#include "common/fs.h"
+#include "common/str.h"
+#include "common/str-array.h"
+
+namespace Common {
+class JobSystem;
+class SeekableReadStream;
+class SeekableWriteStream;
+}
+
+/**
+ * Compresses and writes the serialized contents of save files on the
+ * workers of a job system, so that slow storage does not stall the engine.
+ *
+ * Writes to the same file happen in the order they were queued: a write
+ * queued while another one to the same file is pending is only started by
+ * reap() or wait() once the previous one is done.
+ */
+class AsyncSaveWriter {
+public:
+	AsyncSaveWriter(Common::JobSystem *jobSystem);
+
+	/** Waits for all the pending writes. */
+	~AsyncSaveWriter();
+
+	/**
+	 * Hand the serialized contents of a save file over to a worker, which
+	 * compresses them if requested and writes them to the given file.
+	 * Takes ownership of file and of data, which must have been allocated
+	 * with malloc().
+	 *
+	 * If file is null, node is opened for writing when the write starts.
+	 */
+	void queue(Common::SeekableWriteStream *file, const Common::FSNode &node, const Common::String &filename, byte *data, uint32 size, bool compress);
+
+	/**
+	 * Wait until the given save file, or all of them if no name is given,
+	 * has been written.
+	 *
+	 * @return true if all the waited for writes succeeded.
+	 */
+	bool wait(const Common::String &filename = Common::String());
+
+	/** Clean up after the writes which already finished. */
+	void reap();
+
+	/** Whether a write of the given save file is still pending. */
+	bool isPending(const Common::String &filename) const;
+
+	/** Drop the writes of the given save file which did not start yet. */
+	void cancel(const Common::String &filename);
+
+	/**
+	 * Create a stream reading the most recently queued contents of the given
+	 * save file, without waiting for them to be written. If raw is set, the
+	 * contents are compressed like they will be on the disk.
+	 *
+	 * @return the stream, or nullptr if no write of the file is pending.
+	 */
+	Common::SeekableReadStream *createReadStream(const Common::String &filename, bool raw) const;
+
+	/** Return the files which have pending writes. */
+	Common::FSList getPendingFiles() const;
+
+	/**
+	 * Return the names of the save files which could not be written since
+	 * the last call, and forget about them.
+	 */
+	Common::StringArray takeFailedFiles();
+
+private:
+	struct PendingSave;
+
+	void start(PendingSave *save);
+	void finish(PendingSave *save);
+	PendingSave *findLatest(const Common::String &filename) const;
+
+	Common::JobSystem *_jobSystem;
+
+	/** Save files which are still being written, in the order they were queued. */
+	Common::Array<PendingSave *> _pendingSaves;
+
+	Common::StringArray _failedFiles;
+};
+
+#endif
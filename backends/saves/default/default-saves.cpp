@@ -30,6 +30,7 @@
 #if !defined(DISABLE_DEFAULT_SAVEFILEMANAGER)
 
 #include "backends/saves/default/default-saves.h"
+#include "backends/saves/default/async-save-writer.h"
 
 #include "common/savefile.h"
 #include "common/util.h"
@@ -37,6 +38,8 @@
 #include "common/archive.h"
 #include "common/config-manager.h"
 #include "common/compression/deflate.h"
+#include "common/jobsystem.h"
+#include "common/memstream.h"
 
 #include <errno.h>	// for removeSavefile()
 
@@ -44,13 +47,66 @@
 const char *const DefaultSaveFileManager::TIMESTAMPS_FILENAME = "timestamps";
 #endif
 
-DefaultSaveFileManager::DefaultSaveFileManager() {
+/**
+ * A save file which is serialized into memory. Compressing the data and
+ * writing it to the file opened by openForSaving() is left to a background
+ * worker, once the engine finalizes or deletes the save file.
+ *
+ * Neither waits for the worker: write failures are reported by the
+ * manager's getError() after its next call. Until the write is done, the
+ * manager serves the save file from memory.
+ *
+ * Since the data is kept uncompressed in memory, seeking is supported
+ * even for compressed save files.
+ */
+class AsyncOutSaveFile : public Common::OutSaveFile {
+public:
+	AsyncOutSaveFile(DefaultSaveFileManager *manager, Common::SeekableWriteStream *file, const Common::FSNode &node, const Common::String &filename, bool compress)
+		: Common::OutSaveFile(new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO)),
+		  _manager(manager), _file(file), _node(node), _filename(filename), _compress(compress), _queued(false) {}
+
+	~AsyncOutSaveFile() override {
+		queue();
+	}
+
+	void finalize() override {
+		queue();
+	}
+
+	bool flush() override { return true; }
+
+private:
+	void queue() {
+		if (_queued)
+			return;
+
+		Common::MemoryWriteStreamDynamic *buffer = (Common::MemoryWriteStreamDynamic *)_wrapped;
+		_manager->_asyncWriter->queue(_file, _node, _filename, buffer->getData(), buffer->size(), _compress);
+		_file = nullptr;
+		_queued = true;
+	}
+
+	DefaultSaveFileManager *_manager;
+	Common::SeekableWriteStream *_file;
+	Common::FSNode _node;
+	Common::String _filename;
+	bool _compress;
+	bool _queued;
+};
+
+DefaultSaveFileManager::DefaultSaveFileManager() : _asyncWriter(nullptr) {
 }
 
-DefaultSaveFileManager::DefaultSaveFileManager(const Common::Path &defaultSavepath) {
+DefaultSaveFileManager::DefaultSaveFileManager(const Common::Path &defaultSavepath) : _asyncWriter(nullptr) {
 	ConfMan.registerDefault("savepath", defaultSavepath);
 }
 
+DefaultSaveFileManager::~DefaultSaveFileManager() {
+	// Make sure no save is lost when quitting
+	waitForPendingSaves();
+	delete _asyncWriter;
+}
+
 
 void DefaultSaveFileManager::checkPath(const Common::FSNode &dir) {
 	clearError();
@@ -64,6 +120,8 @@ void DefaultSaveFileManager::checkPath(const Common::FSNode &dir) {
 }
 
 void DefaultSaveFileManager::updateSavefilesList(Common::StringArray &lockedFiles) {
+	waitForPendingSaves();
+
 	//make it refresh the cache next time it lists the saves
 	_cachedDirectory = "";
 
@@ -77,6 +135,8 @@ Common::StringArray DefaultSaveFileManager::listSavefiles(const Common::String &
 	if (getError().getCode() != Common::kNoError)
 		return Common::StringArray();
 
+	reapPendingSaves();
+
 	Common::HashMap<Common::String, bool> locked;
 	for (const auto &lockedFile : _lockedFiles) {
 		locked[lockedFile] = true;
@@ -97,9 +157,13 @@ Common::InSaveFile *DefaultSaveFileManager::openRawFile(const Common::String &fi
 	if (getError().getCode() != Common::kNoError)
 		return nullptr;
 
+	reapPendingSaves();
+
 	SaveFileCache::const_iterator file = _saveFileCache.find(filename);
 	if (file == _saveFileCache.end()) {
 		return nullptr;
+	} else if (_asyncWriter && _asyncWriter->isPending(filename)) {
+		return _asyncWriter->createReadStream(filename, true);
 	} else {
 		// Open the file for loading.
 		Common::SeekableReadStream *sf = file->_value.createReadStream();
@@ -113,6 +177,8 @@ Common::InSaveFile *DefaultSaveFileManager::openForLoading(const Common::String
 	if (getError().getCode() != Common::kNoError)
 		return nullptr;
 
+	reapPendingSaves();
+
 	for (const auto &lockedFile : _lockedFiles) {
 		if (filename == lockedFile) {
 			setError(Common::kReadingFailed, Common::String::format("Savefile '%s' is locked and cannot be loaded", filename.c_str()));
@@ -124,6 +190,9 @@ Common::InSaveFile *DefaultSaveFileManager::openForLoading(const Common::String
 	if (file == _saveFileCache.end()) {
 		setError(Common::kPathDoesNotExist, Common::String::format("Savefile '%s' does not exist", filename.c_str()));
 		return nullptr;
+	} else if (_asyncWriter && _asyncWriter->isPending(filename)) {
+		// Do not wait for the write in progress
+		return _asyncWriter->createReadStream(filename, false);
 	} else {
 		// Open the file for loading.
 		Common::SeekableReadStream *sf = file->_value.createReadStream();
@@ -138,6 +207,8 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 	if (getError().getCode() != Common::kNoError)
 		return nullptr;
 
+	reapPendingSaves();
+
 	for (const auto &lockedFile : _lockedFiles) {
 		if (filename == lockedFile) {
 			return nullptr; // file is locked, no saving available
@@ -163,11 +234,28 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 		fileNode = file->_value;
 	}
 
-	// Open the file for saving.
-	Common::SeekableWriteStream *const sf = fileNode.createWriteStream();
-	if (!sf)
-		return nullptr;
-	Common::OutSaveFile *const result = new Common::OutSaveFile(compress ? Common::wrapCompressedWriteStream(sf) : sf);
+	// This save replaces the contents of a pending removal
+	_pendingRemovals.erase(filename);
+
+	// Open the file for saving. When a previous save to the same file is
+	// still being written, the file is only opened once that one is done.
+	Common::SeekableWriteStream *sf = nullptr;
+	if (!_asyncWriter || !_asyncWriter->isPending(filename)) {
+		sf = fileNode.createWriteStream();
+		if (!sf)
+			return nullptr;
+	}
+
+	Common::OutSaveFile *result;
+	if (g_system->getJobSystem()->getWorkerCount() > 0) {
+		// Serialize into memory and let a worker compress and write the
+		// data, so that slow storage does not stall the engine
+		if (!_asyncWriter)
+			_asyncWriter = new AsyncSaveWriter(g_system->getJobSystem());
+		result = new AsyncOutSaveFile(this, sf, fileNode, filename, compress);
+	} else {
+		result = new Common::OutSaveFile(compress ? Common::wrapCompressedWriteStream(sf) : sf);
+	}
 
 	// Add file to cache now that it exists.
 	_saveFileCache[filename] = Common::FSNode(fileNode.getPath());
@@ -181,6 +269,8 @@ bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
 	if (getError().getCode() != Common::kNoError)
 		return false;
 
+	reapPendingSaves();
+
 #if defined(USE_CLOUD) && defined(USE_LIBCURL)
 	// Update file's timestamp
 	Common::HashMap<Common::String, uint32> timestamps = loadTimestamps();
@@ -201,6 +291,14 @@ bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
 		_saveFileCache.erase(file);
 		file = _saveFileCache.end();
 
+		if (_asyncWriter && _asyncWriter->isPending(filename)) {
+			// Remove the file once the write in progress is done, and drop
+			// the writes which did not start yet
+			_asyncWriter->cancel(filename);
+			_pendingRemovals[filename] = fileNode;
+			return true;
+		}
+
 		Common::ErrorCode result = removeFile(fileNode);
 		if (result == Common::kNoError)
 			return true;
@@ -227,6 +325,8 @@ bool DefaultSaveFileManager::exists(const Common::String &filename) {
 	if (getError().getCode() != Common::kNoError)
 		return false;
 
+	reapPendingSaves();
+
 	for (const auto &lockedFile : _lockedFiles) {
 		if (filename == lockedFile)
 			return true;
@@ -235,6 +335,50 @@ bool DefaultSaveFileManager::exists(const Common::String &filename) {
 	return _saveFileCache.contains(filename);
 }
 
+void DefaultSaveFileManager::waitForPendingSaves() {
+	if (!_asyncWriter)
+		return;
+
+	_asyncWriter->wait();
+	finishPendingSaves();
+}
+
+void DefaultSaveFileManager::reapPendingSaves() {
+	if (!_asyncWriter)
+		return;
+
+	_asyncWriter->reap();
+	finishPendingSaves();
+}
+
+void DefaultSaveFileManager::finishPendingSaves() {
+	const Common::StringArray failedFiles = _asyncWriter->takeFailedFiles();
+	for (const auto &filename : failedFiles) {
+		setError(Common::kWritingFailed, Common::String::format("Failed to write savefile '%s'", filename.c_str()));
+
+		// Keep the previous version of the file, if any
+		SaveFileCache::iterator file = _saveFileCache.find(filename);
+		if (file != _saveFileCache.end() && !_asyncWriter->isPending(filename) && !Common::FSNode(file->_value.getPath()).exists())
+			_saveFileCache.erase(file);
+	}
+
+	Common::StringArray removedFiles;
+	for (const auto &removal : _pendingRemovals) {
+		if (_asyncWriter->isPending(removal._key))
+			continue;
+
+		removedFiles.push_back(removal._key);
+		Common::ErrorCode result = removeFile(removal._value);
+		if (result != Common::kNoError && result != Common::kPathDoesNotExist) {
+			Common::Error error(result);
+			setError(error, "Failed to remove savefile '" + removal._value.getName() + "': " + error.getDesc());
+		}
+	}
+
+	for (const auto &filename : removedFiles)
+		_pendingRemovals.erase(filename);
+}
+
 Common::Path DefaultSaveFileManager::getSavePath() const {
 
 	Common::Path dir;
@@ -293,6 +437,21 @@ void DefaultSaveFileManager::assureCached(const Common::Path &savePathName) {
 		}
 	}
 
+	// Files being written in the background may not be on the disk yet, and
+	// files to be removed once their write is done still are
+	if (_asyncWriter) {
+		const Common::FSList pendingFiles = _asyncWriter->getPendingFiles();
+		for (const auto &file : pendingFiles) {
+			if (file.getParent().getPath() == savePathName)
+				_saveFileCache[file.getName()] = file;
+		}
+	}
+
+	for (const auto &removal : _pendingRemovals) {
+		if (removal._value.getParent().getPath() == savePathName)
+			_saveFileCache.erase(removal._key);
+	}
+
 	// Only now store that we cached 'savePathName' to indicate we successfully
 	// cached the directory.
 	_cachedDirectory = savePathName;
@@ -28,6 +28,8 @@
 #include "common/fs.h"
 #include "common/hash-str.h"
 
+class AsyncSaveWriter;
+
 /**
  * Provides a default savefile manager implementation for common platforms.
  */
@@ -35,6 +37,7 @@ class DefaultSaveFileManager : public Common::SaveFileManager {
 public:
 	DefaultSaveFileManager();
 	DefaultSaveFileManager(const Common::Path &defaultSavepath);
+	~DefaultSaveFileManager() override;
 
 	void updateSavefilesList(Common::StringArray &lockedFiles) override;
 	Common::StringArray listSavefiles(const Common::String &pattern) override;
@@ -82,6 +85,18 @@ protected:
 	 */
 	void assureCached(const Common::Path &savePathName);
 
+	/**
+	 * Wait until all the save files have been written by the background
+	 * workers. Write failures are reported with setError().
+	 */
+	void waitForPendingSaves();
+
+	/**
+	 * Clean up after the background writes which already finished, and
+	 * report their failures with setError().
+	 */
+	void reapPendingSaves();
+
 	typedef Common::HashMap<Common::String, Common::FSNode, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> SaveFileCache;
 
 	/**
@@ -100,10 +115,27 @@ protected:
 	Common::StringArray _lockedFiles;
 
 private:
+	friend class AsyncOutSaveFile;
+
+	/**
+	 * Report the save files the background workers failed to write, and
+	 * remove the files whose removal waited for their write.
+	 */
+	void finishPendingSaves();
+
 	/**
 	 * The currently cached directory.
 	 */
 	Common::Path _cachedDirectory;
+
+	/**
+	 * Writes save files in the background, created once a job system with
+	 * worker threads is available.
+	 */
+	AsyncSaveWriter *_asyncWriter;
+
+	/** Save files to remove once their pending write is done. */
+	Common::HashMap<Common::String, Common::FSNode, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> _pendingRemovals;
 };
 
 #endif
@@ -387,6 +387,8 @@ void registerDefaults() {
 	ConfMan.registerDefault("gui_browser_native", true);
 	ConfMan.registerDefault("gui_return_to_launcher_at_exit", false);
 	ConfMan.registerDefault("gui_launcher_chooser", "list");
+	// Keep a parsed copy of the GUI theme in the themecachepath directory
+	ConfMan.registerDefault("gui_theme_cache", true);
 	ConfMan.registerDefault("grid_items_per_row", 4);
 	// Specify threshold for scanning directories in the launcher
 	// If number of game entries in scummvm.ini exceeds the specified
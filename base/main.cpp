@@ -52,6 +52,7 @@
 #include "common/translation.h"
 #include "common/text-to-speech.h"
 #include "common/osd_message_queue.h"
+#include "common/profiler.h"
 
 #include "gui/gui-manager.h"
 #include "gui/error.h"
@@ -601,6 +602,13 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 	MusicManager::instance();
 	Common::DebugManager::instance();
 
+#ifdef ENABLE_PROFILER
+	// Other threads only record zones once the profiler exists. It is never
+	// destroyed, since the mixer thread may record until the backend is gone.
+	Common::Profiler::instance();
+	PROFILE_THREAD("Main");
+#endif
+
 	// Init the event manager. As the virtual keyboard is loaded here, it must
 	// take place after the backend is initiated and the screen has been setup
 	system.getEventManager()->init();
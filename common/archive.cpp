@@ -332,6 +332,8 @@ SearchSet::ArchiveNodeList::const_iterator SearchSet::find(const String &name) c
 	order prevails.
 */
 void SearchSet::insert(const Node &node) {
+	_memberIndex.clear();
+
 	ArchiveNodeList::iterator it = _list.begin();
 	for (; it != _list.end(); ++it) {
 		if (it->_priority < node._priority)
@@ -430,6 +432,7 @@ void SearchSet::remove(const String &name) {
 		if (it->_autoFree)
 			delete it->_arc;
 		_list.erase(it);
+		_memberIndex.clear();
 	}
 }
 
@@ -453,6 +456,7 @@ void SearchSet::clear() {
 	}
 
 	_list.clear();
+	_memberIndex.clear();
 }
 
 void SearchSet::setPriority(const String &name, int priority) {
@@ -471,16 +475,54 @@ void SearchSet::setPriority(const String &name, int priority) {
 	insert(node);
 }
 
-bool SearchSet::hasFile(const Path &path) const {
-	if (path.empty())
-		return false;
+void SearchSet::setMemberIndexEnabled(bool enable) {
+	_useMemberIndex = enable;
+	_memberIndex.clear();
+}
+
+SearchSet::MemberIndexEntry &SearchSet::indexEntry(const Path &path) const {
+	if (_memberIndex.size() >= kMaxMemberIndexSize && !_memberIndex.contains(path))
+		_memberIndex.clear();
+
+	return _memberIndex.getOrCreateVal(path);
+}
+
+Archive *SearchSet::findArchiveWithFile(const Path &path) const {
+	_memberIndexStats.lookups++;
+
+	if (_useMemberIndex) {
+		MemberIndex::iterator i = _memberIndex.find(path);
+		if (i != _memberIndex.end() && i->_value._fileArc) {
+			_memberIndexStats.archiveProbes++;
+			if (i->_value._fileArc->hasFile(path)) {
+				_memberIndexStats.indexHits++;
+				return i->_value._fileArc;
+			}
+
+			// The member went away, forget where it was
+			i->_value._fileArc = nullptr;
+			if (!i->_value._streamArc)
+				_memberIndex.erase(i);
+		}
+	}
 
 	for (const auto &archive : _list) {
-		if (archive._arc->hasFile(path))
-			return true;
+		_memberIndexStats.archiveProbes++;
+		if (archive._arc->hasFile(path)) {
+			if (_useMemberIndex)
+				indexEntry(path)._fileArc = archive._arc;
+			return archive._arc;
+		}
 	}
 
-	return false;
+	return nullptr;
+}
+
+bool SearchSet::hasFile(const Path &path) const {
+	if (path.empty())
+		return false;
+
+	return findArchiveWithFile(path) != nullptr;
 }
 
 bool SearchSet::isPathDirectory(const Path &path) const {
@@ -555,13 +597,12 @@ const ArchiveMemberPtr SearchSet::getMember(const Path &path, Archive **containe
 	if (path.empty())
 		return ArchiveMemberPtr();
 
-	for (const auto &archive : _list) {
-		if (archive._arc->hasFile(path)) {
-			if (container) {
-				*container = archive._arc;
-			}
-			return archive._arc->getMember(path);
+	Archive *arc = findArchiveWithFile(path);
+	if (arc) {
+		if (container) {
+			*container = arc;
 		}
+		return arc->getMember(path);
 	}
 
 	return ArchiveMemberPtr();
@@ -575,10 +616,33 @@ SeekableReadStream *SearchSet::createReadStreamForMember(const Path &path) const
 	if (path.empty())
 		return nullptr;
 
+	_memberIndexStats.lookups++;
+
+	if (_useMemberIndex) {
+		MemberIndex::iterator i = _memberIndex.find(path);
+		if (i != _memberIndex.end() && i->_value._streamArc) {
+			_memberIndexStats.archiveProbes++;
+			SeekableReadStream *stream = i->_value._streamArc->createReadStreamForMember(path);
+			if (stream) {
+				_memberIndexStats.indexHits++;
+				return stream;
+			}
+
+			// The member went away, forget where it was
+			i->_value._streamArc = nullptr;
+			if (!i->_value._fileArc)
+				_memberIndex.erase(i);
+		}
+	}
+
 	for (const auto &archive : _list) {
+		_memberIndexStats.archiveProbes++;
 		SeekableReadStream *stream = archive._arc->createReadStreamForMember(path);
-		if (stream)
+		if (stream) {
+			if (_useMemberIndex)
+				indexEntry(path)._streamArc = archive._arc;
 			return stream;
+		}
 	}
 
 	return nullptr;
@@ -617,6 +681,7 @@ SeekableReadStream *SearchSet::createReadStreamForMemberNext(const Path &path, c
 }
 
 SearchManager::SearchManager() {
+	setMemberIndexEnabled(true);
 	clear(); // Force a reset
 }
 
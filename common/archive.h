@@ -244,6 +244,9 @@ public:
 	SharedArchiveContents(byte *contents, uint32 contentSize) :
 		_strongRef(contents, ArrayDeleter<byte>()), _weakRef(_strongRef),
 		_contentSize(contentSize), _missingFile(false), _bypass(nullptr) {}
+	SharedArchiveContents(SharedPtr<byte> contents, uint32 contentSize) :
+		_strongRef(contents), _weakRef(_strongRef),
+		_contentSize(contentSize), _missingFile(false), _bypass(nullptr) {}
 	SharedArchiveContents() : _strongRef(nullptr), _weakRef(nullptr), _contentSize(0), _missingFile(true), _bypass(nullptr) {}
 	static SharedArchiveContents bypass(SeekableReadStream *stream) {
 		return SharedArchiveContents(stream);
@@ -348,7 +351,44 @@ class SearchSet : public Archive {
 	bool _ignoreClashes;
 
 public:
-	SearchSet() : _ignoreClashes(false) { }
+	/**
+	 * Lookup statistics, see setMemberIndexEnabled().
+	 */
+	struct MemberIndexStats {
+		uint32 lookups;       //!< Number of hasFile/getMember/createReadStreamForMember calls.
+		uint32 indexHits;     //!< Lookups answered by the archive remembered in the index.
+		uint32 archiveProbes; //!< Number of calls made into member archives.
+
+		MemberIndexStats() : lookups(0), indexHits(0), archiveProbes(0) {}
+	};
+
+private:
+	/**
+	 * The member index remembers, for each path looked up successfully,
+	 * which archive answered it. Paths are compared exactly, since member
+	 * archives do not agree on case sensitivity. Failed lookups are not
+	 * remembered, and the whole index is cleared once it reaches
+	 * kMaxMemberIndexSize entries.
+	 */
+	struct MemberIndexEntry {
+		Archive *_fileArc;   //!< First archive whose hasFile() succeeded.
+		Archive *_streamArc; //!< First archive whose createReadStreamForMember() succeeded.
+
+		MemberIndexEntry() : _fileArc(nullptr), _streamArc(nullptr) {}
+	};
+	typedef HashMap<Path, MemberIndexEntry, Path::Hash, Path::EqualTo> MemberIndex;
+
+	static const uint kMaxMemberIndexSize = 8192;
+
+	bool _useMemberIndex;
+	mutable MemberIndex _memberIndex;
+	mutable MemberIndexStats _memberIndexStats;
+
+	MemberIndexEntry &indexEntry(const Path &path) const;
+	Archive *findArchiveWithFile(const Path &path) const;
+
+public:
+	SearchSet() : _ignoreClashes(false), _useMemberIndex(false) { }
 	virtual ~SearchSet() { clear(); }
 
 	char getPathSeparator() const override { return '/'; }
@@ -476,6 +516,26 @@ public:
 	 */
 	void setIgnoreClashes(bool ignoreClashes) { _ignoreClashes = ignoreClashes; }
 
+	/**
+	 * Enable or disable the member index.
+	 *
+	 * With the index enabled, lookups of a path which was found before
+	 * go straight to the archive which had it, instead of asking every
+	 * archive in priority order. Only successful lookups are indexed.
+	 *
+	 * The whole index is cleared whenever archives are added, removed or
+	 * reprioritized. An entry is dropped when a lookup finds that its
+	 * archive no longer has the member; that lookup then searches all
+	 * archives as usual. Results are therefore the same as without the
+	 * index, as long as member archives do not gain new files which
+	 * would shadow a remembered one.
+	 */
+	void setMemberIndexEnabled(bool enable);
+
+	/** Return the lookup statistics, which are gathered whether or not the index is enabled. */
+	const MemberIndexStats &getMemberIndexStats() const { return _memberIndexStats; }
+	void resetMemberIndexStats() { _memberIndexStats = MemberIndexStats(); }
+
 	bool getChildren(const Common::Path &path, Common::Array<Common::String> &list, ListMode mode = kListDirectoriesOnly, bool hidden = true) const override;
 };
 
@@ -209,7 +209,7 @@ static const ush mask_bits[] =
 };
 
 
-#define NEEDBITS(n) do {while(k<(n)){b|=((ulg)parentGetByte())<<k;k+=8;}} while (0)
+#define NEEDBITS(n) do {while(k<(n)){b|=((uint64)parentGetByte())<<k;k+=8;}} while (0)
 #define DUMPBITS(n) do {b>>=(n);k-=(n);} while (0)
 
 /* The state stored in filesystem-specific data.  */
@@ -274,7 +274,7 @@ private:
 	/* The index of a copy.  */
 	unsigned _inflateD;
 	/* The bit buffer.  */
-	unsigned long _bb;
+	uint64 _bb;
 	/* The bits in the bit buffer.  */
 	unsigned _bk;
 	/* The sliding window in uncompressed data.  */
@@ -308,6 +308,8 @@ private:
 	void parentSeek(int64 off);
 	void init_fixed_block();
 	int inflate_codes_in_window();
+	int inflate_codes_fast(uint64 &b, unsigned &k, unsigned &w);
+	bool fillInputBuffer(int needed);
 	void init_dynamic_block ();
 	void init_stored_block ();
 	int32 readAtOffset(int64 offset, byte *buf, uint32 len);
@@ -329,6 +331,29 @@ GzioReadStream::parentGetByte ()
   return _inbuf[_inbufD++];
 }
 
+/* Make sure the input buffer holds at least needed bytes, keeping the
+   unread ones.  Returns false if the input does not have that many.  */
+bool
+GzioReadStream::fillInputBuffer(int needed)
+{
+  int left = _inbufSize - _inbufD;
+
+  if (left >= needed)
+    return true;
+  if (_input->eos() || _input->err())
+    return false;
+
+  memmove(_inbuf, _inbuf + _inbufD, left);
+  _inbufD = 0;
+  _inbufSize = left;
+
+  int32 got = _input->read(_inbuf + left, INBUFSIZ - left);
+  if (got > 0)
+    _inbufSize += got;
+
+  return _inbufSize >= needed;
+}
+
 void
 GzioReadStream::parentSeek(int64 off)
 {
@@ -569,6 +594,123 @@ huft_free (struct huft *t)
 }
 
 
+/* Refill the bit buffer of the fast loop to at least 56 bits with one
+   unaligned load.  The bits above k then already hold the next input
+   bits, so overlapping loads put the same values there again.  */
+#define FASTREFILL() do {b|=READ_LE_UINT64(_inbuf+_inbufD)<<k;_inbufD+=(63-k)>>3;k|=56;} while (0)
+
+/* Look up a code in a multi-level table, with enough bits in b.  */
+static inline struct huft *
+fast_decode (struct huft *t, unsigned m, uint64 &b, unsigned &k)
+{
+  unsigned e;
+
+  t += (unsigned) b & m;
+  while ((e = t->e) > 16)
+    {
+      if (e == 99)
+	return t;
+      DUMPBITS (t->b);
+      t = t->v.t + ((unsigned) b & mask_bits[e - 16]);
+    }
+  DUMPBITS (t->b);
+  return t;
+}
+
+/*
+ *  Decode codes while there is enough input and room in the window to
+ *  skip all bounds checks.  One refill of the 64-bit bit buffer is good
+ *  for two literals, or a literal and a whole match.
+ *  Return 1 at the end of the block, -1 on an error, or zero when the
+ *  remaining codes have to be decoded by the careful loop.
+ */
+
+int
+GzioReadStream::inflate_codes_fast(uint64 &b, unsigned &k, unsigned &w)
+{
+  struct huft *t;		/* pointer to table entry */
+  unsigned e;			/* table entry flag/number of extra bits */
+  unsigned n, d;		/* length and distance for copy */
+  unsigned ml, md;		/* masks for bl and bd bits */
+  int ret = 0;
+
+  ml = mask_bits[_bl];
+  md = mask_bits[_bd];
+
+  /* At most two refills and 258 + 1 bytes of output per iteration.  */
+  while (w < WSIZE - 258 - 2 && fillInputBuffer (16))
+    {
+      FASTREFILL ();
+      t = fast_decode (_tl, ml, b, k);
+      e = t->e;
+
+      if (e == 16)		/* a literal */
+	{
+	  _slide[w++] = (uch) t->v.n;
+	  if (k < BMAX)
+	    continue;
+
+	  t = fast_decode (_tl, ml, b, k);
+	  e = t->e;
+	  if (e == 16)
+	    {
+	      _slide[w++] = (uch) t->v.n;
+	      continue;
+	    }
+	}
+
+      if (e == 15)		/* end of block */
+	{
+	  ret = 1;
+	  break;
+	}
+
+      if (e == 99 || _td == NULL)
+	{
+	  ret = -1;
+	  break;
+	}
+
+      /* a match needs up to 5 + 15 + 13 bits */
+      if (k < 33)
+	FASTREFILL ();
+
+      n = t->v.n + ((unsigned) b & mask_bits[e]);
+      DUMPBITS (e);
+
+      t = fast_decode (_td, md, b, k);
+      e = t->e;
+      if (e == 99)
+	{
+	  ret = -1;
+	  break;
+	}
+      d = (w - t->v.n - ((unsigned) b & mask_bits[e])) & (WSIZE - 1);
+      DUMPBITS (e);
+
+      if (d < w && w - d >= n)
+	{
+	  memcpy (_slide + w, _slide + d, n);
+	  w += n;
+	}
+      else
+	/* overlapping, or wrapping around the window */
+	{
+	  while (n--)
+	    {
+	      _slide[w++] = _slide[d];
+	      d = (d + 1) & (WSIZE - 1);
+	    }
+	}
+    }
+
+  /* drop the input bits past k which the last refill loaded */
+  b &= ((uint64) 1 << k) - 1;
+
+  return ret;
+}
+
+
 /*
  *  inflate (decompress) the codes in a deflated (compressed) block.
  *  Return an error code or zero if it all goes ok.
@@ -582,8 +724,9 @@ GzioReadStream::inflate_codes_in_window()
   unsigned w;			/* current window position */
   struct huft *t;		/* pointer to table entry */
   unsigned ml, md;		/* masks for bl and bd bits */
-  ulg b;			/* bit buffer */
+  uint64 b;			/* bit buffer */
   unsigned k;			/* number of bits in bit buffer */
+  int fast;			/* result of the fast loop */
 
   /* make local copies of globals */
   d = _inflateD;
@@ -605,6 +748,18 @@ GzioReadStream::inflate_codes_in_window()
 	      return 1;
 	    }
 
+	  fast = inflate_codes_fast (b, k, w);
+	  if (fast < 0)
+	    {
+	      _err = true;
+	      return 1;
+	    }
+	  if (fast > 0)
+	    {
+	      _blockLen = 0;
+	      break;
+	    }
+
 	  NEEDBITS ((unsigned) _bl);
 	  if ((e = (t = _tl + ((unsigned) b & ml))->e) > 16)
 	    do
@@ -723,7 +878,7 @@ GzioReadStream::inflate_codes_in_window()
 void
 GzioReadStream::init_stored_block ()
 {
-  ulg b;			/* bit buffer */
+  uint64 b;			/* bit buffer */
   unsigned k;			/* number of bits in bit buffer */
 
   /* make local copies of globals */
@@ -808,7 +963,7 @@ GzioReadStream::init_dynamic_block ()
   unsigned nl;			/* number of literal/length codes */
   unsigned nd;			/* number of distance codes */
   unsigned ll[286 + 30];	/* literal/length and distance code lengths */
-  ulg b;			/* bit buffer */
+  uint64 b;			/* bit buffer */
   unsigned k;			/* number of bits in bit buffer */
   const unsigned *bitorder = (_mode == GzioReadStream::Mode::CLICKTEAM) ? bitorder_clickteam : bitorder_zlib;
 
@@ -955,7 +1110,7 @@ GzioReadStream::init_dynamic_block ()
 void
 GzioReadStream::get_new_block()
 {
-  ulg b;			/* bit buffer */
+  uint64 b;			/* bit buffer */
   unsigned k;			/* number of bits in bit buffer */
 
   /* make local bit buffer */
@@ -1034,7 +1189,7 @@ GzioReadStream::inflate_window ()
 	  if (_lastBlock)
 	    break;
 
-	  if (_inbufD == _inbufSize && _input->eos())
+	  if (_inbufD == _inbufSize && _bk < 8 && _input->eos())
 	    {
 	      /* No buffer anymore on a block boundary */
 	      _lastBlock = true;
@@ -1058,15 +1213,35 @@ GzioReadStream::inflate_window ()
 	  int w = _wp;
 
 	  /*
-	   *  This is basically a glorified pass-through
+	   *  This is basically a glorified pass-through, starting with
+	   *  the whole bytes left in the bit buffer
 	   */
 
-	  while (_blockLen && w < WSIZE && !_err)
+	  while (_blockLen && w < WSIZE && _bk >= 8)
 	    {
-	      _slide[w++] = parentGetByte ();
+	      _slide[w++] = (uch) _bb;
+	      _bb >>= 8;
+	      _bk -= 8;
 	      _blockLen--;
 	    }
 
+	  while (_blockLen && w < WSIZE && !_err)
+	    {
+	      int size = MIN (MIN (_blockLen, WSIZE - w), _inbufSize - _inbufD);
+
+	      if (size <= 0)
+		{
+		  _slide[w++] = parentGetByte ();
+		  _blockLen--;
+		  continue;
+		}
+
+	      memcpy (_slide + w, _inbuf + _inbufD, size);
+	      _inbufD += size;
+	      w += size;
+	      _blockLen -= size;
+	    }
+
 	  _wp = w;
 
 	  continue;
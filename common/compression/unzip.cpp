@@ -989,6 +989,28 @@ Common::SharedArchiveContents unzOpenCurrentFile (unzFile file
 
 	uint32 crc32_wait = s->cur_file_info.crc;
 
+	// Stored members of memory mapped archives are used in place
+	if (s->cur_file_info.compression_method == 0 && s->_stream->supportsZeroCopy()) {
+		s->_stream->seek(s->cur_file_info_internal.offset_curfile + SIZEZIPLOCALHEADER + iSizeVar);
+		Common::ScopedPtr<Common::SeekableReadStream> view(s->_stream->readStream(s->cur_file_info.uncompressed_size));
+		Common::MemoryReadStream *memView = dynamic_cast<Common::MemoryReadStream *>(view.get());
+		Common::SharedPtr<const byte> data = memView ? memView->getSharedData() : Common::SharedPtr<const byte>();
+
+		if (data && (uLong)view->size() == s->cur_file_info.uncompressed_size) {
+#ifndef USE_ZLIB
+			uint32 crc32_data = crc.crcFast(data.get(), s->cur_file_info.uncompressed_size);
+#else
+			uint32 crc32_data = crc32(0, data.get(), s->cur_file_info.uncompressed_size);
+#endif
+			if (crc32_data != crc32_wait) {
+				warning("CRC32 mismatch: %08x, %08x", crc32_data, crc32_wait);
+				return Common::SharedArchiveContents();
+			}
+
+			return Common::SharedArchiveContents(Common::SharedPtr<byte>(data, const_cast<byte *>(data.get())), s->cur_file_info.uncompressed_size);
+		}
+	}
+
 	byte *compressedBuffer = new byte[s->cur_file_info.compressed_size];
 	s->_stream->seek(s->cur_file_info_internal.offset_curfile + SIZEZIPLOCALHEADER + iSizeVar);
 	s->_stream->read(compressedBuffer, s->cur_file_info.compressed_size);
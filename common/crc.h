@@ -38,6 +38,7 @@
 #define COMMON_CRC_H
 
 #include "common/system.h" // For types.
+#include "common/endian.h"
 
 namespace Common {
 
@@ -228,11 +229,110 @@ public:
 	CRC16() : CRCReflected<uint16>(0xa001, 0x0000, 0x0000) {}
 };
 
-class CRC32 : public CRCReflected<uint32> {
+/**
+ * CRC-32 as used by zip, gzip and PNG.
+ *
+ * This uses eight tables so that crcFast() and update() can process eight
+ * bytes per step (slice-by-8). The tables are built on first use and
+ * shared by all instances, so a CRC32 is free to construct.
+ */
+class CRC32 {
 public:
-	CRC32() : CRCReflected<uint32>(0xEDB88320, 0xFFFFFFFF, 0xFFFFFFFF) {}
+	CRC32() {}
+
+	uint32 crcFast(byte const message[], int nBytes) const {
+		return finalize(update(getInitRemainder(), message, nBytes));
+	}
+
+	uint32 processByte(byte byteVal, uint32 remainder) const {
+		return getSliceTables()._tables[0][(byteVal ^ remainder) & 0xFF] ^ (remainder >> 8);
+	}
+
+	uint32 getInitRemainder() const { return 0xFFFFFFFF; }
+	uint32 finalize(uint32 remainder) const { return remainder ^ 0xFFFFFFFF; }
+
+	/**
+	 * Process more bytes of a message; start with getInitRemainder(), and
+	 * pass the last result to finalize() to get the CRC.
+	 */
+	uint32 update(uint32 remainder, byte const message[], int nBytes) const;
+
+private:
+	struct SliceTables {
+		SliceTables();
+
+		uint32 _tables[8][256];
+	};
+
+	static const SliceTables &getSliceTables();
 };
 
+inline CRC32::SliceTables::SliceTables() {
+	/*
+	 * _tables[0] is the usual byte-wise table of the reflected polynomial.
+	 */
+	for (int dividend = 0; dividend < 256; ++dividend) {
+		uint32 remainder = dividend;
+
+		for (byte bit = 8; bit > 0; --bit) {
+			if (remainder & 1) {
+				remainder = (remainder >> 1) ^ 0xEDB88320;
+			} else {
+				remainder = (remainder >> 1);
+			}
+		}
+
+		_tables[0][dividend] = remainder;
+	}
+
+	/*
+	 * _tables[n][i] is the remainder of byte i followed by n zero bytes.
+	 */
+	for (int n = 1; n < 8; ++n) {
+		for (int i = 0; i < 256; ++i) {
+			const uint32 prev = _tables[n - 1][i];
+			_tables[n][i] = _tables[0][prev & 0xFF] ^ (prev >> 8);
+		}
+	}
+}
+
+inline const CRC32::SliceTables &CRC32::getSliceTables() {
+	static const SliceTables tables;
+	return tables;
+}
+
+inline uint32 CRC32::update(uint32 remainder, byte const message[], int nBytes) const {
+	const uint32 (*const sliceTables)[256] = getSliceTables()._tables;
+
+	/*
+	 * Divide the message by the polynomial, eight bytes at a time.
+	 */
+	while (nBytes >= 8) {
+		const uint32 one = READ_LE_UINT32(message) ^ remainder;
+		const uint32 two = READ_LE_UINT32(message + 4);
+
+		remainder = sliceTables[7][one & 0xFF] ^
+		            sliceTables[6][(one >> 8) & 0xFF] ^
+		            sliceTables[5][(one >> 16) & 0xFF] ^
+		            sliceTables[4][one >> 24] ^
+		            sliceTables[3][two & 0xFF] ^
+		            sliceTables[2][(two >> 8) & 0xFF] ^
+		            sliceTables[1][(two >> 16) & 0xFF] ^
+		            sliceTables[0][two >> 24];
+
+		message += 8;
+		nBytes -= 8;
+	}
+
+	/*
+	 * And the rest a byte at a time.
+	 */
+	while (nBytes-- > 0)
+		remainder = sliceTables[0][(*message++ ^ remainder) & 0xFF] ^ (remainder >> 8);
+
+	return remainder;
+}
+
 } // End of namespace Common
 
 #endif
@@ -142,6 +142,15 @@ uint32 File::read(void *ptr, uint32 len) {
 	return _handle->read(ptr, len);
 }
 
+SeekableReadStream *File::readStream(uint32 dataSize) {
+	assert(_handle);
+	return _handle->readStream(dataSize);
+}
+
+bool File::supportsZeroCopy() const {
+	return _handle && _handle->supportsZeroCopy();
+}
+
 
 DumpFile::DumpFile() : _handle(nullptr) {
 }
@@ -133,6 +133,8 @@ public:
 	int64 size() const override; /*!< Implement abstract SeekableReadStream method. */
 	bool seek(int64 offs, int whence = SEEK_SET) override;	/*!< Implement abstract SeekableReadStream method. */
 	uint32 read(void *dataPtr, uint32 dataSize) override;	/*!< Implement abstract SeekableReadStream method. */
+	SeekableReadStream *readStream(uint32 dataSize) override;	/*!< Forward to the opened stream, which may hand out views. */
+	bool supportsZeroCopy() const override;	/*!< Forward to the opened stream. */
 };
 
 
@@ -0,0 +1,656 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_FLAT_HASHMAP_H
+#define COMMON_FLAT_HASHMAP_H
+
+#include "common/hashmap.h"
+#include "common/endian.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_flat_hashmap Flat hash table (FlatHashMap)
+ * @ingroup common
+ *
+ * @brief API for operations on a hash table storing its entries inline.
+ *
+ * @{
+ */
+
+/**
+ * FlatHashMap<Key,Val> is a drop-in replacement for HashMap<Key,Val>, which
+ * stores its entries in one contiguous array instead of allocating a node
+ * per entry, in the style of SwissTable.
+ *
+ * A separate array holds one control byte per slot: either a marker for
+ * empty and erased slots, or 7 bits of the hash of the key in the slot.
+ * Lookups probe linearly from the home slot of the key, checking the
+ * control bytes of 8 slots at once with plain 64-bit arithmetic, and only
+ * compare keys whose control byte matches. A lookup therefore typically
+ * touches one cache line of control bytes and one entry, without
+ * hard-to-predict branches.
+ *
+ * The API and iterators are the same as the ones of HashMap, with one
+ * difference: inserting an entry may move the other ones, so references
+ * and pointers to values, as well as iterators, only stay valid until the
+ * next insertion. Erasing does not move entries, so erasing while iterating
+ * is fine, as with HashMap.
+ *
+ * It pays off for keys which are expensive to compare, such as strings.
+ * For integer keys, HashMap remains faster at inserting and looking up.
+ */
+template<class Key, class Val, class HashFunc = Hash<Key>, class EqualFunc = EqualTo<Key> >
+class FlatHashMap {
+public:
+	typedef uint size_type;
+
+	struct Node {
+		Val _value;
+		const Key _key;
+		explicit Node(const Key &key) : _value(), _key(key) {}
+		Node(const Key &key, const Val &value) : _value(value), _key(key) {}
+		Node(const Node &node) : _value(node._value), _key(node._key) {}
+		// Only used when relocating entries, which destroys the source right away
+		Node(Node &&node) : _value(Common::move(node._value)), _key(Common::move(const_cast<Key &>(node._key))) {}
+	};
+
+private:
+	typedef FlatHashMap<Key, Val, HashFunc, EqualFunc> FHM_t;
+
+	/**
+	 * An entry along with the mixed hash of its key, so that rehashing does
+	 * not need to hash the keys again.
+	 */
+	struct Slot {
+		Node _node;
+		uint32 _hash;
+
+		Slot(const Key &key, uint32 hash) : _node(key), _hash(hash) {}
+		Slot(const Slot &slot) : _node(slot._node), _hash(slot._hash) {}
+		Slot(Slot &&slot) : _node(Common::move(slot._node)), _hash(slot._hash) {}
+	};
+
+	enum {
+		FLATHASHMAP_MIN_CAPACITY = 16,
+
+		// The quotient of the next two constants controls how much the
+		// slots may fill up, counting erased ones, before they are
+		// rehashed. The control bytes filter out most key comparisons,
+		// but inserts probe much further past three quarters.
+		FLATHASHMAP_LOADFACTOR_NUMERATOR = 3,
+		FLATHASHMAP_LOADFACTOR_DENOMINATOR = 4
+	};
+
+	enum : byte {
+		kCtrlEmpty = 0x80,
+		kCtrlErased = 0xFE
+	};
+
+	/**
+	 * Number of control bytes checked at once. The first ones are mirrored
+	 * after the last slot, so that a group never has to wrap around.
+	 */
+	static const size_type kGroupWidth = 8;
+	static const uint64 kGroupLsbs = 0x0101010101010101ULL;
+	static const uint64 kGroupMsbs = 0x8080808080808080ULL;
+
+	/** Default value, returned by the const getVal. */
+	Val _defaultVal;
+
+	byte *_ctrl;        ///< Control bytes, one per slot
+	Slot *_slots;       ///< Uninitialized storage for the entries
+	size_type _mask;    ///< Capacity minus one; the capacity is a power of two
+	uint _shift;        ///< 32 minus log2 of the capacity
+	size_type _size;
+	size_type _erased;  ///< Number of erased slots, which still end probe sequences
+
+	HashFunc _hash;
+	EqualFunc _equal;
+
+	static const size_type kNoSlot = (size_type)-1;
+
+	/**
+	 * Scramble the hash, since many Hash functors return the key itself.
+	 * The upper bits select the home slot, while the control byte is
+	 * taken from the lower bits.
+	 */
+	static uint32 mixHash(uint hash) {
+		// A 64-bit multiplication folded back to 32 bits mixes all the
+		// bits of the hash, in fewer cycles than the MurmurHash3 finalizer
+		const uint64 m = (uint64)hash * 0x9E3779B97F4A7C15ULL;
+		return (uint32)(m >> 32) ^ (uint32)m;
+	}
+	static byte ctrlFor(uint32 mixed) { return (byte)(mixed & 0x7F); }
+
+	static bool isFull(byte ctrl) { return (ctrl & 0x80) == 0; }
+
+	static uint64 loadGroup(const byte *ctrl, size_type idx) { return READ_LE_UINT64(ctrl + idx); }
+	uint64 loadGroup(size_type idx) const { return loadGroup(_ctrl, idx); }
+
+	/**
+	 * Return the high bit of each byte of the group equal to ctrl, which
+	 * must be a full control byte. There may be false positives in front
+	 * of actual matches, but only for full slots.
+	 */
+	static uint64 matchFull(uint64 group, byte ctrl) {
+		const uint64 x = group ^ (kGroupLsbs * ctrl);
+		return (x - kGroupLsbs) & ~x & kGroupMsbs;
+	}
+
+	/** Return the high bit of each byte of the group which is empty. */
+	static uint64 matchEmpty(uint64 group) {
+		// Only empty control bytes have bit 7 set and bit 1 clear
+		return group & ~(group << 6) & kGroupMsbs;
+	}
+
+	/** Return the high bit of each byte of the group which is empty or erased. */
+	static uint64 matchFree(uint64 group) { return group & kGroupMsbs; }
+
+	/** Return the high bit of each byte of the group which is full. */
+	static uint64 matchFull(uint64 group) { return ~group & kGroupMsbs; }
+
+	/** Return the index of the lowest byte with its high bit set. */
+	static size_type lowestByte(uint64 mask) {
+#if defined(__GNUC__)
+		return __builtin_ctzll(mask) >> 3;
+#else
+		size_type byteIdx = 0;
+		while (!(mask & 0x80)) {
+			mask >>= 8;
+			byteIdx++;
+		}
+		return byteIdx;
+#endif
+	}
+
+	static void setCtrl(byte *ctrl, size_type mask, size_type idx, byte value) {
+		ctrl[idx] = value;
+		if (idx < kGroupWidth)
+			ctrl[idx + mask + 1] = value;
+	}
+	void setCtrl(size_type idx, byte value) { setCtrl(_ctrl, _mask, idx, value); }
+
+	/**
+	 * Find the first empty or erased slot, starting at the given home slot.
+	 * The home slot is checked on its own first: loading a group right
+	 * after storing one of its bytes would stall store forwarding.
+	 */
+	static size_type findFree(const byte *ctrl, size_type mask, size_type home) {
+		if (!isFull(ctrl[home]))
+			return home;
+
+		for (size_type pos = home; ; pos = (pos + kGroupWidth) & mask) {
+			const uint64 free = matchFree(loadGroup(ctrl, pos));
+			if (free)
+				return (pos + lowestByte(free)) & mask;
+		}
+	}
+	size_type findFree(uint32 mixed) const { return findFree(_ctrl, _mask, mixed >> _shift); }
+
+	/**
+	 * Simple FlatHashMap iterator implementation.
+	 */
+	template<class NodeType>
+	class IteratorImpl {
+		friend class FlatHashMap;
+		template<class T> friend class IteratorImpl;
+
+	protected:
+		typedef const FlatHashMap hashmap_t;
+
+		size_type _idx;
+		hashmap_t *_hashmap;
+
+	protected:
+		IteratorImpl(size_type idx, hashmap_t *hashmap) : _idx(idx), _hashmap(hashmap) {}
+
+		NodeType *deref() const {
+			assert(_hashmap != nullptr);
+			assert(_idx <= _hashmap->_mask);
+			assert(isFull(_hashmap->_ctrl[_idx]));
+			return &_hashmap->_slots[_idx]._node;
+		}
+
+	public:
+		IteratorImpl() : _idx(0), _hashmap(nullptr) {}
+		template<class T>
+		IteratorImpl(const IteratorImpl<T> &c) : _idx(c._idx), _hashmap(c._hashmap) {}
+
+		NodeType &operator*() const { return *deref(); }
+		NodeType *operator->() const { return deref(); }
+
+		bool operator==(const IteratorImpl &iter) const { return _idx == iter._idx && _hashmap == iter._hashmap; }
+		bool operator!=(const IteratorImpl &iter) const { return !(*this == iter); }
+
+		IteratorImpl &operator++() {
+			assert(_hashmap);
+			_idx = _hashmap->nextFull(_idx + 1);
+			return *this;
+		}
+
+		IteratorImpl operator++(int) {
+			IteratorImpl old = *this;
+			operator ++();
+			return old;
+		}
+	};
+
+	void allocate(size_type capacity);
+	void destroyAll();
+	void assign(const FHM_t &map);
+	void rehash(size_type newCapacity);
+
+	/** Find the first full slot at or after idx, checking 8 control bytes at once. */
+	size_type nextFull(size_type idx) const {
+		if (idx > _mask)
+			return kNoSlot;
+
+		// Iterating only depends on the next byte when it is full, rather
+		// than on a whole group
+		if (isFull(_ctrl[idx]))
+			return idx;
+
+		for (; idx <= _mask; idx += kGroupWidth) {
+			const uint64 full = matchFull(loadGroup(idx));
+			if (full) {
+				// Ignore the mirrored control bytes past the last slot
+				idx += lowestByte(full);
+				return idx <= _mask ? idx : kNoSlot;
+			}
+		}
+		return kNoSlot;
+	}
+
+	size_type lookup(const Key &key) const { return lookup(key, mixHash(_hash(key))); }
+	size_type lookup(const Key &key, uint32 mixed) const;
+	size_type lookupAndCreateIfMissing(const Key &key);
+
+public:
+	typedef IteratorImpl<Node> iterator;
+	typedef IteratorImpl<const Node> const_iterator;
+
+	FlatHashMap();
+	FlatHashMap(const FHM_t &map);
+	~FlatHashMap();
+
+	FHM_t &operator=(const FHM_t &map) {
+		if (this == &map)
+			return *this;
+
+		destroyAll();
+		free(_ctrl);
+		free(_slots);
+		assign(map);
+		return *this;
+	}
+
+	bool contains(const Key &key) const { return lookup(key) != kNoSlot; }
+
+	Val &operator[](const Key &key) { return getOrCreateVal(key); }
+	const Val &operator[](const Key &key) const { return getVal(key); }
+
+	Val &getOrCreateVal(const Key &key) {
+		// Inserting may reallocate the slots
+		const size_type idx = lookupAndCreateIfMissing(key);
+		return _slots[idx]._node._value;
+	}
+	Val &getVal(const Key &key);
+	const Val &getVal(const Key &key) const;
+	const Val &getValOrDefault(const Key &key) const { return getValOrDefault(key, _defaultVal); }
+	const Val &getValOrDefault(const Key &key, const Val &defaultVal) const;
+	bool tryGetVal(const Key &key, Val &out) const;
+	void setVal(const Key &key, const Val &val) { getOrCreateVal(key) = val; }
+
+	void clear(bool shrinkArray = 0);
+
+	void erase(iterator entry);
+	void erase(const Key &key);
+
+	size_type size() const { return _size; }
+
+	/** Make room for at least count entries without rehashing. */
+	void reserve(size_type count);
+
+	iterator	begin() { return iterator(nextFull(0), this); }
+	iterator	end() { return iterator(kNoSlot, this); }
+
+	const_iterator	begin() const { return const_iterator(nextFull(0), this); }
+	const_iterator	end() const { return const_iterator(kNoSlot, this); }
+
+	iterator	find(const Key &key) { return iterator(lookup(key), this); }
+	const_iterator	find(const Key &key) const { return const_iterator(lookup(key), this); }
+
+	/** Return true if hashmap is empty. */
+	bool empty() const {
+		return (_size == 0);
+	}
+};
+
+//-------------------------------------------------------
+// FlatHashMap functions
+
+/**
+ * Base constructor, creates an empty hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap() : _defaultVal() {
+	allocate(FLATHASHMAP_MIN_CAPACITY);
+}
+
+/**
+ * Copy constructor, creates a full copy of the given hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap(const FHM_t &map) : _defaultVal() {
+	assign(map);
+}
+
+/**
+ * Destructor, frees all used memory.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::~FlatHashMap() {
+	destroyAll();
+	free(_ctrl);
+	free(_slots);
+}
+
+/**
+ * Internal method for allocating empty storage with the given capacity.
+ *
+ * @note The previous storage is *not* deallocated here -- the caller is
+ *       responsible for doing that!
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::allocate(size_type capacity) {
+	assert(capacity >= FLATHASHMAP_MIN_CAPACITY && (capacity & (capacity - 1)) == 0);
+
+	_ctrl = (byte *)malloc(capacity + kGroupWidth);
+	_slots = (Slot *)malloc(capacity * sizeof(Slot));
+	assert(_ctrl != nullptr && _slots != nullptr);
+	memset(_ctrl, kCtrlEmpty, capacity + kGroupWidth);
+
+	_mask = capacity - 1;
+	_shift = 32;
+	for (size_type c = capacity; c > 1; c >>= 1)
+		_shift--;
+
+	_size = 0;
+	_erased = 0;
+}
+
+/**
+ * Internal method for destroying all the entries, leaving the control
+ * bytes untouched.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::destroyAll() {
+	for (size_type pos = 0; pos <= _mask; pos += kGroupWidth) {
+		for (uint64 full = matchFull(loadGroup(pos)); full; full &= full - 1)
+			_slots[pos + lowestByte(full)].~Slot();
+	}
+}
+
+/**
+ * Internal method for assigning the content of another FlatHashMap
+ * to this one.
+ *
+ * @note The previous storage is *not* deallocated here -- the caller is
+ *       responsible for doing that!
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::assign(const FHM_t &map) {
+	allocate(map._mask + 1);
+
+	// The layout can be copied as is, erased slots included
+	memcpy(_ctrl, map._ctrl, _mask + 1 + kGroupWidth);
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		if (isFull(_ctrl[ctr]))
+			new (&_slots[ctr]) Slot(map._slots[ctr]);
+	}
+
+	_size = map._size;
+	_erased = map._erased;
+}
+
+/**
+ * Clear all values in the hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::clear(bool shrinkArray) {
+	destroyAll();
+
+	if (shrinkArray && _mask >= FLATHASHMAP_MIN_CAPACITY) {
+		free(_ctrl);
+		free(_slots);
+		allocate(FLATHASHMAP_MIN_CAPACITY);
+	} else {
+		memset(_ctrl, kCtrlEmpty, _mask + 1 + kGroupWidth);
+		_size = 0;
+		_erased = 0;
+	}
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::rehash(size_type newCapacity) {
+	assert(newCapacity > _size);
+
+	const size_type oldMask = _mask;
+	byte *oldCtrl = _ctrl;
+	Slot *oldSlots = _slots;
+#ifndef RELEASE_BUILD
+	const size_type oldSize = _size;
+#endif
+
+	allocate(newCapacity);
+
+	// The members are copied to locals, since the compiler cannot tell
+	// whether the stores to the control bytes alias them
+	byte *const ctrl = _ctrl;
+	Slot *const slots = _slots;
+	const size_type mask = _mask;
+	const uint shift = _shift;
+	size_type size = 0;
+
+	for (size_type pos = 0; pos <= oldMask; pos += kGroupWidth) {
+		for (uint64 full = matchFull(loadGroup(oldCtrl, pos)); full; full &= full - 1) {
+			Slot &slot = oldSlots[pos + lowestByte(full)];
+
+			// Since all keys are distinct, the first free slot can be taken
+			// without comparing any keys
+			const size_type idx = findFree(ctrl, mask, slot._hash >> shift);
+
+			setCtrl(ctrl, mask, idx, ctrlFor(slot._hash));
+			new (&slots[idx]) Slot(Common::move(slot));
+			slot.~Slot();
+			size++;
+		}
+	}
+
+	_size = size;
+
+#ifndef RELEASE_BUILD
+	// Perform a sanity check: Old number of elements should match the new one!
+	// This check will fail if some previous operation corrupted this hashmap.
+	assert(_size == oldSize);
+#endif
+
+	free(oldCtrl);
+	free(oldSlots);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::reserve(size_type count) {
+	size_type capacity = _mask + 1;
+	while (count * FLATHASHMAP_LOADFACTOR_DENOMINATOR > capacity * FLATHASHMAP_LOADFACTOR_NUMERATOR)
+		capacity *= 2;
+
+	if (capacity != _mask + 1)
+		rehash(capacity);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookup(const Key &key, uint32 mixed) const {
+	const byte ctrl = ctrlFor(mixed);
+	// Most entries are stored in their home slot
+	const size_type home = mixed >> _shift;
+	if (_ctrl[home] == ctrl && _equal(_slots[home]._node._key, key))
+		return home;
+
+	// The load factor guarantees that there is an empty slot ending the probing
+	for (size_type pos = home; ; pos = (pos + kGroupWidth) & _mask) {
+		const uint64 group = loadGroup(pos);
+
+		for (uint64 match = matchFull(group, ctrl); match; match &= match - 1) {
+			const size_type idx = (pos + lowestByte(match)) & _mask;
+			if (_equal(_slots[idx]._node._key, key))
+				return idx;
+		}
+
+		// Entries are never stored past an empty slot of their probe sequence
+		if (matchEmpty(group))
+			return kNoSlot;
+	}
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookupAndCreateIfMissing(const Key &key) {
+	const uint32 mixed = mixHash(_hash(key));
+	size_type idx = lookup(key, mixed);
+	if (idx != kNoSlot)
+		return idx;
+
+	// Keep the load factor below a certain threshold.
+	// Erased slots are also counted, since they do not end probing.
+	const size_type capacity = _mask + 1;
+	if ((_size + _erased + 1) * FLATHASHMAP_LOADFACTOR_DENOMINATOR > capacity * FLATHASHMAP_LOADFACTOR_NUMERATOR) {
+		// Only grow if the entries need it, otherwise just drop the erased slots
+		if ((_size + 1) * 2 > capacity)
+			rehash(capacity * 2);
+		else
+			rehash(capacity);
+	}
+
+	idx = findFree(mixed);
+
+	if (_ctrl[idx] == kCtrlErased)
+		_erased--;
+	setCtrl(idx, ctrlFor(mixed));
+	new (&_slots[idx]) Slot(key, mixed);
+	_size++;
+
+	return idx;
+}
+
+/**
+ * Get a value from the hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) {
+	size_type idx = lookup(key);
+	if (idx != kNoSlot)
+		return _slots[idx]._node._value;
+	else
+		// See the comment in HashMap::getVal()
+#ifdef RELEASE_BUILD
+		return _defaultVal;
+#else
+		unknownKeyError(key);
+#endif
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) const {
+	size_type idx = lookup(key);
+	if (idx != kNoSlot)
+		return _slots[idx]._node._value;
+	else
+		// See the comment in HashMap::getVal()
+#ifdef RELEASE_BUILD
+		return _defaultVal;
+#else
+		unknownKeyError(key);
+#endif
+}
+
+/**
+ * Get a value from the hashmap. If the key is not present, then return @p defaultVal.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getValOrDefault(const Key &key, const Val &defaultVal) const {
+	size_type idx = lookup(key);
+	if (idx != kNoSlot)
+		return _slots[idx]._node._value;
+	else
+		return defaultVal;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+bool FlatHashMap<Key, Val, HashFunc, EqualFunc>::tryGetVal(const Key &key, Val &out) const {
+	size_type idx = lookup(key);
+	if (idx != kNoSlot) {
+		out = _slots[idx]._node._value;
+		return true;
+	} else {
+		return false;
+	}
+}
+
+/**
+ * Erase an element referred to by an iterator.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(iterator entry) {
+	// Check whether we have a valid iterator
+	assert(entry._hashmap == this);
+	const size_type idx = entry._idx;
+	assert(idx <= _mask);
+	assert(isFull(_ctrl[idx]));
+
+	_slots[idx].~Slot();
+	_size--;
+
+	// A probe sequence reaching this slot would end at the next one if
+	// that is empty, so the slot can become empty as well
+	if (_ctrl[(idx + 1) & _mask] == kCtrlEmpty) {
+		setCtrl(idx, kCtrlEmpty);
+	} else {
+		setCtrl(idx, kCtrlErased);
+		_erased++;
+	}
+}
+
+/**
+ * Erase an element specified by a key.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(const Key &key) {
+	size_type idx = lookup(key);
+	if (idx != kNoSlot)
+		erase(iterator(idx, this));
+}
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
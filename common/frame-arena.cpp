@@ -0,0 +1,143 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/frame-arena.h"
+#include "common/textconsole.h"
+#include "common/util.h"
+
+namespace Common {
+
+enum {
+	kPoisonAllocated = 0xCD,
+	kPoisonReleased = 0xDD
+};
+
+FrameArena::FrameArena(size_t blockSize)
+	: _current(0), _offset(0), _usedBefore(0), _peak(0), _blockSize(blockSize), _poison(false) {
+}
+
+FrameArena::~FrameArena() {
+	for (uint i = 0; i < _blocks.size(); i++)
+		::free(_blocks[i].data);
+}
+
+void *FrameArena::allocateSlow(size_t size, size_t alignment) {
+	assert(alignment && !(alignment & (alignment - 1)));
+
+	if (_current < _blocks.size()) {
+		const size_t offset = alignOffset(_blocks[_current], _offset, alignment);
+		if (offset + size <= _blocks[_current].size) {
+			_offset = offset + size;
+			byte *result = _blocks[_current].data + offset;
+			if (_poison)
+				memset(result, kPoisonAllocated, size);
+			return result;
+		}
+
+		// Continue in the next block; the rest of this one stays unused
+		_usedBefore += _offset;
+		_current++;
+		_offset = 0;
+	}
+
+	// Blocks after the current one are unused. Insert a new one if there
+	// is none left, or if the allocation does not fit into the next one.
+	const size_t needed = size + alignment - 1;
+	if (_current >= _blocks.size() || _blocks[_current].size < needed) {
+		Block block;
+		block.size = MAX<size_t>(_blockSize, needed);
+		block.data = (byte *)::malloc(block.size);
+		if (!block.data)
+			error("FrameArena: Failed to allocate a block of %u bytes", (uint)block.size);
+		_blocks.insert_at(_current, block);
+	}
+
+	const size_t offset = alignOffset(_blocks[_current], 0, alignment);
+	_offset = offset + size;
+	byte *result = _blocks[_current].data + offset;
+	if (_poison)
+		memset(result, kPoisonAllocated, size);
+	return result;
+}
+
+char *FrameArena::copyString(const char *str) {
+	const size_t size = strlen(str) + 1;
+	char *result = (char *)allocate(size, 1);
+	memcpy(result, str, size);
+	return result;
+}
+
+FrameArena::Mark FrameArena::getMark() const {
+	Mark mark;
+	mark.block = _current;
+	mark.offset = _offset;
+	mark.usedBefore = _usedBefore;
+	return mark;
+}
+
+void FrameArena::rewind(const Mark &mark) {
+	assert(mark.block < _current || (mark.block == _current && mark.offset <= _offset));
+
+	_peak = MAX(_peak, getBytesUsed());
+
+	if (_poison)
+		poisonFrom(mark.block, mark.offset);
+
+	_current = mark.block;
+	_offset = mark.offset;
+	_usedBefore = mark.usedBefore;
+}
+
+void FrameArena::reset() {
+	Mark start;
+	start.block = 0;
+	start.offset = 0;
+	start.usedBefore = 0;
+	rewind(start);
+}
+
+void FrameArena::poisonFrom(uint block, size_t offset) {
+	for (uint i = block; i <= _current && i < _blocks.size(); i++) {
+		const size_t start = (i == block) ? offset : 0;
+		const size_t end = (i == _current) ? _offset : _blocks[i].size;
+		if (end > start)
+			memset(_blocks[i].data + start, kPoisonReleased, end - start);
+	}
+}
+
+void FrameArena::freeUnusedBlocks() {
+	const uint keep = _offset ? _current + 1 : _current;
+
+	for (uint i = keep; i < _blocks.size(); i++)
+		::free(_blocks[i].data);
+
+	if (keep < _blocks.size())
+		_blocks.resize(keep);
+}
+
+size_t FrameArena::getCapacity() const {
+	size_t capacity = 0;
+	for (uint i = 0; i < _blocks.size(); i++)
+		capacity += _blocks[i].size;
+	return capacity;
+}
+
+} // End of namespace Common
@@ -0,0 +1,191 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_FRAME_ARENA_H
+#define COMMON_FRAME_ARENA_H
+
+#include "common/scummsys.h"
+#include "common/array.h"
+#include "common/noncopyable.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_frame_arena Frame arena
+ * @ingroup common_memory
+ *
+ * @brief API for allocating short-lived memory by bumping a pointer.
+ * @{
+ */
+
+/**
+ * An arena for transient allocations, typically the ones which only live
+ * for a single frame.
+ *
+ * Allocating moves a pointer forward in the current memory block;
+ * individual allocations are never freed. Instead, the whole arena is
+ * reset() once per frame, or rewound to a mark taken earlier (see
+ * FrameArenaScope). Blocks are kept and reused, so after a few frames
+ * the arena no longer calls malloc() at all.
+ *
+ * Destructors are not called: objects created in the arena must either
+ * be trivially destructible, or be destroyed manually before the
+ * memory is reused.
+ *
+ * With poisoning enabled, new allocations are filled with 0xCD and released
+ * memory with 0xDD, to expose reads of uninitialized or stale data.
+ */
+class FrameArena : NonCopyable {
+public:
+	enum {
+		kDefaultBlockSize = 64 * 1024,
+		kDefaultAlignment = 2 * sizeof(void *)
+	};
+
+	/** A position in the arena, see getMark() and rewind(). */
+	struct Mark {
+		uint block;
+		size_t offset;
+		size_t usedBefore;
+	};
+
+	/**
+	 * Create an arena. No memory is allocated before the first allocation.
+	 *
+	 * @param blockSize  Size of the memory blocks; larger allocations get a block of their own.
+	 */
+	explicit FrameArena(size_t blockSize = kDefaultBlockSize);
+	~FrameArena();
+
+	/**
+	 * Allocate memory, which stays valid until the arena is reset or
+	 * rewound to a mark taken before this call.
+	 *
+	 * @param size       Number of bytes.
+	 * @param alignment  Alignment of the result, which must be a power of two.
+	 */
+	void *allocate(size_t size, size_t alignment = kDefaultAlignment) {
+		if (_current < _blocks.size() && !_poison) {
+			const Block &block = _blocks[_current];
+			const size_t offset = alignOffset(block, _offset, alignment);
+			if (offset + size <= block.size) {
+				_offset = offset + size;
+				return block.data + offset;
+			}
+		}
+		return allocateSlow(size, alignment);
+	}
+
+	/** Allocate uninitialized memory for count objects of type T. */
+	template<class T>
+	T *allocateArray(size_t count) {
+		return (T *)allocate(count * sizeof(T), MAX<size_t>(alignof(T), 1));
+	}
+
+	/** Copy a string into the arena. */
+	char *copyString(const char *str);
+
+	/** Get the current position, to rewind to it later. */
+	Mark getMark() const;
+
+	/**
+	 * Release everything allocated since the mark was taken. Marks taken
+	 * after this one become invalid.
+	 */
+	void rewind(const Mark &mark);
+
+	/** Release all allocations; the memory blocks are kept for reuse. */
+	void reset();
+
+	/** Free the memory blocks which hold no allocations. */
+	void freeUnusedBlocks();
+
+	/**
+	 * Enable or disable poisoning of allocated and released memory.
+	 * This makes allocations slower, so it is meant for debugging.
+	 */
+	void setPoisoning(bool enable) { _poison = enable; }
+	bool isPoisoning() const { return _poison; }
+
+	/** Change the size of the blocks allocated from now on. */
+	void setBlockSize(size_t blockSize) { _blockSize = blockSize; }
+	size_t getBlockSize() const { return _blockSize; }
+
+	/** Get the number of bytes allocated, including the alignment padding. */
+	size_t getBytesUsed() const { return _usedBefore + _offset; }
+	/** Get the highest value getBytesUsed() returned since the arena was created. */
+	size_t getPeakBytesUsed() const { return MAX(_peak, getBytesUsed()); }
+	/** Get the total size of all memory blocks. */
+	size_t getCapacity() const;
+
+private:
+	struct Block {
+		byte *data;
+		size_t size;
+	};
+
+	static size_t alignOffset(const Block &block, size_t offset, size_t alignment) {
+		const uintptr address = (uintptr)block.data + offset;
+		return offset + (((address + alignment - 1) & ~(uintptr)(alignment - 1)) - address);
+	}
+
+	void *allocateSlow(size_t size, size_t alignment);
+	void poisonFrom(uint block, size_t offset);
+
+	Array<Block> _blocks;
+	uint _current;        ///< Index of the block allocations are made from
+	size_t _offset;       ///< Bytes used in the current block
+	size_t _usedBefore;   ///< Bytes used in the blocks before the current one
+	size_t _peak;
+	size_t _blockSize;
+	bool _poison;
+};
+
+/**
+ * Rewinds an arena to the position it had when the scope was entered.
+ */
+class FrameArenaScope : NonCopyable {
+public:
+	explicit FrameArenaScope(FrameArena &arena) : _arena(arena), _mark(arena.getMark()) {}
+	~FrameArenaScope() { _arena.rewind(_mark); }
+
+private:
+	FrameArena &_arena;
+	FrameArena::Mark _mark;
+};
+
+/** @} */
+
+} // End of namespace Common
+
+/**
+ * A placement new operator allocating from a FrameArena, the same way
+ * objects are allocated from a MemoryPool. Never delete such an object;
+ * call its destructor manually if it has one.
+ */
+inline void *operator new(size_t nbytes, Common::FrameArena &arena) {
+	return arena.allocate(nbytes);
+}
+
+inline void operator delete(void *p, Common::FrameArena &arena) {
+}
+
+#endif
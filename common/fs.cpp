@@ -248,6 +248,21 @@ SeekableReadStream *FSNode::createReadStream() const {
 	return _realNode->createReadStream();
 }
 
+SeekableReadStream *FSNode::createMappedReadStream() const {
+	if (_realNode == nullptr)
+		return nullptr;
+
+	if (!_realNode->exists()) {
+		warning("FSNode::createMappedReadStream: '%s' does not exist", getName().c_str());
+		return nullptr;
+	} else if (_realNode->isDirectory()) {
+		warning("FSNode::createMappedReadStream: '%s' is a directory", getName().c_str());
+		return nullptr;
+	}
+
+	return _realNode->createMappedReadStream();
+}
+
 SeekableReadStream *FSNode::createReadStreamForAltStream(AltStreamType altStreamType) const {
 	if (_realNode == nullptr)
 		return nullptr;
@@ -293,26 +308,26 @@ bool FSNode::createDirectory() const {
 
 FSDirectory::FSDirectory(const FSNode &node, int depth, bool flat, bool ignoreClashes, bool includeDirectories)
   : _node(node), _cached(false), _depth(depth), _flat(flat), _ignoreClashes(ignoreClashes),
-	_includeDirectories(includeDirectories) {
+	_includeDirectories(includeDirectories), _mapFiles(false) {
 }
 
 FSDirectory::FSDirectory(const Path &prefix, const FSNode &node, int depth, bool flat,
 						 bool ignoreClashes, bool includeDirectories)
   : _node(node), _cached(false), _depth(depth), _flat(flat), _ignoreClashes(ignoreClashes),
-	_includeDirectories(includeDirectories) {
+	_includeDirectories(includeDirectories), _mapFiles(false) {
 
 	setPrefix(prefix);
 }
 
 FSDirectory::FSDirectory(const Path &name, int depth, bool flat, bool ignoreClashes, bool includeDirectories)
   : _node(name), _cached(false), _depth(depth), _flat(flat), _ignoreClashes(ignoreClashes),
-	_includeDirectories(includeDirectories) {
+	_includeDirectories(includeDirectories), _mapFiles(false) {
 }
 
 FSDirectory::FSDirectory(const Path &prefix, const Path &name, int depth, bool flat,
 						 bool ignoreClashes, bool includeDirectories)
   : _node(name), _cached(false), _depth(depth), _flat(flat), _ignoreClashes(ignoreClashes),
-	_includeDirectories(includeDirectories) {
+	_includeDirectories(includeDirectories), _mapFiles(false) {
 
 	setPrefix(prefix);
 }
@@ -383,7 +398,7 @@ SeekableReadStream *FSDirectory::createReadStreamForMember(const Path &path) con
 
 	debug(5, "FSDirectory::createReadStreamForMember('%s') -> '%s'", path.toString(Common::Path::kNativeSeparator).c_str(), node->getPath().toString(Common::Path::kNativeSeparator).c_str());
 
-	SeekableReadStream *stream = node->createReadStream();
+	SeekableReadStream *stream = _mapFiles ? node->createMappedReadStream() : node->createReadStream();
 	if (!stream)
 		warning("FSDirectory::createReadStreamForMember: Can't create stream for file '%s'", Common::toPrintable(path.toString(Common::Path::kNativeSeparator)).c_str());
 
@@ -420,7 +435,9 @@ FSDirectory *FSDirectory::getSubDirectory(const Path &prefix, const Path &name,
 	if (!node)
 		return nullptr;
 
-	return new FSDirectory(prefix, *node, depth, flat, ignoreClashes);
+	FSDirectory *dir = new FSDirectory(prefix, *node, depth, flat, ignoreClashes);
+	dir->setMapFiles(_mapFiles);
+	return dir;
 }
 
 void FSDirectory::cacheDirectoryRecursive(FSNode node, int depth, const Path& prefix) const {
@@ -261,6 +261,17 @@ public:
 	 */
 	SeekableReadStream *createReadStream() const override;
 
+	/**
+	 * Same as createReadStream(), but the stream may be backed by a memory
+	 * mapping of the file, which hands out data through readStream()
+	 * without copying it.
+	 *
+	 * Only use this for read-only data, such as game files: depending on
+	 * the backend, reading a mapped file which was truncated in the
+	 * meantime crashes instead of failing.
+	 */
+	SeekableReadStream *createMappedReadStream() const;
+
 	/**
 	 * Create a SeekableReadStream instance corresponding to an alternate stream
 	 * of the file referred by this node. This assumes that the node actually
@@ -344,6 +355,7 @@ class FSDirectory : public Archive {
 	bool _flat;
 	bool _ignoreClashes;
 	bool _includeDirectories;
+	bool _mapFiles;
 
 	Path	_prefix; // string that is prepended to each cache item key
 	void setPrefix(const Path &prefix);
@@ -398,6 +410,13 @@ public:
 	 */
 	FSNode getFSNode() const;
 
+	/**
+	 * Open members with FSNode::createMappedReadStream(). Only enable this
+	 * for directories whose files are not modified while in use, such as
+	 * game data. Subdirectories inherit the setting.
+	 */
+	void setMapFiles(bool mapFiles) { _mapFiles = mapFiles; }
+
 	/**
 	 * Create a new FSDirectory pointing to a subdirectory of the instance.
 	 * @return A new FSDirectory instance.
@@ -0,0 +1,140 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/jobsystem.h"
+#include "common/array.h"
+#include "common/system.h"
+
+namespace Common {
+
+JobGroup::JobGroup(JobSystem *system) : _system(system), _pending(0) {
+	if (!_system)
+		_system = g_system->getJobSystem();
+	assert(_system);
+}
+
+JobGroup::~JobGroup() {
+	wait();
+}
+
+void JobGroup::run(JobProc proc, void *param, const char *name) {
+	Job job;
+	job.proc = proc;
+	job.param = param;
+	job.name = name;
+	job.group = this;
+
+	_system->submit(job);
+}
+
+void JobGroup::wait() {
+	_system->wait(*this);
+}
+
+bool JobGroup::isDone() const {
+	return _system->isDone(*this);
+}
+
+
+JobSystem::JobSystem() : _profiler(nullptr) {
+}
+
+void JobSystem::submit(const Job &job) {
+	startJob(job);
+	execute(job, 0);
+	finishJob(job);
+}
+
+void JobSystem::execute(const Job &job, uint worker) {
+	JobProfiler *profiler = _profiler;
+
+	if (profiler)
+		profiler->jobStarted(job.name, worker);
+
+	job.proc(job.param);
+
+	if (profiler)
+		profiler->jobFinished(job.name, worker);
+}
+
+namespace {
+
+struct RangeJob {
+	RangeJobProc proc;
+	void *param;
+	uint begin;
+	uint end;
+};
+
+void runRangeJob(void *param) {
+	const RangeJob *rangeJob = (const RangeJob *)param;
+	rangeJob->proc(rangeJob->param, rangeJob->begin, rangeJob->end);
+}
+
+} // End of anonymous namespace
+
+void JobSystem::parallelFor(uint begin, uint end, uint grainSize, RangeJobProc proc, void *param, const char *name) {
+	if (begin >= end)
+		return;
+
+	uint count = end - begin;
+	uint workers = getWorkerCount();
+
+	if (grainSize == 0)
+		grainSize = 1;
+
+	// A few chunks per thread keep them busy when some chunks are slower
+	// than others, without drowning the queue in tiny jobs
+	uint chunks = (count + grainSize - 1) / grainSize;
+	chunks = MIN(chunks, (workers + 1) * 4);
+
+	if (workers == 0 || chunks <= 1) {
+		JobProfiler *profiler = _profiler;
+
+		if (profiler)
+			profiler->jobStarted(name, 0);
+
+		proc(param, begin, end);
+
+		if (profiler)
+			profiler->jobFinished(name, 0);
+		return;
+	}
+
+	Array<RangeJob> rangeJobs;
+	rangeJobs.resize(chunks);
+
+	for (uint i = 0; i < chunks; i++) {
+		rangeJobs[i].proc = proc;
+		rangeJobs[i].param = param;
+		rangeJobs[i].begin = begin + (uint)((uint64)count * i / chunks);
+		rangeJobs[i].end = begin + (uint)((uint64)count * (i + 1) / chunks);
+	}
+
+	JobGroup group(this);
+
+	for (uint i = 0; i < chunks; i++)
+		group.run(&runRangeJob, &rangeJobs[i], name);
+
+	group.wait();
+}
+
+} // End of namespace Common
@@ -0,0 +1,235 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_JOBSYSTEM_H
+#define COMMON_JOBSYSTEM_H
+
+#include "common/scummsys.h"
+#include "common/noncopyable.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_jobsystem Job system
+ * @ingroup common
+ *
+ * @brief API for running independent pieces of work on worker threads.
+ *
+ * The OSystem API deliberately does not expose threads. Instead, backends
+ * which can run code concurrently provide a JobSystem (see
+ * OSystem::getJobSystem()), which executes short, self-contained jobs on
+ * a pool of workers. Backends which cannot do that get the base
+ * JobSystem, which runs every job inline on the calling thread, in the
+ * order it was submitted.
+ *
+ * Jobs must therefore not depend on running concurrently with their
+ * submitter, and must not call into OSystem (graphics, events, mixer...)
+ * since that is not thread-safe.
+ * @{
+ */
+
+class JobSystem;
+
+/** A job entry point. */
+typedef void (*JobProc)(void *param);
+
+/** A job entry point working on the index range [begin, end). */
+typedef void (*RangeJobProc)(void *param, uint begin, uint end);
+
+/**
+ * Interface which gets notified whenever a job starts or finishes.
+ *
+ * The methods are called on the thread running the job; worker 0 is the
+ * thread which submitted or waits for the job, workers 1 and up are
+ * threads of the pool.
+ */
+class JobProfiler {
+public:
+	virtual ~JobProfiler() {}
+
+	virtual void jobStarted(const char *name, uint worker) = 0;
+	virtual void jobFinished(const char *name, uint worker) = 0;
+};
+
+/**
+ * A set of jobs which can be waited for together (fork/join).
+ *
+ * The group waits for all of its jobs when it is destroyed, so data
+ * referenced by the jobs can live on the same stack frame as the group.
+ */
+class JobGroup : NonCopyable {
+	friend class JobSystem;
+
+public:
+	/**
+	 * Create a job group.
+	 *
+	 * @param system  Job system to run the jobs on; defaults to the one of g_system.
+	 */
+	explicit JobGroup(JobSystem *system = nullptr);
+	~JobGroup();
+
+	/** Queue a job in this group. */
+	void run(JobProc proc, void *param, const char *name = nullptr);
+
+	/** Wait until all the jobs queued so far have finished. */
+	void wait();
+
+	/** Check whether all the jobs queued so far have finished. */
+	bool isDone() const;
+
+	JobSystem *getJobSystem() const { return _system; }
+
+private:
+	JobSystem *_system;
+	uint _pending;
+};
+
+/**
+ * The result of a single job, which can be queried once it finished.
+ */
+template<class T>
+class Future : NonCopyable {
+public:
+	typedef T (*Proc)(void *param);
+
+	/** Queue proc(param) and remember its result. */
+	Future(Proc proc, void *param, const char *name = nullptr, JobSystem *system = nullptr)
+		: _group(system), _proc(proc), _param(param), _result() {
+		_group.run(&Future::runJob, this, name);
+	}
+
+	~Future() {
+		_group.wait();
+	}
+
+	/** Check whether the result is available. */
+	bool isReady() const { return _group.isDone(); }
+
+	/** Wait for the job to finish and return its result. */
+	const T &get() {
+		_group.wait();
+		return _result;
+	}
+
+private:
+	static void runJob(void *param) {
+		Future *future = (Future *)param;
+		future->_result = future->_proc(future->_param);
+	}
+
+	JobGroup _group;
+	Proc _proc;
+	void *_param;
+	T _result;
+};
+
+/**
+ * A job description, as handed to JobSystem implementations.
+ */
+struct Job {
+	JobProc proc;
+	void *param;
+	const char *name;
+	JobGroup *group;
+};
+
+/**
+ * The job system. This base class runs all jobs inline; backends derive
+ * from it to provide a pool of worker threads.
+ */
+class JobSystem : NonCopyable {
+	friend class JobGroup;
+
+public:
+	JobSystem();
+	virtual ~JobSystem() {}
+
+	/**
+	 * Return the number of threads which run jobs, not counting the
+	 * thread which submits them. Zero means all jobs run inline.
+	 */
+	virtual uint getWorkerCount() const { return 0; }
+
+	/**
+	 * Set the profiler which is notified about every job, or nullptr
+	 * to disable profiling.
+	 */
+	void setProfiler(JobProfiler *profiler) { _profiler = profiler; }
+	JobProfiler *getProfiler() const { return _profiler; }
+
+	/**
+	 * Run proc over the index range [begin, end), split in chunks of at
+	 * least grainSize indices, and wait until all of them are done.
+	 *
+	 * Without workers, this is a single call of proc(param, begin, end).
+	 */
+	void parallelFor(uint begin, uint end, uint grainSize, RangeJobProc proc, void *param, const char *name = nullptr);
+
+	/**
+	 * Same as above, calling func(begin, end) for each chunk; func can be
+	 * any function object, including a lambda.
+	 */
+	template<class Func>
+	void parallelFor(uint begin, uint end, uint grainSize, const Func &func, const char *name = nullptr) {
+		parallelFor(begin, end, grainSize, &JobSystem::runRange<Func>, const_cast<Func *>(&func), name);
+	}
+
+protected:
+	/**
+	 * Queue a job. The default implementation runs it right away.
+	 *
+	 * Implementations must call startJob() under the same lock they use
+	 * for finishJob(), and eventually execute() and finishJob() the job.
+	 */
+	virtual void submit(const Job &job);
+
+	/**
+	 * Wait until group has no pending jobs. Implementations should run
+	 * queued jobs while waiting, so that jobs may wait for nested groups.
+	 */
+	virtual void wait(JobGroup &group) {}
+
+	/** Check whether the group still has pending jobs. */
+	virtual bool isDone(const JobGroup &group) const { return group._pending == 0; }
+
+	void startJob(const Job &job) { job.group->_pending++; }
+	/** Returns true if this was the last pending job of its group. */
+	bool finishJob(const Job &job) { return --job.group->_pending == 0; }
+	static bool hasPendingJobs(const JobGroup &group) { return group._pending != 0; }
+
+	/** Run a job, notifying the profiler. */
+	void execute(const Job &job, uint worker);
+
+private:
+	template<class Func>
+	static void runRange(void *param, uint begin, uint end) {
+		(*(const Func *)param)(begin, end);
+	}
+
+	JobProfiler *_profiler;
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
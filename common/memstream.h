@@ -85,6 +85,18 @@ public:
 		_eos(false) {}
 
 	uint32 read(void *dataPtr, uint32 dataSize);
+	SeekableReadStream *readStream(uint32 dataSize);
+	bool supportsZeroCopy() const { return _ptrOrig.getShared() != nullptr; }
+
+	/**
+	 * Return the stream contents, sharing ownership with the stream, or
+	 * nullptr if the stream does not hold its buffer through a SharedPtr.
+	 */
+	SharedPtr<const byte> getSharedData() const {
+		if (!_ptrOrig.getShared())
+			return SharedPtr<const byte>();
+		return SharedPtr<const byte>(_ptrOrig.getShared(), _ptrOrig.get());
+	}
 
 	bool eos() const { return _eos; }
 	void clearErr() { _eos = false; }
@@ -14,8 +14,10 @@ MODULE_OBJS := \
 	events.o \
 	file.o \
 	fs.o \
+	frame-arena.o \
 	gui_options.o \
 	hashmap.o \
+	jobsystem.o \
 	language.o \
 	localization.o \
 	macresman.o \
@@ -36,6 +38,7 @@ MODULE_OBJS := \
 	streamdebug.o \
 	str-base.o \
 	str-enc.o \
+	str-intern.o \
 	encodings/singlebyte.o \
 	system.o \
 	textconsole.o \
@@ -59,5 +62,10 @@ MODULE_OBJS += \
 	updates.o
 endif
 
+ifdef ENABLE_PROFILER
+MODULE_OBJS += \
+	profiler.o
+endif
+
 # Include common rules
 include $(srcdir)/rules.mk
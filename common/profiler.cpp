@@ -0,0 +1,283 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/profiler.h"
+#include "common/str.h"
+#include "common/stream.h"
+#include "common/system.h"
+
+namespace Common {
+
+DECLARE_SINGLETON(Profiler);
+
+/**
+ * The zones recorded by one thread. Only the owning thread writes to it;
+ * the mutex guards the events and the name against readers.
+ */
+struct ProfileThreadBuffer {
+	explicit ProfileThreadBuffer(uint id_) : id(id_), head(0), depth(0) {}
+
+	uint id;
+	String name;
+	Mutex mutex;
+	ProfileEvent events[Profiler::kEventsPerThread];
+	uint32 head;   ///< Number of events written so far
+	uint32 depth;
+	Array<uint64> jobStarts;
+};
+
+namespace {
+
+// Thread buffers are found through a thread local pointer, which is only
+// valid while the profiler which created it is still around
+uint nextGeneration = 1;
+thread_local ProfileThreadBuffer *threadBuffer = nullptr;
+thread_local uint threadBufferGeneration = 0;
+
+const float kAverageWeight = 0.05f;
+
+String escapeJSON(const char *str) {
+	String result;
+	for (; *str; str++) {
+		if (*str == '"' || *str == '\\')
+			result += '\\';
+		result += *str;
+	}
+	return result;
+}
+
+} // End of anonymous namespace
+
+Profiler::Profiler() : _paused(false), _generation(nextGeneration++), _frameStart(0), _frameCount(0) {
+	for (uint i = 0; i < kFrameHistory; i++)
+		_frameTimes[i] = 0.0f;
+
+	JobSystem *jobSystem = g_system->getJobSystem();
+	if (jobSystem)
+		jobSystem->setProfiler(this);
+}
+
+Profiler::~Profiler() {
+	JobSystem *jobSystem = g_system ? g_system->getJobSystem() : nullptr;
+	if (jobSystem && jobSystem->getProfiler() == this)
+		jobSystem->setProfiler(nullptr);
+
+	for (uint i = 0; i < _threads.size(); i++)
+		delete _threads[i];
+}
+
+ProfileThreadBuffer *Profiler::getThreadBuffer() {
+	if (threadBufferGeneration != _generation) {
+		StackLock lock(_threadsMutex);
+		threadBuffer = new ProfileThreadBuffer(_threads.size() + 1);
+		threadBufferGeneration = _generation;
+		_threads.push_back(threadBuffer);
+	}
+	return threadBuffer;
+}
+
+void Profiler::setThreadName(const char *name) {
+	ProfileThreadBuffer *buffer = getThreadBuffer();
+
+	// Only this thread writes the name, so reading it needs no lock
+	if (buffer->name.equals(name))
+		return;
+
+	StackLock lock(buffer->mutex);
+	buffer->name = name;
+}
+
+uint64 Profiler::beginZone() {
+	if (_paused)
+		return 0;
+
+	getThreadBuffer()->depth++;
+	return MAX<uint64>(g_system->getMicros(), 1);
+}
+
+void Profiler::endZone(const char *name, uint64 start) {
+	const uint64 end = g_system->getMicros();
+	ProfileThreadBuffer *buffer = getThreadBuffer();
+
+	buffer->depth--;
+	if (_paused)
+		return;
+
+	StackLock lock(buffer->mutex);
+	ProfileEvent &event = buffer->events[buffer->head % kEventsPerThread];
+	event.name = name;
+	event.start = start;
+	event.duration = (uint32)MIN<uint64>(end - start, 0xFFFFFFFF);
+	event.depth = buffer->depth;
+	buffer->head++;
+}
+
+void Profiler::jobStarted(const char *name, uint worker) {
+	ProfileThreadBuffer *buffer = getThreadBuffer();
+
+	if (worker > 0 && buffer->name.empty()) {
+		StackLock lock(buffer->mutex);
+		buffer->name = String::format("Worker %u", worker);
+	}
+
+	buffer->jobStarts.push_back(beginZone());
+}
+
+void Profiler::jobFinished(const char *name, uint worker) {
+	ProfileThreadBuffer *buffer = getThreadBuffer();
+	if (buffer->jobStarts.empty())
+		return;
+
+	const uint64 start = buffer->jobStarts.back();
+	buffer->jobStarts.pop_back();
+
+	if (start)
+		endZone(name ? name : "Job", start);
+}
+
+void Profiler::endFrame() {
+	const uint64 now = g_system->getMicros();
+	StackLock statsLock(_statsMutex);
+
+	if (_frameStart && !_paused) {
+		_frameTimes[_frameCount % kFrameHistory] = (float)(now - _frameStart);
+		_frameCount++;
+
+		for (uint i = 0; i < _zoneStats.size(); i++) {
+			_zoneStats[i].calls = 0;
+			_zoneStats[i].last = 0;
+		}
+
+		{
+			StackLock lock(_threadsMutex);
+			for (uint i = 0; i < _threads.size(); i++)
+				addFrameZones(_threads[i], _frameStart);
+		}
+
+		for (uint i = 0; i < _zoneStats.size(); i++) {
+			ProfileZoneStats &stats = _zoneStats[i];
+			stats.average += (stats.last - stats.average) * kAverageWeight;
+			stats.peak = MAX(stats.peak, stats.last);
+		}
+	}
+
+	_frameStart = now;
+}
+
+void Profiler::addFrameZones(ProfileThreadBuffer *buffer, uint64 frameStart) {
+	StackLock lock(buffer->mutex);
+
+	// Events are stored in the order they ended, so walk back until
+	// the first one which ended before this frame
+	const uint32 oldest = buffer->head > kEventsPerThread ? buffer->head - kEventsPerThread : 0;
+	for (uint32 i = buffer->head; i > oldest; i--) {
+		const ProfileEvent &event = buffer->events[(i - 1) % kEventsPerThread];
+		if (event.start + event.duration <= frameStart)
+			break;
+
+		ProfileZoneStats *stats = nullptr;
+		for (uint j = 0; j < _zoneStats.size() && !stats; j++) {
+			if (_zoneStats[j].name == event.name || !strcmp(_zoneStats[j].name, event.name))
+				stats = &_zoneStats[j];
+		}
+
+		if (!stats) {
+			ProfileZoneStats newStats;
+			newStats.name = event.name;
+			newStats.calls = 0;
+			newStats.last = 0;
+			newStats.peak = 0;
+			newStats.average = 0.0f;
+			_zoneStats.push_back(newStats);
+			stats = &_zoneStats.back();
+		}
+
+		stats->calls++;
+		stats->last += event.duration;
+	}
+}
+
+void Profiler::reset() {
+	StackLock statsLock(_statsMutex);
+	StackLock lock(_threadsMutex);
+
+	for (uint i = 0; i < _threads.size(); i++) {
+		StackLock bufferLock(_threads[i]->mutex);
+		_threads[i]->head = 0;
+	}
+
+	_zoneStats.clear();
+	_frameCount = 0;
+	_frameStart = 0;
+}
+
+void Profiler::getFrameTimes(Array<float> &times) const {
+	StackLock lock(_statsMutex);
+
+	const uint count = MIN<uint>(_frameCount, kFrameHistory);
+	times.resize(count);
+	for (uint i = 0; i < count; i++)
+		times[i] = _frameTimes[(_frameCount - count + i) % kFrameHistory];
+}
+
+void Profiler::getZoneStats(Array<ProfileZoneStats> &stats) const {
+	StackLock lock(_statsMutex);
+	stats = _zoneStats;
+}
+
+bool Profiler::exportChromeTrace(WriteStream &stream) const {
+	StackLock lock(_threadsMutex);
+	Array<ProfileEvent> events;
+	bool first = true;
+
+	stream.writeString("{\"traceEvents\":[\n");
+
+	for (uint i = 0; i < _threads.size(); i++) {
+		ProfileThreadBuffer *buffer = _threads[i];
+		String name;
+
+		{
+			StackLock bufferLock(buffer->mutex);
+			const uint32 oldest = buffer->head > kEventsPerThread ? buffer->head - kEventsPerThread : 0;
+
+			events.resize(buffer->head - oldest);
+			for (uint32 j = oldest; j < buffer->head; j++)
+				events[j - oldest] = buffer->events[j % kEventsPerThread];
+
+			name = buffer->name.empty() ? String::format("Thread %u", buffer->id) : buffer->name;
+		}
+
+		stream.writeString(String::format("%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+		                                  first ? "" : ",\n", buffer->id, escapeJSON(name.c_str()).c_str()));
+		first = false;
+
+		for (uint j = 0; j < events.size(); j++) {
+			stream.writeString(String::format(",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%llu,\"dur\":%u}",
+			                                  escapeJSON(events[j].name).c_str(), buffer->id,
+			                                  (unsigned long long)events[j].start, events[j].duration));
+		}
+	}
+
+	stream.writeString("\n]}\n");
+	return stream.flush() && !stream.err();
+}
+
+} // End of namespace Common
@@ -0,0 +1,210 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_PROFILER_H
+#define COMMON_PROFILER_H
+
+#include "common/scummsys.h"
+
+#ifdef ENABLE_PROFILER
+#include "common/array.h"
+#include "common/jobsystem.h"
+#include "common/mutex.h"
+#include "common/noncopyable.h"
+#include "common/singleton.h"
+#endif
+
+/**
+ * @defgroup common_profiler Profiler
+ * @ingroup common
+ *
+ * @brief Scoped zone instrumentation to find out where the time of a frame goes.
+ *
+ * Code is instrumented with the PROFILE_ZONE(), PROFILE_FRAME() and
+ * PROFILE_THREAD() macros, which compile to nothing unless ScummVM was
+ * configured with --enable-profiler.
+ *
+ * Every thread records its finished zones into its own ring buffer. At the
+ * end of each frame, the zones of that frame are summed up per name; the
+ * results can be shown with ImGuiEx::ImGuiProfiler, and the ring buffers
+ * can be exported in the Chrome trace format (chrome://tracing, Perfetto).
+ * @{
+ */
+
+#ifdef ENABLE_PROFILER
+
+#define PROFILE_CONCAT_INTERNAL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INTERNAL(a, b)
+
+/** Time the rest of the enclosing scope. The name must be a string literal. */
+#define PROFILE_ZONE(name) ::Common::ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
+
+/** Mark the end of a frame; call this on the thread which presents frames. */
+#define PROFILE_FRAME() ::Common::Profiler::endFrameIfAvailable()
+
+/** Name the calling thread. The name must be a string literal. */
+#define PROFILE_THREAD(name) ::Common::Profiler::setThreadNameIfAvailable(name)
+
+namespace Common {
+
+class WriteStream;
+
+/**
+ * A finished zone, as stored in the ring buffers.
+ */
+struct ProfileEvent {
+	const char *name;
+	uint64 start;     ///< Start time, see OSystem::getMicros()
+	uint32 duration;  ///< Duration in microseconds
+	uint32 depth;     ///< Number of zones this one is nested in
+};
+
+/**
+ * The time spent in all zones of one name, summed up per frame.
+ */
+struct ProfileZoneStats {
+	const char *name;
+	uint32 calls;     ///< Number of zones in the last frame
+	uint32 last;      ///< Time spent in the last frame, in microseconds
+	uint32 peak;      ///< Highest per frame time seen, in microseconds
+	float average;    ///< Moving average of the per frame time, in microseconds
+};
+
+struct ProfileThreadBuffer;
+
+/**
+ * The profiler collects the zones of all threads.
+ *
+ * It must be created on the main thread before any other thread uses it;
+ * instrumented code running before that, or after recording was paused,
+ * records nothing. It also profiles the jobs of the job system of g_system.
+ */
+class Profiler : public Singleton<Profiler>, public JobProfiler {
+public:
+	enum {
+		/** Number of zones each thread keeps for the trace export. */
+		kEventsPerThread = 16384,
+		/** Number of frame times kept for the overlay. */
+		kFrameHistory = 240
+	};
+
+	/** Called by PROFILE_FRAME(), does nothing if there is no profiler. */
+	static void endFrameIfAvailable() {
+		if (hasInstance())
+			instance().endFrame();
+	}
+
+	/** Called by PROFILE_THREAD(), does nothing if there is no profiler. */
+	static void setThreadNameIfAvailable(const char *name) {
+		if (hasInstance())
+			instance().setThreadName(name);
+	}
+
+	void endFrame();
+	void setThreadName(const char *name);
+
+	/** Pause or resume recording; the collected data is kept. */
+	void setPaused(bool paused) { _paused = paused; }
+	bool isPaused() const { return _paused; }
+
+	/** Forget all recorded zones and statistics. */
+	void reset();
+
+	/**
+	 * Start a zone on the calling thread.
+	 *
+	 * @return The start time to pass to endZone(), or 0 if nothing is recorded.
+	 */
+	uint64 beginZone();
+	void endZone(const char *name, uint64 start);
+
+	/** Get the duration of the last frames in microseconds, oldest first. */
+	void getFrameTimes(Array<float> &times) const;
+
+	/** Get the per frame statistics of every zone name seen so far. */
+	void getZoneStats(Array<ProfileZoneStats> &stats) const;
+
+	/**
+	 * Write the contents of all ring buffers as Chrome trace JSON.
+	 *
+	 * @return True if the whole trace was written.
+	 */
+	bool exportChromeTrace(WriteStream &stream) const;
+
+	// JobProfiler API
+	void jobStarted(const char *name, uint worker) override;
+	void jobFinished(const char *name, uint worker) override;
+
+private:
+	friend class Singleton<SingletonBaseType>;
+
+	Profiler();
+	~Profiler() override;
+
+	ProfileThreadBuffer *getThreadBuffer();
+	void addFrameZones(ProfileThreadBuffer *buffer, uint64 frameStart);
+
+	bool _paused;
+
+	mutable Mutex _threadsMutex;
+	Array<ProfileThreadBuffer *> _threads;
+	uint _generation;
+
+	mutable Mutex _statsMutex;
+	uint64 _frameStart;
+	float _frameTimes[kFrameHistory];
+	uint _frameCount;
+	Array<ProfileZoneStats> _zoneStats;
+};
+
+/**
+ * Records a zone from its construction to its destruction; see PROFILE_ZONE().
+ */
+class ProfileZone : NonCopyable {
+public:
+	explicit ProfileZone(const char *name) : _name(name), _start(0) {
+		if (Profiler::hasInstance())
+			_start = Profiler::instance().beginZone();
+	}
+
+	~ProfileZone() {
+		if (_start)
+			Profiler::instance().endZone(_name, _start);
+	}
+
+private:
+	const char *_name;
+	uint64 _start;
+};
+
+} // End of namespace Common
+
+#else
+
+#define PROFILE_ZONE(name) do {} while (false)
+#define PROFILE_FRAME() do {} while (false)
+#define PROFILE_THREAD(name) do {} while (false)
+
+#endif
+
+/** @} */
+
+#endif
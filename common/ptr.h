@@ -197,6 +197,16 @@ public:
 			_tracker->incStrong();
 	}
 
+	/**
+	 * Aliasing constructor: the new SharedPtr keeps the object owned by r
+	 * alive, but points to p, which is usually a part of that object.
+	 */
+	template<class T2>
+	SharedPtr(const SharedPtr<T2> &r, T *p) : _pointer(p), _tracker(r._tracker) {
+		if (_tracker)
+			_tracker->incStrong();
+	}
+
 	template<class T2>
 	explicit SharedPtr(const WeakPtr<T2> &r) : _pointer(nullptr), _tracker(nullptr) {
 		if (r._tracker && r._tracker->isAlive()) {
@@ -723,6 +733,11 @@ public:
 	 */
 	PointerType get() const { return _pointer; }
 
+	/**
+	 * Returns the SharedPtr the DisposablePtr was created from, if any.
+	 */
+	const SharedPtr<T> &getShared() const { return _shared; }
+
 	template <class T2, class DL2>
 	friend class DisposablePtr;
 
@@ -194,6 +194,10 @@ public:
 	 * exports from the Quest for Glory series. QfG5 is a 3D game and will not be
 	 * supported by ScummVM.
 	 *
+	 * Backends may write the save file in the background once it is
+	 * finalized. Failures of such writes are reported by getError() after
+	 * a later call to the save file manager.
+	 *
 	 * @param name      Name of the save file.
 	 * @param compress  Whether to compress the resulting save file (default) or not.
 	 *
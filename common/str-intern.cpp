@@ -0,0 +1,72 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/str-intern.h"
+#include "common/path.h"
+
+namespace Common {
+
+InternedString::Table &InternedString::getTable() {
+	// Constructed on first use, so that interned strings may be global
+	static Table table;
+	return table;
+}
+
+const InternedString::Entry *InternedString::intern(const String &str) {
+	Table &table = getTable();
+
+	// HashMap nodes never move, so the entries can be referenced directly
+	Table::iterator i = table.find(str);
+	if (i != table.end())
+		return &i->_value;
+
+	Entry &entry = table[str];
+	entry.str = str;
+	entry.hash = str.hash();
+	entry.lower = &entry;
+
+	String lower(str);
+	lower.toLowercase();
+	if (lower != str)
+		entry.lower = intern(lower);
+
+	return &entry;
+}
+
+uint InternedString::getTableSize() {
+	return getTable().size();
+}
+
+InternedString::InternedString() {
+	static const Entry *const emptyEntry = intern(String());
+	_entry = emptyEntry;
+}
+
+InternedString::InternedString(const char *str) : _entry(intern(String(str))) {
+}
+
+InternedString::InternedString(const String &str) : _entry(intern(str)) {
+}
+
+InternedString::InternedString(const Path &path) : _entry(intern(path.toString())) {
+}
+
+} // End of namespace Common
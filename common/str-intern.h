@@ -0,0 +1,138 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_STR_INTERN_H
+#define COMMON_STR_INTERN_H
+
+#include "common/hash-str.h"
+
+namespace Common {
+
+class Path;
+
+/**
+ * @defgroup common_str_intern Interned strings
+ * @ingroup common_str
+ *
+ * @brief An atom table for strings used as lookup keys.
+ * @{
+ */
+
+/**
+ * An immutable string which is stored only once in a global table.
+ *
+ * Constructing an InternedString hashes the string and looks it up in the
+ * table, which costs about as much as a single HashMap lookup. From then on,
+ * hashing it is free, and comparing two InternedStrings, with or without
+ * ignoring case, compares a single pointer. This makes them suited as keys
+ * of symbol tables which are searched in hot loops, e.g. by interpreters.
+ *
+ * Interned strings are never freed, so they should not be used for
+ * arbitrary data. The table is not thread-safe.
+ */
+class InternedString {
+public:
+	/** Construct the empty string. */
+	InternedString();
+
+	InternedString(const char *str);
+	InternedString(const String &str);
+
+	/** Intern the path in its string form, using '/' as separator. */
+	explicit InternedString(const Path &path);
+
+	const String &toString() const { return _entry->str; }
+	const char *c_str() const { return _entry->str.c_str(); }
+	uint size() const { return _entry->str.size(); }
+	bool empty() const { return _entry->str.empty(); }
+
+	/** Return the hash of the string, as String::hash() would. */
+	uint hash() const { return _entry->hash; }
+
+	/** Return the lowercase version of this string, which is interned as well. */
+	InternedString lower() const { return InternedString(_entry->lower); }
+
+	bool operator==(const InternedString &x) const { return _entry == x._entry; }
+	bool operator!=(const InternedString &x) const { return _entry != x._entry; }
+
+	/** Order by contents, so that sorting does not depend on the order of interning. */
+	bool operator<(const InternedString &x) const { return _entry != x._entry && _entry->str < x._entry->str; }
+
+	bool equalsIgnoreCase(const InternedString &x) const { return _entry->lower == x._entry->lower; }
+
+	/** Return the number of strings interned so far. */
+	static uint getTableSize();
+
+private:
+	struct Entry {
+		String str;
+		uint hash;
+		/** The entry of the lowercase version of str, or this entry itself. */
+		const Entry *lower;
+	};
+
+	explicit InternedString(const Entry *entry) : _entry(entry) {}
+
+	typedef HashMap<String, Entry> Table;
+
+	static Table &getTable();
+	static const Entry *intern(const String &str);
+
+	const Entry *_entry;
+
+	friend struct InternedIgnoreCase_Hash;
+	friend struct InternedIgnoreCase_EqualTo;
+};
+
+/**
+ * Case insensitive hash functor for InternedString, to be used together
+ * with InternedIgnoreCase_EqualTo.
+ */
+struct InternedIgnoreCase_Hash {
+	uint operator()(const InternedString &x) const { return x._entry->lower->hash; }
+};
+
+struct InternedIgnoreCase_EqualTo {
+	bool operator()(const InternedString &x, const InternedString &y) const { return x._entry->lower == y._entry->lower; }
+};
+
+// Specialization of the Hash functor for InternedString objects, which
+// hashes case sensitively like the default EqualTo compares.
+template<>
+struct Hash<InternedString> {
+	uint operator()(const InternedString &s) const {
+		return s.hash();
+	}
+};
+
+/** Symbol table keyed by interned strings, case sensitive. */
+template<class Val>
+using InternedStringMap = HashMap<InternedString, Val>;
+
+/** Symbol table keyed by interned strings, ignoring case. */
+template<class Val>
+using InternedStringMapIgnoreCase = HashMap<InternedString, Val, InternedIgnoreCase_Hash, InternedIgnoreCase_EqualTo>;
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -127,6 +127,25 @@ uint32 MemoryReadStream::read(void *dataPtr, uint32 dataSize) {
 	return dataSize;
 }
 
+SeekableReadStream *MemoryReadStream::readStream(uint32 dataSize) {
+	const SharedPtr<const byte> &owner = _ptrOrig.getShared();
+	if (!owner)
+		return SeekableReadStream::readStream(dataSize);
+
+	// Hand out a view which shares ownership of our buffer
+	if (dataSize > _size - _pos) {
+		dataSize = _size - _pos;
+		_eos = true;
+	}
+
+	SeekableReadStream *view = new MemoryReadStream(SharedPtr<byte>(owner, const_cast<byte *>(_ptr)), dataSize);
+
+	_ptr += dataSize;
+	_pos += dataSize;
+
+	return view;
+}
+
 bool MemoryReadStream::seek(int64 offs, int whence) {
 	// Pre-Condition
 	assert(_pos <= _size);
@@ -256,6 +275,21 @@ uint32 SubReadStream::read(void *dataPtr, uint32 dataSize) {
 	return dataSize;
 }
 
+SeekableReadStream *SubReadStream::readStream(uint32 dataSize) {
+	if (!_parentStream->supportsZeroCopy())
+		return ReadStream::readStream(dataSize);
+
+	if (dataSize > _end - _pos) {
+		dataSize = _end - _pos;
+		_eos = true;
+	}
+
+	SeekableReadStream *view = _parentStream->readStream(dataSize);
+	_pos += view->size();
+
+	return view;
+}
+
 SeekableSubReadStream::SeekableSubReadStream(SeekableReadStream *parentStream, uint32 begin, uint32 end, DisposeAfterUse::Flag disposeParentStream)
 	: SubReadStream(parentStream, end, disposeParentStream),
 	_parentStream(parentStream),
@@ -299,6 +333,13 @@ uint32 SafeSeekableSubReadStream::read(void *dataPtr, uint32 dataSize) {
 	return SeekableSubReadStream::read(dataPtr, dataSize);
 }
 
+SeekableReadStream *SafeSeekableSubReadStream::readStream(uint32 dataSize) {
+	// Make sure the parent stream is at the right position
+	seek(0, SEEK_CUR);
+
+	return SeekableSubReadStream::readStream(dataSize);
+}
+
 void SeekableReadStream::hexdump(int len, int bytesPerLine, int startOffset) {
 	uint pos_ = pos();
 	uint size_ = size();
@@ -611,4 +652,9 @@ uint32 SafeMutexedSeekableSubReadStream::read(void *dataPtr, uint32 dataSize) {
 	return Common::SafeSeekableSubReadStream::read(dataPtr, dataSize);
 }
 
+SeekableReadStream *SafeMutexedSeekableSubReadStream::readStream(uint32 dataSize) {
+	Common::StackLock lock(_mutex);
+	return Common::SafeSeekableSubReadStream::readStream(dataSize);
+}
+
 } // End of namespace Common
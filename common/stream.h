@@ -710,12 +710,22 @@ public:
 	 * Read the specified amount of data into a malloc'ed buffer
 	 * which is then wrapped into a MemoryReadStream.
 	 *
+	 * Streams which are backed by shared memory (see supportsZeroCopy())
+	 * instead return a MemoryReadStream viewing that memory, which keeps
+	 * it alive for as long as needed.
+	 *
 	 * The returned stream might contain less data than requested
 	 * if reading more data failed. This is because of an I/O error or because
 	 * the end of the stream was reached. It can be determined by
 	 * calling err() and eos().
 	 */
-	SeekableReadStream *readStream(uint32 dataSize);
+	virtual SeekableReadStream *readStream(uint32 dataSize);
+
+	/**
+	 * Check whether readStream() returns views of memory backing this
+	 * stream, without copying any data.
+	 */
+	virtual bool supportsZeroCopy() const { return false; }
 
 	/**
 	 * Reads in a terminated string. Upon successful completion,
@@ -65,6 +65,8 @@ public:
 	virtual bool err() const { return _parentStream->err(); }
 	virtual void clearErr() { _eos = false; _parentStream->clearErr(); }
 	virtual uint32 read(void *dataPtr, uint32 dataSize);
+	virtual SeekableReadStream *readStream(uint32 dataSize);
+	virtual bool supportsZeroCopy() const { return _parentStream->supportsZeroCopy(); }
 };
 
 /*
@@ -108,6 +110,7 @@ public:
 	}
 
 	virtual uint32 read(void *dataPtr, uint32 dataSize);
+	virtual SeekableReadStream *readStream(uint32 dataSize);
 };
 
 /**
@@ -124,6 +127,7 @@ public:
 		: SafeSeekableSubReadStream(parentStream, begin, end, disposeParentStream), _mutex(mutex) {
 	}
 	uint32 read(void *dataPtr, uint32 dataSize) override;
+	SeekableReadStream *readStream(uint32 dataSize) override;
 protected:
 	Common::Mutex &_mutex;
 };
@@ -25,6 +25,7 @@
 #include "common/events.h"
 #include "common/fs.h"
 #include "common/file.h"
+#include "common/jobsystem.h"
 #include "common/savefile.h"
 #include "common/str.h"
 #include "common/taskbar.h"
@@ -46,6 +47,7 @@ OSystem::OSystem() {
 	_audiocdManager = nullptr;
 	_eventManager = nullptr;
 	_timerManager = nullptr;
+	_jobSystem = nullptr;
 	_savefileManager = nullptr;
 #if defined(USE_TASKBAR)
 	_taskbarManager = nullptr;
@@ -93,6 +95,10 @@ OSystem::~OSystem() {
 	delete _savefileManager;
 	_savefileManager = nullptr;
 
+	// The savefile manager may still have been waiting for jobs
+	delete _jobSystem;
+	_jobSystem = nullptr;
+
 	delete _fsFactory;
 	_fsFactory = nullptr;
 
@@ -112,6 +118,10 @@ void OSystem::initBackend() {
 	if (!_savefileManager)
 		error("Backend failed to instantiate savefile manager");
 
+	// Backends without worker threads run all jobs inline
+	if (!_jobSystem)
+		_jobSystem = new Common::JobSystem();
+
 	// TODO: We currently don't check _fsFactory because not all ports
 	// set it.
 // 	if (!_fsFactory)
@@ -272,6 +282,10 @@ Common::TimerManager *OSystem::getTimerManager() {
 	return _timerManager;
 }
 
+Common::JobSystem *OSystem::getJobSystem() {
+	return _jobSystem;
+}
+
 Common::SaveFileManager *OSystem::getSavefileManager() {
 	return _savefileManager;
 }
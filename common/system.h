@@ -55,6 +55,7 @@ class Store;
 namespace Common {
 class EventManager;
 class MutexInternal;
+class JobSystem;
 struct Rect;
 class SaveFileManager;
 class SearchSet;
@@ -212,6 +213,15 @@ protected:
 	 */
 	Common::TimerManager *_timerManager;
 
+	/**
+	 * No default value is provided for _jobSystem by OSystem.
+	 * However, OSystem::initBackend() does set a default value
+	 * (which runs all jobs inline) if none has been set before.
+	 *
+	 * @note _jobSystem is deleted by the OSystem destructor.
+	 */
+	Common::JobSystem *_jobSystem;
+
 	/**
 	 * No default value is provided for _savefileManager by OSystem.
 	 *
@@ -1562,6 +1572,15 @@ public:
 	 */
 	virtual uint32 getMillis(bool skipRecord = false) = 0;
 
+	/**
+	 * Get a high resolution timestamp in microseconds, for profiling and
+	 * benchmarking. Only differences between two timestamps are meaningful.
+	 *
+	 * This is never recorded by the event recorder. The default
+	 * implementation is based on getMillis().
+	 */
+	virtual uint64 getMicros() { return (uint64)getMillis(true) * 1000; }
+
 	/** Delay/sleep for the specified amount of milliseconds. */
 	virtual void delayMillis(uint msecs) = 0;
 
@@ -1638,6 +1657,10 @@ public:
 	 *
 	 * Hence, backends that do not use threads to implement the timers can simply
 	 * use dummy implementations for these methods.
+	 *
+	 * Code which wants to spread work over several cores should use the job
+	 * system, which backends without threads implement by running all jobs
+	 * inline.
 	 */
 
 	/**
@@ -1647,6 +1670,14 @@ public:
 	 */
 	virtual Common::MutexInternal *createMutex() = 0;
 
+	/**
+	 * Return the job system, which is the sanctioned way to run work
+	 * on several threads.
+	 *
+	 * For more information, see @ref JobSystem.
+	 */
+	virtual Common::JobSystem *getJobSystem();
+
 	/** @} */
 
 
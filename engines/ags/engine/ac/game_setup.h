@@ -23,6 +23,7 @@
 #define AGS_ENGINE_AC_GAME_SETUP_H
 
 #include "ags/engine/main/graphics_mode.h"
+#include "ags/shared/ac/sprite_cache.h"
 #include "ags/shared/ac/game_version.h"
 #include "ags/shared/util/string.h"
 
@@ -61,6 +62,7 @@ using AGS::Shared::String;
 struct GameSetup {
 	static const size_t DefSpriteCacheSize = (128 * 1024); // 128 MB
 	static const size_t DefTexCacheSize = (128 * 1024);    // 128 MB
+	static const size_t DefSpriteComprCacheSize = DEFAULTCOMPRCACHESIZE_KB; // platform default
 
 	bool  audio_enabled;
 	String audio_driver;
@@ -92,6 +94,7 @@ struct GameSetup {
 	bool  RenderAtScreenRes; // render sprites at screen resolution, as opposed to native one
 	size_t SpriteCacheSize = DefSpriteCacheSize;  // in KB
 	size_t TextureCacheSize = DefTexCacheSize;  // in KB
+	size_t SpriteComprCacheSize = DefSpriteComprCacheSize; // in KB, 0 disables compressed sprite cache
 	bool  clear_cache_on_room_change; // for low-end devices: clear resource caches on room change
 	bool  load_latest_save; // load latest saved game on launch
 	ScreenRotation rotation;
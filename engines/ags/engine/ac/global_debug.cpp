@@ -65,7 +65,7 @@ String GetRuntimeInfo() {
 		"%s[Engine version %s"
 		"[Game resolution %d x %d (%d-bit)"
 		"[Running %d x %d at %d-bit%s[GFX: %s; %s[Draw frame %d x %d["
-		"Sprite cache KB: %zu, norm: %zu / %zu (%u%%), locked: %zu",
+		"Sprite cache KB: %zu, norm: %zu / %zu (%u%%), locked: %zu, compressed: %zu / %zu",
 		get_engine_name(),
 		get_engine_version_and_build().GetCStr(),
 		_GP(game).GetGameRes().Width, _GP(game).GetGameRes().Height, _GP(game).GetColorDepth(),
@@ -73,7 +73,8 @@ String GetRuntimeInfo() {
 		mode.IsWindowed() ? " W" : "",
 		_G(gfxDriver)->GetDriverName(), filter->GetInfo().Name.GetCStr(),
 		render_frame.GetWidth(), render_frame.GetHeight(),
-		total_spr / 1024, total_normspr / 1024, max_normspr / 1024, norm_spr_filled, total_lockspr / 1024);
+		total_spr / 1024, total_normspr / 1024, max_normspr / 1024, norm_spr_filled, total_lockspr / 1024,
+		_GP(spriteset).GetCompressedCacheSize() / 1024, _GP(spriteset).GetMaxCompressedCacheSize() / 1024);
 	if (_GP(play).separate_music_lib)
 		runtimeInfo.Append("[AUDIO.VOX enabled");
 	if (_GP(play).voice_avail)
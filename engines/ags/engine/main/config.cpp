@@ -364,6 +364,7 @@ void apply_config(const ConfigTree &cfg) {
 		_GP(usetup).clear_cache_on_room_change = CfgReadBoolInt(cfg, "misc", "clear_cache_on_room_change", _GP(usetup).clear_cache_on_room_change);
 		_GP(usetup).SpriteCacheSize = CfgReadInt(cfg, "graphics", "sprite_cache_size", _GP(usetup).SpriteCacheSize);
 		_GP(usetup).TextureCacheSize = CfgReadInt(cfg, "graphics", "texture_cache_size", _GP(usetup).TextureCacheSize);
+		_GP(usetup).SpriteComprCacheSize = CfgReadInt(cfg, "graphics", "sprite_cache_compressed_size", _GP(usetup).SpriteComprCacheSize);
 
 		// Mouse options
 		_GP(usetup).mouse_auto_lock = CfgReadBoolInt(cfg, "mouse", "auto_lock");
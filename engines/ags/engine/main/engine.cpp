@@ -504,7 +504,9 @@ int engine_init_sprites() {
 
 	if (_GP(usetup).SpriteCacheSize > 0)
 		_GP(spriteset).SetMaxCacheSize(_GP(usetup).SpriteCacheSize * 1024);
-	Debug::Printf("Sprite cache set: %zu KB", _GP(spriteset).GetMaxCacheSize() / 1024);
+	_GP(spriteset).SetMaxCompressedCacheSize(_GP(usetup).SpriteComprCacheSize * 1024);
+	Debug::Printf("Sprite cache set: %zu KB, compressed: %zu KB", _GP(spriteset).GetMaxCacheSize() / 1024,
+		_GP(spriteset).GetMaxCompressedCacheSize() / 1024);
 	return 0;
 }
 
@@ -60,7 +60,8 @@ namespace Shared {
 
 SpriteCache::SpriteCache(std::vector<SpriteInfo> &sprInfos, const Callbacks &callbacks)
 	: _sprInfos(sprInfos), _maxCacheSize(DEFAULTCACHESIZE_KB * 1024u),
-	  _cacheSize(0u), _lockedSize(0u) {
+	  _cacheSize(0u), _lockedSize(0u),
+	  _maxComprSize(DEFAULTCOMPRCACHESIZE_KB * 1024u), _comprSize(0u) {
 	_callbacks.AdjustSize = (callbacks.AdjustSize) ? callbacks.AdjustSize : DummyAdjustSize;
 	_callbacks.InitSprite = (callbacks.InitSprite) ? callbacks.InitSprite : DummyInitSprite;
 	_callbacks.PostInitSprite = (callbacks.PostInitSprite) ? callbacks.PostInitSprite : DummyPostInitSprite;
@@ -82,6 +83,14 @@ size_t SpriteCache::GetMaxCacheSize() const {
 	return _maxCacheSize;
 }
 
+size_t SpriteCache::GetCompressedCacheSize() const {
+	return _comprSize;
+}
+
+size_t SpriteCache::GetMaxCompressedCacheSize() const {
+	return _maxComprSize;
+}
+
 size_t SpriteCache::GetSpriteSlotCount() const {
 	return _spriteData.size();
 }
@@ -91,6 +100,11 @@ void SpriteCache::SetMaxCacheSize(size_t size) {
 	_maxCacheSize = size;
 }
 
+void SpriteCache::SetMaxCompressedCacheSize(size_t size) {
+	_maxComprSize = size;
+	FreeCompressedMem(0);
+}
+
 bool SpriteCache::HasFreeSlots() const {
 	return !((_spriteData.size() == SIZE_MAX) || (_spriteData.size() > MAX_SPRITE_INDEX));
 }
@@ -104,8 +118,10 @@ void SpriteCache::Reset() {
 	_file.Close();
 	_spriteData.clear();
 	_mru.clear();
+	_mruCompressed.clear();
 	_cacheSize = 0;
 	_lockedSize = 0;
+	_comprSize = 0;
 }
 
 bool SpriteCache::SetSprite(sprkey_t index, std::unique_ptr<Bitmap> image, int flags) {
@@ -123,6 +139,7 @@ bool SpriteCache::SetSprite(sprkey_t index, std::unique_ptr<Bitmap> image, int f
 		| (SPF_HICOLOR * image->GetColorDepth() > 8)
 		| (SPF_TRUECOLOR * image->GetColorDepth() > 16);
 	_sprInfos[index] = SpriteInfo(image->GetWidth(), image->GetHeight(), spf_flags);
+	DisposeCompressed(index);
 	// Assign sprite with 0 size, as it will not be included into the cache size
 	_spriteData[index] = SpriteData(image.release(), 0, SPRCACHEFLAG_EXTERNAL | SPRCACHEFLAG_LOCKED);
 	SprCacheLog("SetSprite: (external) %d", index);
@@ -300,6 +317,8 @@ void SpriteCache::DisposeAllFreeCached() {
 		{
 			_spriteData[i].Image.reset();
 		}
+		// Packed images are disposed too, as this is meant to release memory
+		DisposeCompressed(i);
 	}
 	_cacheSize = _lockedSize;
 	_mru.clear();
@@ -364,23 +383,30 @@ size_t SpriteCache::LoadSprite(sprkey_t index, bool lock) {
 		return 0;
 	assert((_spriteData[index].Flags & SPRCACHEFLAG_ISASSET) != 0);
 
-	Bitmap *image;
-	HError err = _file.LoadSprite(index, image);
+	// Try the compressed tier first, the image stored there is already initialized
+	Bitmap *image = LoadCompressed(index);
 	if (!image) {
-		Debug::Printf(kDbgGroup_SprCache, kDbgMsg_Warn,
-			"LoadSprite: failed to load sprite %d:\n%s\n - remapping to placeholder", index,
-			err ? "Sprite does not exist." : err->FullMessage().GetCStr());
-		RemapSpriteToPlaceholder(index);
-		return 0;
-	}
+		HError err = _file.LoadSprite(index, image);
+		if (!image) {
+			Debug::Printf(kDbgGroup_SprCache, kDbgMsg_Warn,
+				"LoadSprite: failed to load sprite %d:\n%s\n - remapping to placeholder", index,
+				err ? "Sprite does not exist." : err->FullMessage().GetCStr());
+			RemapSpriteToPlaceholder(index);
+			return 0;
+		}
 
-	// Let the external user convert this sprite's image for their needs
-	image = _callbacks.InitSprite(index, image, _sprInfos[index].Flags);
-	if (!image) {
-		Debug::Printf(kDbgGroup_SprCache, kDbgMsg_Warn,
-					  "LoadSprite: failed to initialize sprite %d, remapping to placeholder", index);
-		RemapSpriteToPlaceholder(index);
-		return 0;
+		// Let the external user convert this sprite's image for their needs
+		image = _callbacks.InitSprite(index, image, _sprInfos[index].Flags);
+		if (!image) {
+			Debug::Printf(kDbgGroup_SprCache, kDbgMsg_Warn,
+						  "LoadSprite: failed to initialize sprite %d, remapping to placeholder", index);
+			RemapSpriteToPlaceholder(index);
+			return 0;
+		}
+		// Keep a packed copy before the post-init callback gets a chance
+		// to modify the pixels, so that the restored image is identical
+		// to one loaded from the file
+		StoreCompressed(index, image);
 	}
 
 	// save the stored sprite info
@@ -391,8 +417,10 @@ size_t SpriteCache::LoadSprite(sprkey_t index, bool lock) {
 	FreeMem(size);
 	// Add to the cache, lock if requested or if it's sprite 0
 	const bool should_lock = lock || (index == 0);
-	_spriteData[index] = SpriteData(image, size, SPRCACHEFLAG_ISASSET);
-	_spriteData[index].Flags |= (SPRCACHEFLAG_LOCKED * should_lock);
+	// NOTE: keep the compressed data, which may be assigned above
+	_spriteData[index].Image.reset(image);
+	_spriteData[index].Size = size;
+	_spriteData[index].Flags = SPRCACHEFLAG_ISASSET | (SPRCACHEFLAG_LOCKED * should_lock);
 	_cacheSize += size;
 	SprCacheLog("Loaded %d, size now %zu KB", index, _cacheSize / 1024);
 
@@ -413,10 +441,162 @@ void SpriteCache::RemapSpriteToPlaceholder(sprkey_t index) {
 
 void SpriteCache::InitNullSprite(sprkey_t index) {
 	assert(index >= 0);
+	DisposeCompressed(index);
 	_sprInfos[index] = SpriteInfo();
 	_spriteData[index] = SpriteData();
 }
 
+// Packs pixels using a simple RLE scheme, optimized for the fast unpacking
+// from memory: each chunk begins with a control byte, which tells either
+// a number of literal pixels that follow (0-127 => 1-128 pixels), or a number
+// of repeats of the single following pixel (128-255 => 2-129 pixels).
+static void PackPixelsRLE(const uint8_t *src, size_t count, int bpp, std::vector<uint8_t> &out) {
+	size_t i = 0;
+	while (i < count) {
+		// Measure the run of equal pixels starting at i
+		size_t run = 1;
+		while ((i + run < count) && (run < 129) &&
+				(memcmp(src + i * bpp, src + (i + run) * bpp, bpp) == 0))
+			run++;
+		if (run > 1) {
+			out.push_back(static_cast<uint8_t>(0x80 | (run - 2)));
+			out.insert(out.end(), src + i * bpp, src + (i + 1) * bpp);
+			i += run;
+			continue;
+		}
+		// Otherwise gather literal pixels until the next run of at least 2
+		size_t lit = 1;
+		while ((i + lit < count) && (lit < 128) &&
+				!((i + lit + 1 < count) &&
+				(memcmp(src + (i + lit) * bpp, src + (i + lit + 1) * bpp, bpp) == 0)))
+			lit++;
+		out.push_back(static_cast<uint8_t>(lit - 1));
+		out.insert(out.end(), src + i * bpp, src + (i + lit) * bpp);
+		i += lit;
+	}
+}
+
+// Unpacks exactly "count" pixels; returns position past the consumed data,
+// or nullptr if the data is malformed
+static const uint8_t *UnpackPixelsRLE(const uint8_t *src, const uint8_t *src_end, uint8_t *dst, size_t count, int bpp) {
+	uint8_t *dst_end = dst + count * bpp;
+	while ((dst < dst_end) && (src < src_end)) {
+		const uint8_t ctrl = *src++;
+		if (ctrl & 0x80) {
+			const size_t run = (ctrl & 0x7F) + 2;
+			if ((src_end - src < bpp) || (static_cast<size_t>(dst_end - dst) < run * bpp))
+				return nullptr;
+			switch (bpp) {
+			case 1:
+				memset(dst, *src, run);
+				break;
+			case 2: {
+				const uint16_t px = READ_UINT16(src);
+				for (size_t n = 0; n < run; ++n)
+					WRITE_UINT16(dst + n * 2, px);
+				break;
+			}
+			case 4: {
+				const uint32_t px = READ_UINT32(src);
+				for (size_t n = 0; n < run; ++n)
+					WRITE_UINT32(dst + n * 4, px);
+				break;
+			}
+			default:
+				for (size_t n = 0; n < run; ++n)
+					memcpy(dst + n * bpp, src, bpp);
+				break;
+			}
+			src += bpp;
+			dst += run * bpp;
+		} else {
+			const size_t len = (ctrl + 1) * bpp;
+			if ((static_cast<size_t>(src_end - src) < len) || (static_cast<size_t>(dst_end - dst) < len))
+				return nullptr;
+			memcpy(dst, src, len);
+			src += len;
+			dst += len;
+		}
+	}
+	return (dst == dst_end) ? src : nullptr;
+}
+
+void SpriteCache::StoreCompressed(sprkey_t index, const Bitmap *image) {
+	if (_maxComprSize == 0 || index == 0)
+		return;
+	DisposeCompressed(index);
+
+	const int bpp = image->GetBPP();
+	const size_t raw_size = image->GetDataSize();
+	std::vector<uint8_t> data;
+	data.reserve(raw_size / 2);
+	for (int y = 0; y < image->GetHeight(); ++y)
+		PackPixelsRLE(image->GetScanLine(y), image->GetWidth(), bpp, data);
+	// Don't bother if the image does not pack well, or won't fit at all
+	if (data.size() >= raw_size || data.size() > _maxComprSize)
+		return;
+
+	FreeCompressedMem(data.size());
+	CompressedData &cmpr = _spriteData[index].Compressed;
+	cmpr.Width = image->GetWidth();
+	cmpr.Height = image->GetHeight();
+	cmpr.ColorDepth = image->GetColorDepth();
+	cmpr.Data = std::move(data);
+	cmpr.MruIt = _mruCompressed.insert(_mruCompressed.begin(), index);
+	_comprSize += cmpr.Data.size();
+	SprCacheLog("StoreCompressed: %d, %zu -> %zu bytes, tier size now %zu KB",
+				index, raw_size, cmpr.Data.size(), _comprSize / 1024);
+}
+
+Bitmap *SpriteCache::LoadCompressed(sprkey_t index) {
+	CompressedData &cmpr = _spriteData[index].Compressed;
+	if (cmpr.Data.empty())
+		return nullptr;
+
+	std::unique_ptr<Bitmap> image(BitmapHelper::CreateBitmap(cmpr.Width, cmpr.Height, cmpr.ColorDepth));
+	const uint8_t *src = cmpr.Data.data();
+	const uint8_t *src_end = src + cmpr.Data.size();
+	// Each scanline was packed separately, so unpack them one by one too
+	for (int y = 0; image && src && y < cmpr.Height; ++y)
+		src = UnpackPixelsRLE(src, src_end, image->GetScanLineForWriting(y), cmpr.Width, image->GetBPP());
+	if (!image || !src) {
+		Debug::Printf(kDbgGroup_SprCache, kDbgMsg_Warn, "LoadCompressed: failed to unpack sprite %d", index);
+		DisposeCompressed(index);
+		return nullptr;
+	}
+
+	// Move to the beginning of the compressed tier's MRU list
+	_mruCompressed.splice(_mruCompressed.begin(), _mruCompressed, cmpr.MruIt);
+	SprCacheLog("LoadCompressed: %d", index);
+	return image.release();
+}
+
+void SpriteCache::DisposeCompressed(sprkey_t index) {
+	CompressedData &cmpr = _spriteData[index].Compressed;
+	if (cmpr.Data.empty())
+		return;
+	_comprSize -= cmpr.Data.size();
+	_mruCompressed.erase(cmpr.MruIt);
+	// std::list::erase() invalidates iterators to the erased item.
+	// But our implementation does not.
+	cmpr.MruIt._node = nullptr;
+	cmpr.Data = std::vector<uint8_t>();
+}
+
+void SpriteCache::DisposeOldestCompressed() {
+	assert(_mruCompressed.size() > 0);
+	if (_mruCompressed.size() == 0)
+		return;
+	const auto sprnum = *std::prev(_mruCompressed.end());
+	DisposeCompressed(sprnum);
+	SprCacheLog("DisposeOldestCompressed: disposed %d, tier size now %zu KB", sprnum, _comprSize / 1024);
+}
+
+void SpriteCache::FreeCompressedMem(size_t space) {
+	while ((_mruCompressed.size() > 0) && (_comprSize + space > _maxComprSize))
+		DisposeOldestCompressed();
+}
+
 int SpriteCache::SaveToFile(const String &filename, int store_flags, SpriteCompression compress, SpriteFileIndex &index) {
 	std::vector<std::pair<bool, Bitmap *>> sprites;
 	for (size_t i = 0; i < _spriteData.size(); ++i) {
@@ -25,6 +25,10 @@
 // SpriteFile handles sprite serialization and streaming.
 // SpriteCache provides bitmaps by demand; it uses SpriteFile to load sprites
 // and does MRU (most-recent-use) caching.
+// Loaded asset sprites are additionally kept in a second, compressed tier
+// with its own size limit; when a sprite disposed from the main cache is
+// requested again it is unpacked from there instead of being read and
+// converted from the sprite file anew.
 //
 // TODO: store sprite data in a specialized container type that is optimized
 // for having most keys allocated in large continious sequences by default.
@@ -72,6 +76,14 @@ struct SpriteInfo;
 #define DEFAULTCACHESIZE_KB (128 * 1024)
 #endif
 
+// Max size of the compressed sprite cache tier, in KB; smaller on mobile
+// platforms, including the ScummVM ports to them
+#if AGS_PLATFORM_OS_ANDROID || AGS_PLATFORM_OS_IOS || defined(__ANDROID__) || defined(IPHONE)
+#define DEFAULTCOMPRCACHESIZE_KB (8 * 1024)
+#else
+#define DEFAULTCOMPRCACHESIZE_KB (32 * 1024)
+#endif
+
 struct SpriteInfo;
 
 namespace AGS {
@@ -128,6 +140,10 @@ public:
 	size_t      GetLockedSize() const;
 	// Returns maximal size limit of the cache, in bytes; this includes locked size too!
 	size_t      GetMaxCacheSize() const;
+	// Returns current size of the compressed cache tier, in bytes
+	size_t      GetCompressedCacheSize() const;
+	// Returns maximal size limit of the compressed cache tier, in bytes
+	size_t      GetMaxCompressedCacheSize() const;
 	// Returns number of sprite slots in the bank (this includes both actual sprites and free slots)
 	size_t      GetSpriteSlotCount() const;
 	// Tells if the sprite storage still has unoccupied slots to put new sprites in
@@ -174,6 +190,8 @@ public:
 	void        SetEmptySprite(sprkey_t index, bool as_asset);
 	// Sets max cache size in bytes
 	void        SetMaxCacheSize(size_t size);
+	// Sets max compressed cache tier size in bytes; 0 disables the tier
+	void        SetMaxCompressedCacheSize(size_t size);
 
 	// Loads (if it's not in cache yet) and returns bitmap by the sprite index
 	Bitmap *operator[](sprkey_t index);
@@ -189,6 +207,16 @@ private:
 	void        FreeMem(size_t space);
 	// Initialize the empty sprite slot
 	void 		InitNullSprite(sprkey_t index);
+	// Packs the freshly initialized sprite image into the compressed tier
+	void        StoreCompressed(sprkey_t index, const Bitmap *image);
+	// Unpacks the sprite image from the compressed tier, if it's present there
+	Bitmap     *LoadCompressed(sprkey_t index);
+	// Removes the sprite's data from the compressed tier
+	void        DisposeCompressed(sprkey_t index);
+	// Delete the oldest (least recently used) data in the compressed tier
+	void        DisposeOldestCompressed();
+	// Keep disposing oldest compressed data until there's at least the given free space
+	void        FreeCompressedMem(size_t space);
 	//
     // Dummy no-op variants for callbacks
     //
@@ -197,11 +225,23 @@ private:
 	static void   DummyPostInitSprite(sprkey_t) { /* do nothing */ }
 	static void   DummyPrewriteSprite(Bitmap *) { /* do nothing */ }
 
+	// Sprite image packed for the compressed cache tier
+	struct CompressedData {
+		std::vector<uint8_t> Data;  // packed pixels
+		int Width = 0;
+		int Height = 0;
+		int ColorDepth = 0;
+
+		// Compressed tier MRU list reference
+		std::list<sprkey_t>::iterator MruIt;
+	};
+
 	// Information required for the sprite streaming
 	struct SpriteData {
 		size_t	 Size  = 0;			   // to track cache size, 0 = means don't track
 		uint32_t Flags = 0;			   // SPRCACHEFLAG* flags
 		std::unique_ptr<Bitmap> Image; // actual bitmap
+		CompressedData Compressed;     // packed copy of the asset image, if any
 
 		// MRU list reference
 		std::list<sprkey_t>::iterator MruIt;
@@ -239,11 +279,15 @@ private:
 	size_t _maxCacheSize;  // cache size limit
 	size_t _lockedSize;    // size in bytes of currently locked images
 	size_t _cacheSize;     // size in bytes of currently cached images
+	size_t _maxComprSize;  // compressed tier size limit
+	size_t _comprSize;     // size in bytes of currently packed images
 
 	// MRU list: the way to track which sprites were used recently.
 	// When clearing up space for new sprites, cache first deletes the sprites
 	// that were last time used long ago.
 	std::list<sprkey_t> _mru;
+	// MRU list of the compressed tier
+	std::list<sprkey_t> _mruCompressed;
 
 };
 
@@ -227,7 +227,13 @@ Engine::~Engine() {
 }
 
 void Engine::initializePath(const Common::FSNode &gamePath) {
-	SearchMan.addDirectory(gamePath, 0, 4);
+	if (!gamePath.exists() || !gamePath.isDirectory())
+		error("Failed to add directory %s", gamePath.getPath().toString().c_str());
+
+	// Game data is only read, so large files may be memory mapped
+	Common::FSDirectory *dir = new Common::FSDirectory(gamePath, 4);
+	dir->setMapFiles(true);
+	SearchMan.add(gamePath.getPath().toString(), dir, 0);
 }
 
 bool Engine::enhancementEnabled(int32 cls) {
@@ -994,6 +1000,8 @@ Common::Error Engine::saveGameState(int slot, const Common::String &desc, bool i
 		getMetaEngine()->appendExtendedSave(saveFile, getTotalPlayTime(), desc, isAutosave);
 
 		saveFile->finalize();
+		if (saveFile->err())
+			result = Common::kWritingFailed;
 	}
 
 	delete saveFile;
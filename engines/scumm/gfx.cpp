@@ -74,6 +74,9 @@ enum {
 	kC64Delay = 6
 };
 
+// Upper bound for the decoded room strips kept by Gdi::drawStrip
+static const uint32 kStripCacheMaxSize = 1024 * 1024;
+
 #define NUM_SHAKE_POSITIONS 8
 static const int8 shake_positions[NUM_SHAKE_POSITIONS] = {
 	0, 1, 2, 1, 0, 2, 3, 1
@@ -216,9 +219,17 @@ Gdi::Gdi(ScummEngine *vm) : _vm(vm) {
 	_zbufferDisabled = false;
 	_objectMode = false;
 	_distaff = false;
+
+	_stripCacheSmap = nullptr;
+	_stripCacheSmapLen = 0;
+	_stripCacheY = 0;
+	_stripCacheHeight = 0;
+	_stripCacheSize = 0;
+	memset(_stripCachePalette, 0, sizeof(_stripCachePalette));
 }
 
 Gdi::~Gdi() {
+	clearStripCache();
 }
 
 GdiHE::GdiHE(ScummEngine *vm) : Gdi(vm), _tmskPtr(nullptr) {
@@ -285,6 +296,71 @@ void Gdi::init() {
 }
 
 void Gdi::roomChanged(byte *roomptr) {
+	clearStripCache();
+}
+
+void Gdi::clearStripCache() {
+	for (uint i = 0; i < _stripCache.size(); i++)
+		free(_stripCache[i]);
+	_stripCache.clear();
+	_stripCacheSmap = nullptr;
+	_stripCacheSmapLen = 0;
+	_stripCacheSize = 0;
+}
+
+bool Gdi::canCacheStrip(const VirtScreen *vs, const byte *src) const {
+	if (_objectMode || vs->number != kMainVirtScreen || vs->format.bytesPerPixel != 1)
+		return false;
+	if ((_vm->_game.features & GF_16COLOR) || _vm->_game.heversion != 0)
+		return false;
+	// FM-TOWNS strips go through the Towns screen layers and palette remap
+	if (_vm->_game.platform == Common::kPlatformFMTowns)
+		return false;
+
+	// Only cache strips which overwrite every pixel of the destination.
+	// Transparent strips depend on whatever is already in the buffer.
+	switch (*src) {
+	case BMCOMP_RAW256:
+	case BMCOMP_ZIGZAG_V4:
+	case BMCOMP_ZIGZAG_V5:
+	case BMCOMP_ZIGZAG_V6:
+	case BMCOMP_ZIGZAG_V7:
+	case BMCOMP_ZIGZAG_V8:
+	case BMCOMP_ZIGZAG_H4:
+	case BMCOMP_ZIGZAG_H5:
+	case BMCOMP_ZIGZAG_H6:
+	case BMCOMP_ZIGZAG_H7:
+	case BMCOMP_ZIGZAG_H8:
+	case BMCOMP_MAJMIN_H4:
+	case BMCOMP_MAJMIN_H5:
+	case BMCOMP_MAJMIN_H6:
+	case BMCOMP_MAJMIN_H7:
+	case BMCOMP_MAJMIN_H8:
+	case BMCOMP_RMAJMIN_H4:
+	case BMCOMP_RMAJMIN_H5:
+	case BMCOMP_RMAJMIN_H6:
+	case BMCOMP_RMAJMIN_H7:
+	case BMCOMP_RMAJMIN_H8:
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool Gdi::validateStripCache(const byte *smap_ptr, int smapLen, int y, int height) {
+	// A new room image or a remapped palette invalidates every strip
+	if (smap_ptr != _stripCacheSmap || smapLen != _stripCacheSmapLen ||
+			memcmp(_stripCachePalette, _roomPalette, sizeof(_stripCachePalette))) {
+		clearStripCache();
+		_stripCacheSmap = smap_ptr;
+		_stripCacheSmapLen = smapLen;
+		_stripCacheY = y;
+		_stripCacheHeight = height;
+		memcpy(_stripCachePalette, _roomPalette, sizeof(_stripCachePalette));
+	}
+
+	// Partial redraws of a strip are rare; decode those directly
+	return y == _stripCacheY && height == _stripCacheHeight;
 }
 
 void GdiNES::roomChanged(byte *roomptr) {
@@ -2526,7 +2602,34 @@ bool Gdi::drawStrip(byte *dstPtr, VirtScreen *vs, int x, int y, const int width,
 		return result;
 	}
 
-	return decompressBitmap(dstPtr, vs->pitch, smap_ptr + offset, height);
+	if (stripnr < 0 || !canCacheStrip(vs, smap_ptr + offset) || !validateStripCache(smap_ptr, smapLen, y, height))
+		return decompressBitmap(dstPtr, vs->pitch, smap_ptr + offset, height);
+
+	// Scrolling rooms have more strips than the screen
+	if (stripnr >= (int)_stripCache.size())
+		_stripCache.resize(stripnr + 1);
+
+	const uint32 stripSize = 8 * height;
+	byte *cached = _stripCache[stripnr];
+	if (cached) {
+		for (int h = 0; h < height; h++, dstPtr += vs->pitch, cached += 8)
+			memcpy(dstPtr, cached, 8);
+		return false;
+	}
+
+	bool transpStrip = decompressBitmap(dstPtr, vs->pitch, smap_ptr + offset, height);
+
+	if (_stripCacheSize + stripSize <= kStripCacheMaxSize) {
+		cached = (byte *)malloc(stripSize);
+		if (cached) {
+			_stripCache[stripnr] = cached;
+			_stripCacheSize += stripSize;
+			for (int h = 0; h < height; h++, dstPtr += vs->pitch, cached += 8)
+				memcpy(cached, dstPtr, 8);
+		}
+	}
+
+	return transpStrip;
 }
 
 bool GdiNES::drawStrip(byte *dstPtr, VirtScreen *vs, int x, int y, const int width, const int height,
@@ -304,6 +304,19 @@ protected:
 	/** Flag which is true when an object is being rendered, false otherwise. */
 	bool _objectMode;
 
+	/**
+	 * Decoded copies of the room background strips, indexed by strip number.
+	 * Only opaque 8-bit strips of the main virtual screen are stored; the
+	 * cache is dropped whenever the room image, the strip band or the room
+	 * palette map changes.
+	 */
+	Common::Array<byte *> _stripCache;
+	const byte *_stripCacheSmap;
+	int _stripCacheSmapLen;
+	int _stripCacheY, _stripCacheHeight;
+	uint32 _stripCacheSize;
+	byte _stripCachePalette[256];
+
 public:
 	/** Flag which is true when loading objects or titles for distaff, in PCEngine version of Loom. */
 	bool _distaff;
@@ -336,6 +349,10 @@ protected:
 	void decompressMaskImgOr(byte *dst, const byte *src, int height) const;
 	void decompressMaskImg(byte *dst, const byte *src, int height) const;
 
+	/* Strip cache */
+	bool canCacheStrip(const VirtScreen *vs, const byte *src) const;
+	bool validateStripCache(const byte *smap_ptr, int smapLen, int y, int height);
+
 	/* Misc */
 	int getZPlanes(const byte *smap_ptr, const byte *zplane_list[9], bool bmapImage) const;
 
@@ -361,6 +378,7 @@ public:
 	virtual void init();
 	virtual void roomChanged(byte *roomptr);
 	virtual void loadTiles(byte *roomptr);
+	void clearStripCache();
 	void setTransparentColor(byte transparentColor) { _transparentColor = transparentColor; }
 
 	void drawBitmap(const byte *ptr, VirtScreen *vs, int x, int y, const int width, const int height,
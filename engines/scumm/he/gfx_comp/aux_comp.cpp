@@ -22,6 +22,7 @@
 #ifdef ENABLE_HE
 
 #include "common/system.h"
+#include "scumm/resource.h"
 #include "scumm/he/intern_he.h"
 #include "scumm/he/wiz_he.h"
 
@@ -503,6 +504,48 @@ void Wiz::auxDecompDRLEPrim(WizRawPixel *foregroundBufferPtr, WizRawPixel *backg
 	}
 }
 
+const byte *Wiz::auxSkipTRLELines(const byte *compData, int lineCount) {
+	// Short skips are cheaper to walk than to look up, and data
+	// which isn't an image resource can't be indexed safely...
+	if (lineCount < kTRLELineIndexMinSkip || !_trleLineIndexEnabled) {
+		while (lineCount-- > 0) {
+			compData += READ_LE_UINT16(compData) + 2;
+		}
+
+		return compData;
+	}
+
+	// The index is keyed by data pointers, which can be reused once
+	// the resource they belonged to has been freed; so throw everything
+	// away when that happens, or when we are tracking too many images...
+	uint32 nukeCounter = _vm->_res->getNukeCounter();
+
+	if (nukeCounter != _trleLineIndexNukeCounter || _trleLineIndex.size() >= kTRLELineIndexMaxImages) {
+		_trleLineIndex.clear();
+		_trleLineIndexNukeCounter = nukeCounter;
+	}
+
+	// Line offsets are filled in lazily, up to the furthest line asked for...
+	Common::Array<uint32> &lineOffsets = _trleLineIndex.getOrCreateVal(compData);
+
+	if (lineOffsets.empty()) {
+		lineOffsets.push_back(0);
+	}
+
+	if ((int)lineOffsets.size() <= lineCount) {
+		uint32 offset = lineOffsets.back();
+
+		lineOffsets.reserve(lineCount + 1);
+
+		for (int i = lineOffsets.size(); i <= lineCount; i++) {
+			offset += READ_LE_UINT16(compData + offset) + 2;
+			lineOffsets.push_back(offset);
+		}
+	}
+
+	return compData + lineOffsets[lineCount];
+}
+
 void Wiz::auxDecompTRLEImage(WizRawPixel *bufferPtr, const byte *compData, int bufferWidth, int bufferHeight, int x, int y, int width, int height, Common::Rect *clipRectPtr, const WizRawPixel *conversionTable) {
 	Common::Rect sourceRect, destRect, clipRect, workRect;
 
@@ -559,7 +602,7 @@ void Wiz::auxDecompTRLEImage(WizRawPixel *bufferPtr, const byte *compData, int b
 }
 
 void Wiz::auxDecompTRLEPrim(WizRawPixel *bufferPtr, int bufferWidth, Common::Rect *destRect, const byte *compData, Common::Rect *sourceRect, const WizRawPixel *conversionTable) {
-	int decompWidth, decompHeight, counter, sX1, dX1, lineSize;
+	int decompWidth, decompHeight, sX1, dX1, lineSize;
 	WizRawPixel8 *buffer8 = (WizRawPixel8 *)bufferPtr;
 	WizRawPixel16 *buffer16 = (WizRawPixel16 *)bufferPtr;
 
@@ -579,9 +622,7 @@ void Wiz::auxDecompTRLEPrim(WizRawPixel *bufferPtr, int bufferWidth, Common::Rec
 		bufferPtr = (WizRawPixel *)buffer16;
 	}
 
-	for (counter = sourceRect->top; counter > 0; counter--) {
-		compData += READ_LE_UINT16(compData) + 2;
-	}
+	compData = auxSkipTRLELines(compData, sourceRect->top);
 
 	// Decompress all the lines that are visible...
 	while (decompHeight-- > 0) {
@@ -666,7 +707,7 @@ void Wiz::auxDrawZplaneFromTRLEImage(byte *zplanePtr, const byte *compData, int
 }
 
 void Wiz::auxDrawZplaneFromTRLEPrim(byte *zplanePtr, int zplanePixelWidth, Common::Rect *destRect, const byte *compData, Common::Rect *sourceRect, int transOp, int solidOp) {
-	int decompWidth, decompHeight, counter, sX1, dX1, lineSize, mask, zplaneWidth;
+	int decompWidth, decompHeight, sX1, dX1, lineSize, mask, zplaneWidth;
 
 	// General setup...
 	sX1 = sourceRect->left;
@@ -680,9 +721,7 @@ void Wiz::auxDrawZplaneFromTRLEPrim(byte *zplanePtr, int zplanePixelWidth, Commo
 	zplanePtr += zplaneWidth * destRect->top + (dX1 / 8);
 	mask = 1 << (7 - (dX1 % 8));
 
-	for (counter = sourceRect->top; counter > 0; counter--) {
-		compData += READ_LE_UINT16(compData) + 2;
-	}
+	compData = auxSkipTRLELines(compData, sourceRect->top);
 
 	// Decompress all the lines that are visible...
 	while (decompHeight-- > 0) {
@@ -780,9 +819,7 @@ void Wiz::auxDecompRemappedTRLEPrim(WizRawPixel *bufferPtr, int bufferWidth, Com
 		bufferPtr = (WizRawPixel *)buffer16;
 	}
 
-	for (int i = sourceRect->top; i > 0; i--) {
-		compData += READ_LE_UINT16(compData) + 2;
-	}
+	compData = auxSkipTRLELines(compData, sourceRect->top);
 
 	// Decompress all the lines that are visible...
 	while (decompHeight-- > 0) {
@@ -865,9 +902,7 @@ int Wiz::auxHitTestTRLEImageRelPos(const byte *compData, int x, int y, int width
 	}
 
 	// Quickly skip down to the lines to be compressed & dest position...
-	for (int i = 0; i < y; i++) {
-		compData += READ_LE_UINT16(compData) + 2;
-	}
+	compData = auxSkipTRLELines(compData, y);
 
 	if (READ_LE_UINT16(compData) != 0) {
 		return auxHitTestTRLEXPos(compData + 2, x);
@@ -1022,9 +1057,7 @@ void Wiz::auxDecompMixColorsTRLEPrim(WizRawPixel *bufferPtr, int bufferWidth, Co
 		bufferPtr = (WizRawPixel *)buffer16;
 	}
 
-	for (int i = sourceRect->top; i > 0; i--) {
-		compData += READ_LE_UINT16(compData) + 2;
-	}
+	compData = auxSkipTRLELines(compData, sourceRect->top);
 
 	// Decompress all the lines that are visible...
 	while (decompHeight-- > 0) {
@@ -274,7 +274,7 @@ void Wiz::trleFLIPDecompImageHull(
 	void (*functionPtr)(Wiz *wiz,
 		WizRawPixel *destPtr, const byte *dataStream, int skipAmount,
 		int decompAmount, const byte *extraPtr, const WizRawPixel *conversionTable)) {
-	int decompWidth, decompHeight, counter, sX1, lineSize;
+	int decompWidth, decompHeight, sX1, lineSize;
 
 	// General setup...
 	sX1 = sourceRect->left;
@@ -293,9 +293,7 @@ void Wiz::trleFLIPDecompImageHull(
 		bufferPtr = (WizRawPixel *)buf8;
 	}
 
-	for (counter = sourceRect->top; counter > 0; counter--) {
-		compData += READ_LE_UINT16(compData) + 2;
-	}
+	compData = auxSkipTRLELines(compData, sourceRect->top);
 
 	// Flip the dest offset if vertical flipping...
 	if (destRect->top > destRect->bottom) {
@@ -1245,7 +1243,7 @@ void Wiz::trleFLIP90DegreeRotateCore(WizSimpleBitmap *dstBitmap, int x, int y, c
 		const WizRawPixel *conversionTable)) {
 
 	Common::Rect dstRect, srcRect, clipRect, clippedDstRect, clippedSrcRect;
-	int dstOffset, dstStep, w, h, srcOffset, dstX, dstY, skipAmount, c;
+	int dstOffset, dstStep, w, h, srcOffset, dstX, dstY, skipAmount;
 	WizRawPixel *dstPtr;
 	const byte *compData;
 
@@ -1318,9 +1316,7 @@ void Wiz::trleFLIP90DegreeRotateCore(WizSimpleBitmap *dstBitmap, int x, int y, c
 	skipAmount = clippedSrcRect.left;
 	compData = imagePtr->data;
 
-	for (c = clippedSrcRect.top; --c >= 0;) {
-		compData += READ_LE_UINT16(compData) + 2;
-	}
+	compData = auxSkipTRLELines(compData, clippedSrcRect.top);
 
 	// Transfer the src line to the dest line using the passed transfer prim.
 	while (--h >= 0) {
@@ -2003,7 +1999,7 @@ void Wiz::trleFLIPAltSourceDecompImageHull(
 	void (*functionPtr)(Wiz *wiz,
 		WizRawPixel *destPtr, const void *altSourcePtr, const byte *dataStream,
 		int skipAmount, int decompAmount, const WizRawPixel *conversionTable)) {
-	int decompWidth, decompHeight, counter, sX1, lineSize;
+	int decompWidth, decompHeight, sX1, lineSize;
 
 	// General setup...
 	sX1 = sourceRect->left;
@@ -2023,9 +2019,7 @@ void Wiz::trleFLIPAltSourceDecompImageHull(
 		bufferPtr = (WizRawPixel *)buf8;
 	}
 
-	for (counter = sourceRect->top; counter > 0; counter--) {
-		compData += READ_LE_UINT16(compData) + 2;
-	}
+	compData = auxSkipTRLELines(compData, sourceRect->top);
 
 	// Calc the ALT buffer location...
 	altSourceBuffer += (altBytesPerLine * altRect->top) + (altRect->left * altBytesPerPixel);
@@ -1987,7 +1987,13 @@ int Wiz::getRawPixel(int color) {
 
 void Wiz::memset8BppConversion(void *dstPtr, int value, size_t count, const WizRawPixel *conversionTable) {
 	if (_uses16BitColor) {
-		rawPixelMemset((WizRawPixel16 *)dstPtr, (int)convert8BppToRawPixel((WizRawPixel16)value, conversionTable), count);
+		const WizRawPixel16 *conversionTable16 = (const WizRawPixel16 *)conversionTable;
+		WizRawPixel16 *dstWritePtr = (WizRawPixel16 *)dstPtr;
+		WizRawPixel16 color = FROM_LE_16(conversionTable16[(byte)value]);
+
+		while (count-- > 0) {
+			WRITE_UINT16(dstWritePtr++, color);
+		}
 	} else {
 		memset((WizRawPixel8 *)dstPtr, value, count);
 	}
@@ -1995,11 +2001,14 @@ void Wiz::memset8BppConversion(void *dstPtr, int value, size_t count, const WizR
 
 void Wiz::memcpy8BppConversion(void *dstPtr, const void *srcPtr, size_t count, const WizRawPixel *conversionTable) {
 	if (_uses16BitColor) {
+		// Look the colors up directly, instead of checking the color
+		// depth again for every pixel in convert8BppToRawPixel()...
+		const WizRawPixel16 *conversionTable16 = (const WizRawPixel16 *)conversionTable;
 		WizRawPixel16 *dstWritePtr = (WizRawPixel16 *)(dstPtr);
 		const byte *srcReadPtr = (const byte *)(srcPtr);
 		int counter = count;
 		while (0 <= --counter) {
-			*dstWritePtr++ = convert8BppToRawPixel((WizRawPixel16)(*srcReadPtr++), conversionTable);
+			*dstWritePtr++ = FROM_LE_16(conversionTable16[*srcReadPtr++]);
 		}
 	} else {
 		memcpy((WizRawPixel8 *)dstPtr, (const byte *)srcPtr, count);
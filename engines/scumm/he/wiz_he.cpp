@@ -364,6 +364,8 @@ WizPxShrdBuffer Wiz::drawAWizPrimEx(int globNum, int state, int x, int y, int z,
 			pgDrawImageWith16BitZBuffer(&sbDst, &sbZBuffer, srcData + _vm->_resourceHeaderSize, x, y, z, srcWidth, srcHeight, &clipRect);
 		}
 	} else if (srcComp == kWCTTRLE) {
+		_trleLineIndexEnabled = true;
+
 		if (flags & kWRFZPlaneOn) {
 			if (_vm->_game.heversion > 95 && _vm->_gdi->_numZBuffer <= 1) {
 				error("Wiz::drawAWizPrimEx(): No zplane %d (limit 0 to %d)", 1, (_vm->_gdi->_numZBuffer - 1));
@@ -409,6 +411,7 @@ WizPxShrdBuffer Wiz::drawAWizPrimEx(int globNum, int state, int x, int y, int z,
 				optionalICmdPtr);
 		}
 
+		_trleLineIndexEnabled = false;
 	} else {
 		int transColorOverride;
 		const byte *dataPtr = nullptr;
@@ -725,7 +728,11 @@ int Wiz::hitTestWizPrim(int globNum, int state, int x, int y, int32 flags) {
 
 		srcData = _vm->findResourceData(MKTAG('W', 'I', 'Z', 'D'), dataTmp);
 
-		return auxHitTestTRLEImageRelPos(srcData + _vm->_resourceHeaderSize, x, y, srcWidth, srcHeight);
+		_trleLineIndexEnabled = true;
+		outValue = auxHitTestTRLEImageRelPos(srcData + _vm->_resourceHeaderSize, x, y, srcWidth, srcHeight);
+		_trleLineIndexEnabled = false;
+
+		return outValue;
 	}
 
 	if (_vm->_game.heversion > 98) {
@@ -757,7 +764,11 @@ int Wiz::hitTestWizPrim(int globNum, int state, int x, int y, int32 flags) {
 	if (srcComp == kWCTTRLE) {
 		srcData = getWizStateDataPrim(globNum, state);
 
-		return auxHitTestTRLEImageRelPos(srcData + _vm->_resourceHeaderSize, x, y, srcWidth, srcHeight);
+		_trleLineIndexEnabled = true;
+		outValue = auxHitTestTRLEImageRelPos(srcData + _vm->_resourceHeaderSize, x, y, srcWidth, srcHeight);
+		_trleLineIndexEnabled = false;
+
+		return outValue;
 	} else if (_vm->_game.heversion > 98 && isUncompressedFormatTypeID(srcComp)) {
 		WizSimpleBitmap srcBitmap;
 
@@ -1682,12 +1693,14 @@ void Wiz::dwAltSourceDrawWiz(int maskImage, int maskState, int x, int y, int sou
 
 	// Finally call the primitive...
 	if (maskCompressionType == kWCTTRLE) {
+		_trleLineIndexEnabled = true;
 		trleFLIPAltSourceDecompressImage(
 			destBitmapPtr->bufferPtr(), maskDataPtr,
 			destBitmapPtr->bitmapWidth, destBitmapPtr->bitmapHeight,
 			sourceBufferPtr, srcBitmapWidth, srcBitmapHeight, srcBitsPerPixel,
 			x, y, maskWidth, maskHeight, &clipRect, flags, conversionTable,
 			nullptr);
+		_trleLineIndexEnabled = false;
 
 	} else if (maskCompressionType == kWCTMRLEWithLineSizePrefix) {
 		mrleFLIPAltSourceDecompressImage(
@@ -1933,10 +1946,12 @@ void Wiz::handleRotate90SpecialCase(int image, int state, int x, int y, int shad
 			}
 		}
 
+		_trleLineIndexEnabled = true;
 		trleFLIPRotate90DecompressImage(
 			dest_p(), compressedDataPtr, dest_w, dest_h, x, y, src_w, src_h,
 			clipRect, flags, nullptr, optionalColorConversionTable,
 			nullptr);
+		_trleLineIndexEnabled = false;
 
 		// Update the screen? (If not writing to another bitmap...)
 		if (!optionalBitmapOverride) {
@@ -2828,6 +2843,9 @@ bool Wiz::collisionCompareImageLines(
 	// Get line A's data...
 	rawPixelMemset(_compareBufferA, transparentColor, compareWidth);
 
+	// Both images come straight from their resources...
+	_trleLineIndexEnabled = true;
+
 	if (aType == kWCTTRLE) {
 		trleFLIPDecompressImage(
 			_compareBufferA, imageAData, compareWidth, 1,
@@ -2857,6 +2875,8 @@ bool Wiz::collisionCompareImageLines(
 			transparentColor);
 	}
 
+	_trleLineIndexEnabled = false;
+
 	// Finally compare the lines...
 	if (compareDoPixelStreamsOverlap(_compareBufferA, _compareBufferB, compareWidth, transparentColor)) {
 		return true;
@@ -24,6 +24,9 @@
 
 //#define WIZ_DEBUG_BUFFERS
 
+#include "common/array.h"
+#include "common/hashmap.h"
+#include "common/hash-ptr.h"
 #include "common/rect.h"
 
 namespace Scumm {
@@ -816,6 +819,20 @@ public:
 private:
 	ScummEngine_v71he *_vm;
 
+	// TRLE line offset index, keyed by the start of the compressed data;
+	// it is dropped whenever the resource manager frees anything. Only
+	// image resources are indexed: the callers which draw straight from
+	// one set _trleLineIndexEnabled, since temporary buffers (fonts, warp
+	// letters, converted images...) may reuse an address for other data.
+	enum {
+		kTRLELineIndexMinSkip = 16,
+		kTRLELineIndexMaxImages = 512
+	};
+
+	Common::HashMap<const byte *, Common::Array<uint32> > _trleLineIndex;
+	uint32 _trleLineIndexNukeCounter = 0;
+	bool _trleLineIndexEnabled = false;
+
 
 public:
 	/* Drawing Primitives
@@ -927,6 +944,7 @@ public:
 	void auxWRLEUncompressPixelStream(WizRawPixel *destStream, const byte *singleColorTable, const byte *streamData, int streamSize, const WizRawPixel *conversionTable);
 	void auxWRLEUncompressAndCopyFromStreamOffset(WizRawPixel *destStream, const byte *singleColorTable, const byte *streamData, int streamSize, byte copyFromColor, int streamOffset, const WizRawPixel *conversionTable);
 
+	const byte *auxSkipTRLELines(const byte *compData, int lineCount);
 	void auxDecompSRLEStream(WizRawPixel *destStream, const WizRawPixel *backgroundStream, const byte *singleColorTable, const byte *streamData, int streamSize, const WizRawPixel *conversionTable);
 
 	void auxDecompDRLEStream(WizRawPixel *destPtr, const byte *dataStream, WizRawPixel *backgroundPtr, int skipAmount, int decompAmount, const WizRawPixel *conversionTable);
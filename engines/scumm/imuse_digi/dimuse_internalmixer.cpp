@@ -21,6 +21,7 @@
 
 #include "common/scummsys.h"
 #include "common/mutex.h"
+#include "common/system.h"
 #include "common/serializer.h"
 #include "common/textconsole.h"
 #include "common/util.h"
@@ -49,6 +50,7 @@ IMuseDigiInternalMixer::IMuseDigiInternalMixer(Audio::Mixer *mixer, int sampleRa
 
 	_radioChatter = 0;
 	_amp8Table = nullptr;
+	_kernels = IMuseDigiMixKernels::getKernels();
 }
 
 IMuseDigiInternalMixer::~IMuseDigiInternalMixer() {
@@ -56,6 +58,14 @@ IMuseDigiInternalMixer::~IMuseDigiInternalMixer() {
 	_amp8Table = nullptr;
 }
 
+const IMuseDigiMixKernels *IMuseDigiMixKernels::getKernels() {
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+		return &g_imuseDigiMixKernelsSSE2;
+#endif
+	return nullptr;
+}
+
 // Lookup table for a linear volume ramp (0 to 16) accounting for panning (-8 to 8)
 static const int8 _stereoVolumeTable[284] = {
 	0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,
@@ -393,6 +403,8 @@ void IMuseDigiInternalMixer::mixBits8Mono(uint8 *srcBuf, int32 inFrameCount, int
 
 			mixBufCurCell[0] += *((uint16 *)ampTable + srcBuf_ptr[0]);
 			mixBufCurCell[1] += *((uint16 *)ampTable + srcBuf_ptr[0]);
+		} else if (_kernels) {
+			_kernels->mixBits8(mixBufCurCell, srcBuf_ptr, inFrameCount, getAmp8Scale(ampTable));
 		} else {
 			if (inFrameCount) {
 				for (int i = 0; i < inFrameCount; i++) {
@@ -411,6 +423,8 @@ void IMuseDigiInternalMixer::mixBits8Mono(uint8 *srcBuf, int32 inFrameCount, int
 						value += ptr[i] - srcBuf_ptr[i];
 					}
 				}
+			} else if (_kernels) {
+				_kernels->mixBits8(mixBufCurCell, srcBuf_ptr, feedSize, getAmp8Scale(ampTable));
 			} else {
 				if (feedSize) {
 					for (int i = 0; i < feedSize; i++) {
@@ -538,7 +552,9 @@ void IMuseDigiInternalMixer::mixBits16Mono(uint8 *srcBuf, int32 inFrameCount, in
 	int residualLength;
 
 	mixBufCurCell = (uint16 *)(&_mixBuf[2 * mixBufStartIndex]);
-	if (feedSize == inFrameCount) {
+	if (feedSize == inFrameCount && _kernels) {
+		_kernels->mixBits16(mixBufCurCell, (const int16 *)srcBuf, feedSize, getAmp12Scale(ampTable));
+	} else if (feedSize == inFrameCount) {
 		if (feedSize) {
 			srcBuf_ptr = (uint16 *)srcBuf;
 			for (int i = 0; i < feedSize; i++) {
@@ -781,6 +797,8 @@ void IMuseDigiInternalMixer::mixBits8ConvertToStereo(uint8 *srcBuf, int32 inFram
 			mixBufCurCell[1] += *((uint16 *)rightAmpTable + srcBuf_ptr[i]);
 			mixBufCurCell[2] += *((uint16 *)leftAmpTable  + srcBuf_ptr[i]);
 			mixBufCurCell[3] += *((uint16 *)rightAmpTable + srcBuf_ptr[i]);
+		} else if (_kernels) {
+			_kernels->mixBits8ToStereo(mixBufCurCell, srcBuf, inFrameCount, getAmp8Scale(leftAmpTable), getAmp8Scale(rightAmpTable));
 		} else {
 			srcBuf_ptr = srcBuf;
 			if (inFrameCount) {
@@ -805,6 +823,8 @@ void IMuseDigiInternalMixer::mixBits8ConvertToStereo(uint8 *srcBuf, int32 inFram
 						mixBufCurCell += 2;
 					}
 				}
+			} else if (_kernels) {
+				_kernels->mixBits8ToStereo(mixBufCurCell, srcBuf, feedSize, getAmp8Scale(leftAmpTable), getAmp8Scale(rightAmpTable));
 			} else {
 				if (feedSize) {
 					srcBuf_ptr = srcBuf;
@@ -1039,7 +1059,9 @@ void IMuseDigiInternalMixer::mixBits16ConvertToStereo(uint8 *srcBuf, int32 inFra
 
 	mixBufCurCell = (uint16 *)(&_mixBuf[2 * mixBufStartIndex]);
 
-	if (feedSize == inFrameCount) {
+	if (feedSize == inFrameCount && _kernels) {
+		_kernels->mixBits16ToStereo(mixBufCurCell, (const int16 *)srcBuf, feedSize, getAmp12Scale(leftAmpTable), getAmp12Scale(rightAmpTable));
+	} else if (feedSize == inFrameCount) {
 		if (feedSize) {
 			srcBuf_tmp = (uint16 *)srcBuf;
 			for (int i = 0; i < feedSize; i++) {
@@ -1127,7 +1149,10 @@ void IMuseDigiInternalMixer::mixBits8Stereo(uint8 *srcBuf, int32 inFrameCount, i
 	int residualLength;
 
 	mixBufCurCell = (uint16 *)(&_mixBuf[4 * mixBufStartIndex]);
-	if (feedSize == inFrameCount) {
+	if (feedSize == inFrameCount && _kernels) {
+		// Both channels use the same table, so mix them as one mono run
+		_kernels->mixBits8(mixBufCurCell, srcBuf, 2 * feedSize, getAmp8Scale(ampTable));
+	} else if (feedSize == inFrameCount) {
 		if (feedSize) {
 			srcBuf_ptr = srcBuf;
 			for (int i = 0; i < feedSize; i++) {
@@ -1304,7 +1329,10 @@ void IMuseDigiInternalMixer::mixBits16Stereo(uint8 *srcBuf, int32 inFrameCount,
 	int residualLength;
 
 	mixBufCurCell = (uint16 *)(&_mixBuf[4 * mixBufStartIndex]);
-	if (feedSize == inFrameCount) {
+	if (feedSize == inFrameCount && _kernels) {
+		// Both channels use the same table, so mix them as one mono run
+		_kernels->mixBits16(mixBufCurCell, (const int16 *)srcBuf, 2 * feedSize, getAmp12Scale(ampTable));
+	} else if (feedSize == inFrameCount) {
 		if (feedSize) {
 			srcBuf_ptr = (uint16 *)srcBuf;
 
@@ -29,6 +29,7 @@
 #include "common/util.h"
 
 #include "scumm/imuse_digi/dimuse_engine.h"
+#include "scumm/imuse_digi/dimuse_mixkernels.h"
 #include "scumm/music.h"
 #include "scumm/sound.h"
 #include "audio/mixer.h"
@@ -52,6 +53,9 @@ private:
 
 	uint8 *_mixBuf = nullptr;
 
+	// Vectorized same-rate mixing paths, nullptr if the CPU has none
+	const IMuseDigiMixKernels *_kernels = nullptr;
+
 	Audio::Mixer *_mixer;
 	Audio::SoundHandle _channelHandle;
 	int _mixBufSize = 0;
@@ -63,6 +67,9 @@ private:
 	bool _isEarlyDiMUSE = false;
 	bool _lowLatencyMode = false;
 
+	int getAmp8Scale(const int32 *ampTable) const { return IMuseDigiMixKernels::getAmpScale((ampTable - _amp8Table) / 128); }
+	int getAmp12Scale(const int32 *ampTable) const { return IMuseDigiMixKernels::getAmpScale((ampTable - _amp12Table) / 2048); }
+
 	void mixBits8Mono(uint8 *srcBuf, int32 inFrameCount, int feedSize, int32 mixBufStartIndex, int32 *ampTable, bool ftIs11025Hz);
 	void mixBits12Mono(uint8 *srcBuf, int32 inFrameCount, int feedSize, int32 mixBufStartIndex, int32 *ampTable);
 	void mixBits16Mono(uint8 *srcBuf, int32 inFrameCount, int feedSize, int32 mixBufStartIndex, int32 *ampTable);
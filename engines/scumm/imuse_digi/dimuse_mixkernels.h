@@ -0,0 +1,62 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#if !defined(SCUMM_IMUSE_DIGI_MIXKERNELS_H) && defined(ENABLE_SCUMM_7_8)
+#define SCUMM_IMUSE_DIGI_MIXKERNELS_H
+
+#include "common/scummsys.h"
+
+namespace Scumm {
+
+/**
+ * Vectorized versions of the same-rate paths of IMuseDigiInternalMixer.
+ *
+ * Instead of looking every sample up in the amplitude tables, the kernels
+ * compute the table entries directly: row 'volume' of both tables holds
+ * (sample * scale) / 127, with scale as returned by getAmpScale() and the
+ * sample centered around zero (and multiplied by 16 for 8-bit audio).
+ * The results are identical to the table lookups.
+ */
+struct IMuseDigiMixKernels {
+	/** Add 'count' 8-bit unsigned samples to 'dst'. */
+	void (*mixBits8)(uint16 *dst, const uint8 *src, int count, int scale);
+	/** Add 'count' 16-bit signed samples to 'dst'. */
+	void (*mixBits16)(uint16 *dst, const int16 *src, int count, int scale);
+	/** Add 'count' 8-bit mono samples to the interleaved stereo buffer 'dst'. */
+	void (*mixBits8ToStereo)(uint16 *dst, const uint8 *src, int count, int leftScale, int rightScale);
+	/** Add 'count' 16-bit mono samples to the interleaved stereo buffer 'dst'. */
+	void (*mixBits16ToStereo)(uint16 *dst, const int16 *src, int count, int leftScale, int rightScale);
+
+	/** Returns the scale used by row 'volume' (0-16) of the amplitude tables. */
+	static int getAmpScale(int volume) { return volume ? volume * 8 - 1 : 0; }
+
+	/** Returns the kernels supported by the CPU, or nullptr if there are none. */
+	static const IMuseDigiMixKernels *getKernels();
+};
+
+#ifdef SCUMMVM_SSE2
+extern const IMuseDigiMixKernels g_imuseDigiMixKernelsSSE2;
+#endif
+
+} // End of namespace Scumm
+
+#endif
@@ -0,0 +1,148 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/scummsys.h"
+
+#include "scumm/imuse_digi/dimuse_mixkernels.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Scumm {
+
+// The products never exceed 2048 * 127 in magnitude, so they are exact as
+// floats, and their quotients by 127 are either exact or at least 1/127
+// away from the next integer: truncating the float quotient gives the same
+// result as the integer division used to build the tables.
+static inline __m128i scaleSamples(__m128i x, __m128i scale) {
+	const __m128 divisor = _mm_set1_ps(127.0f);
+
+	__m128i lo = _mm_mullo_epi16(x, scale);
+	__m128i hi = _mm_mulhi_epi16(x, scale);
+	__m128i q0 = _mm_cvttps_epi32(_mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, hi)), divisor));
+	__m128i q1 = _mm_cvttps_epi32(_mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, hi)), divisor));
+	return _mm_packs_epi32(q0, q1);
+}
+
+static inline __m128i load8BitSamples(const uint8 *src) {
+	__m128i x = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)src), _mm_setzero_si128());
+	return _mm_slli_epi16(_mm_sub_epi16(x, _mm_set1_epi16(128)), 4);
+}
+
+static inline __m128i load16BitSamples(const int16 *src) {
+	return _mm_srai_epi16(_mm_loadu_si128((const __m128i *)src), 4);
+}
+
+static inline void addSamples(uint16 *dst, __m128i v) {
+	_mm_storeu_si128((__m128i *)dst, _mm_add_epi16(_mm_loadu_si128((const __m128i *)dst), v));
+}
+
+static void mixBits8SSE2(uint16 *dst, const uint8 *src, int count, int scale) {
+	const __m128i vScale = _mm_set1_epi16(scale);
+	int i = 0;
+
+	for (; i + 8 <= count; i += 8)
+		addSamples(dst + i, scaleSamples(load8BitSamples(src + i), vScale));
+
+	for (; i < count; i++)
+		dst[i] += (int16)((16 * (src[i] - 128) * scale) / 127);
+}
+
+static void mixBits16SSE2(uint16 *dst, const int16 *src, int count, int scale) {
+	const __m128i vScale = _mm_set1_epi16(scale);
+	int i = 0;
+
+	for (; i + 8 <= count; i += 8)
+		addSamples(dst + i, scaleSamples(load16BitSamples(src + i), vScale));
+
+	for (; i < count; i++)
+		dst[i] += (int16)(((src[i] >> 4) * scale) / 127);
+}
+
+static void mixBits8ToStereoSSE2(uint16 *dst, const uint8 *src, int count, int leftScale, int rightScale) {
+	const __m128i vLeftScale = _mm_set1_epi16(leftScale);
+	const __m128i vRightScale = _mm_set1_epi16(rightScale);
+	int i = 0;
+
+	for (; i + 8 <= count; i += 8) {
+		__m128i x = load8BitSamples(src + i);
+		__m128i left = scaleSamples(x, vLeftScale);
+		__m128i right = scaleSamples(x, vRightScale);
+		addSamples(dst + 2 * i, _mm_unpacklo_epi16(left, right));
+		addSamples(dst + 2 * i + 8, _mm_unpackhi_epi16(left, right));
+	}
+
+	for (; i < count; i++) {
+		int x = 16 * (src[i] - 128);
+		dst[2 * i] += (int16)((x * leftScale) / 127);
+		dst[2 * i + 1] += (int16)((x * rightScale) / 127);
+	}
+}
+
+static void mixBits16ToStereoSSE2(uint16 *dst, const int16 *src, int count, int leftScale, int rightScale) {
+	const __m128i vLeftScale = _mm_set1_epi16(leftScale);
+	const __m128i vRightScale = _mm_set1_epi16(rightScale);
+	int i = 0;
+
+	for (; i + 8 <= count; i += 8) {
+		__m128i x = load16BitSamples(src + i);
+		__m128i left = scaleSamples(x, vLeftScale);
+		__m128i right = scaleSamples(x, vRightScale);
+		addSamples(dst + 2 * i, _mm_unpacklo_epi16(left, right));
+		addSamples(dst + 2 * i + 8, _mm_unpackhi_epi16(left, right));
+	}
+
+	for (; i < count; i++) {
+		int x = src[i] >> 4;
+		dst[2 * i] += (int16)((x * leftScale) / 127);
+		dst[2 * i + 1] += (int16)((x * rightScale) / 127);
+	}
+}
+
+const IMuseDigiMixKernels g_imuseDigiMixKernelsSSE2 = {
+	mixBits8SSE2,
+	mixBits16SSE2,
+	mixBits8ToStereoSSE2,
+	mixBits16ToStereoSSE2
+};
+
+} // End of namespace Scumm
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
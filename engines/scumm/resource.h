@@ -180,6 +180,7 @@ protected:
 	uint32 _allocatedSize;
 	uint32 _maxHeapThreshold, _minHeapThreshold;
 	byte _expireCounter;
+	uint32 _nukeCounter;
 
 public:
 	ResourceManager(ScummEngine *vm);
@@ -188,6 +189,13 @@ public:
 	void setHeapThreshold(int min, int max);
 	uint32 getHeapSize() { return _allocatedSize; }
 
+	/**
+	 * Returns a counter which is bumped every time a resource is freed.
+	 * Caches keyed by resource data pointers compare it to find out
+	 * whether a pointer they remember may have been reused.
+	 */
+	uint32 getNukeCounter() const { return _nukeCounter; }
+
 	void allocResTypeData(ResType type, uint32 tag, int num, ResTypeMode mode);
 	void freeResources();
 
@@ -21,6 +21,8 @@
 
 #include "common/config-manager.h"
 #include "common/file.h"
+#include "common/jobsystem.h"
+#include "common/memstream.h"
 #include "common/system.h"
 #include "common/util.h"
 #include "common/rect.h"
@@ -236,6 +238,8 @@ SmushPlayer::SmushPlayer(ScummEngine_v7 *scumm, IMuseDigital *imuseDigital, Insa
 	_specialBuffer = nullptr;
 
 	_seekPos = -1;
+	_undecodedDeltaChunks = 0;
+	_predecodedFrame = nullptr;
 
 	_skipNext = false;
 	_dst = nullptr;
@@ -320,6 +324,8 @@ void SmushPlayer::release() {
 	delete _strings;
 	_strings = nullptr;
 
+	clearPrefetchedChunks();
+
 	delete _base;
 	_base = nullptr;
 
@@ -751,10 +757,37 @@ byte *SmushPlayer::getVideoPalette() {
 	return _pal;
 }
 
+struct SmushFrameDecode {
+	Common::JobGroup job;
+	SmushDeltaBlocksDecoder *blocksCodec;
+	SmushDeltaGlyphsDecoder *glyphsCodec;
+	const byte *src;
+	byte *pixels;
+	int codec, left, top, width, height;
+};
+
+static void decodeFrameJob(void *param) {
+	SmushFrameDecode *frame = (SmushFrameDecode *)param;
+
+	if (frame->codec == SMUSH_CODEC_DELTA_BLOCKS)
+		frame->blocksCodec->decode(frame->pixels, frame->src);
+	else
+		frame->glyphsCodec->decode(frame->pixels, frame->src);
+}
+
+static void freeFrameDecode(SmushFrameDecode *frame) {
+	if (!frame)
+		return;
+
+	frame->job.wait();
+	free(frame->pixels);
+	delete frame;
+}
+
 void smushDecodeRLE(byte *dst, const byte *src, int left, int top, int width, int height, int pitch);
 void smushDecodeUncompressed(byte *dst, const byte *src, int left, int top, int width, int height, int pitch);
 
-void SmushPlayer::decodeFrameObject(int codec, const uint8 *src, int left, int top, int width, int height) {
+void SmushPlayer::decodeFrameObject(int codec, const uint8 *src, int left, int top, int width, int height, bool predecoded) {
 	if ((height == 242) && (width == 384)) {
 		if (_specialBuffer == 0)
 			_specialBuffer = (byte *)malloc(242 * 384);
@@ -781,12 +814,20 @@ void SmushPlayer::decodeFrameObject(int codec, const uint8 *src, int left, int t
 		smushDecodeRLE(_dst, src, left, top, width, height, _vm->_screenWidth);
 		break;
 	case SMUSH_CODEC_DELTA_BLOCKS:
+		if (predecoded) {
+			memcpy(_dst, src, width * height);
+			break;
+		}
 		if (!_deltaBlocksCodec)
 			_deltaBlocksCodec = new SmushDeltaBlocksDecoder(width, height);
 		if (_deltaBlocksCodec)
 			_deltaBlocksCodec->decode(_dst, src);
 		break;
 	case SMUSH_CODEC_DELTA_GLYPHS:
+		if (predecoded) {
+			memcpy(_dst, src, width * height);
+			break;
+		}
 		if (!_deltaGlyphsCodec)
 			_deltaGlyphsCodec = new SmushDeltaGlyphsDecoder(width, height);
 		if (_deltaGlyphsCodec)
@@ -838,6 +879,16 @@ void SmushPlayer::handleZlibFrameObject(int32 subSize, Common::SeekableReadStrea
 	free(fobjBuffer);
 }
 
+bool SmushPlayer::usePredecodedFrame() {
+	if (!_predecodedFrame)
+		return false;
+
+	SmushFrameDecode *frame = _predecodedFrame;
+	_predecodedFrame = nullptr;
+	decodeFrameObject(frame->codec, frame->pixels, frame->left, frame->top, frame->width, frame->height, true);
+	return true;
+}
+
 void SmushPlayer::handleFrameObject(int32 subSize, Common::SeekableReadStream &b) {
 	assert(subSize >= 14);
 	if (_skipNext) {
@@ -845,6 +896,9 @@ void SmushPlayer::handleFrameObject(int32 subSize, Common::SeekableReadStream &b
 		return;
 	}
 
+	if (usePredecodedFrame())
+		return;
+
 	int codec = b.readUint16LE();
 	int left = b.readUint16LE();
 	int top = b.readUint16LE();
@@ -1026,6 +1080,9 @@ SmushFont *SmushPlayer::getFont(int font) {
 void SmushPlayer::parseNextFrame() {
 
 	if (_seekPos >= 0) {
+		// Anything read ahead belongs to the old position
+		clearPrefetchedChunks();
+
 		if (_seekFile.size() > 0) {
 			delete _base;
 
@@ -1069,35 +1126,181 @@ void SmushPlayer::parseNextFrame() {
 
 	assert(_base);
 
-	const uint32 subType = _base->readUint32BE();
-	const int32 subSize = _base->readUint32BE();
-	const int32 subOffset = _base->pos();
+	if (!_prefetchedChunks.empty()) {
+		SmushPrefetchedChunk chunk = _prefetchedChunks.pop();
+		Common::MemoryReadStream b(chunk.data, chunk.size, DisposeAfterUse::YES);
 
-	if (_base->pos() >= (int32)_baseSize) {
-		_vm->_smushVideoShouldFinish = true;
-		_endOfFile = true;
-		return;
+		if (chunk.needsDeltaCodec)
+			_undecodedDeltaChunks--;
+		if (chunk.decode)
+			chunk.decode->job.wait();
+
+		debug(3, "Chunk: %s (prefetched)", tag2str(chunk.type));
+		_predecodedFrame = chunk.decode;
+		parseChunk(chunk.type, chunk.size, b);
+		_predecodedFrame = nullptr;
+
+		freeFrameDecode(chunk.decode);
+	} else {
+		const uint32 subType = _base->readUint32BE();
+		const int32 subSize = _base->readUint32BE();
+		const int32 subOffset = _base->pos();
+
+		if (_base->pos() >= (int32)_baseSize) {
+			_vm->_smushVideoShouldFinish = true;
+			_endOfFile = true;
+			return;
+		}
+
+		debug(3, "Chunk: %s at %x", tag2str(subType), subOffset);
+
+		parseChunk(subType, subSize, *_base);
+
+		_base->seek(subOffset + subSize, SEEK_SET);
 	}
 
-	debug(3, "Chunk: %s at %x", tag2str(subType), subOffset);
+	if (_insanity)
+		_vm->_sound->processSound();
+
+	_vm->_imuseDigital->flushTracks();
+}
 
+void SmushPlayer::parseChunk(uint32 subType, int32 subSize, Common::SeekableReadStream &b) {
 	switch (subType) {
 	case MKTAG('A','H','D','R'): // FT INSANE may seek file to the beginning
-		handleAnimHeader(subSize, *_base);
+		handleAnimHeader(subSize, b);
 		break;
 	case MKTAG('F','R','M','E'):
-		handleFrame(subSize, *_base);
+		handleFrame(subSize, b);
 		break;
 	default:
-		error("Unknown Chunk found at %x: %s, %d", subOffset, tag2str(subType), subSize);
+		error("Unknown Chunk found: %s, %d", tag2str(subType), subSize);
 	}
+}
 
-	_base->seek(subOffset + subSize, SEEK_SET);
+void SmushPlayer::scheduleFrameDecode(SmushPrefetchedChunk &chunk) {
+	// Only frames with a single full screen codec37/47 object are decoded
+	// ahead. The image only depends on the state of the codec, so it can
+	// be computed while this thread waits for the frame time; text,
+	// palettes, STOR/FTCH and audio are still handled when the frame is due.
+	const byte *fobj = nullptr;
+	int objects = 0;
+	bool usesDeltaCodec = false;
+
+	const byte *ptr = chunk.data;
+	const byte *end = chunk.data + chunk.size;
+	while (end - ptr >= 8) {
+		const uint32 subType = READ_BE_UINT32(ptr);
+		const uint32 subSize = READ_BE_UINT32(ptr + 4);
+		ptr += 8;
+		if (subSize > (uint32)(end - ptr))
+			break;
 
-	if (_insanity)
-		_vm->_sound->processSound();
+		if (subType == MKTAG('F','O','B','J') && subSize >= 14) {
+			const int codec = READ_LE_UINT16(ptr);
+			if (codec == SMUSH_CODEC_DELTA_BLOCKS || codec == SMUSH_CODEC_DELTA_GLYPHS) {
+				usesDeltaCodec = true;
+				fobj = ptr;
+			}
+			objects++;
+		} else if (subType == MKTAG('Z','F','O','B')) {
+			// The codec is only known after inflating the object
+			usesDeltaCodec = true;
+			objects++;
+		}
 
-	_vm->_imuseDigital->flushTracks();
+		ptr += subSize + (subSize & 1);
+	}
+
+	if (!usesDeltaCodec)
+		return;
+
+	// The codecs keep the previous frames, so frames must be decoded in
+	// order: once a frame is left to the regular path, the ones after it
+	// are too, until it has been played. INSANE may seek or skip frame
+	// objects at any time, so its videos always use the regular path.
+	if (_insanity || _undecodedDeltaChunks > 0 || objects != 1 || !fobj ||
+			READ_LE_UINT16(fobj + 6) != _vm->_screenWidth || READ_LE_UINT16(fobj + 8) != _vm->_screenHeight) {
+		chunk.needsDeltaCodec = true;
+		return;
+	}
+
+	SmushFrameDecode *frame = new SmushFrameDecode();
+	frame->codec = READ_LE_UINT16(fobj);
+	frame->left = READ_LE_UINT16(fobj + 2);
+	frame->top = READ_LE_UINT16(fobj + 4);
+	frame->width = READ_LE_UINT16(fobj + 6);
+	frame->height = READ_LE_UINT16(fobj + 8);
+	frame->src = fobj + 14;
+	frame->pixels = (byte *)malloc(frame->width * frame->height);
+	if (!frame->pixels) {
+		delete frame;
+		chunk.needsDeltaCodec = true;
+		return;
+	}
+
+	if (frame->codec == SMUSH_CODEC_DELTA_BLOCKS && !_deltaBlocksCodec)
+		_deltaBlocksCodec = new SmushDeltaBlocksDecoder(frame->width, frame->height);
+	else if (frame->codec == SMUSH_CODEC_DELTA_GLYPHS && !_deltaGlyphsCodec)
+		_deltaGlyphsCodec = new SmushDeltaGlyphsDecoder(frame->width, frame->height);
+	frame->blocksCodec = _deltaBlocksCodec;
+	frame->glyphsCodec = _deltaGlyphsCodec;
+
+	frame->job.run(&decodeFrameJob, frame, "SMUSH frame");
+	chunk.decode = frame;
+}
+
+void SmushPlayer::prefetchNextChunk() {
+	// Reads the next frame into memory while the player is idle, so that
+	// the tick which plays it doesn't also have to wait for the disk, and
+	// decodes its image on the job system where possible.
+	if (!_base || _seekPos >= 0 || _endOfFile || _prefetchedChunks.size() >= SMUSH_PREFETCH_CHUNKS)
+		return;
+
+	// Keep at most one frame decoding, so that they finish in order
+	if (!_prefetchedChunks.empty() && _prefetchedChunks.back().decode && !_prefetchedChunks.back().decode->job.isDone())
+		return;
+
+	const int32 chunkPos = _base->pos();
+	if (chunkPos + 8 >= (int32)_baseSize)
+		return;
+
+	const uint32 subType = _base->readUint32BE();
+	const int32 subSize = _base->readUint32BE();
+
+	if (subType != MKTAG('F','R','M','E') || subSize <= 0 || subSize > SMUSH_PREFETCH_MAX_SIZE ||
+			_base->pos() + subSize > (int32)_baseSize) {
+		_base->seek(chunkPos, SEEK_SET);
+		return;
+	}
+
+	SmushPrefetchedChunk chunk;
+	chunk.type = subType;
+	chunk.size = subSize;
+	chunk.data = (byte *)malloc(subSize);
+	chunk.decode = nullptr;
+	chunk.needsDeltaCodec = false;
+
+	if (!chunk.data || _base->read(chunk.data, subSize) != (uint32)subSize) {
+		free(chunk.data);
+		_base->seek(chunkPos, SEEK_SET);
+		return;
+	}
+
+	scheduleFrameDecode(chunk);
+	if (chunk.needsDeltaCodec)
+		_undecodedDeltaChunks++;
+
+	_prefetchedChunks.push(chunk);
+}
+
+void SmushPlayer::clearPrefetchedChunks() {
+	while (!_prefetchedChunks.empty()) {
+		SmushPrefetchedChunk chunk = _prefetchedChunks.pop();
+		freeFrameDecode(chunk.decode);
+		free(chunk.data);
+	}
+	_undecodedDeltaChunks = 0;
 }
 
 void SmushPlayer::setPalette(const byte *palette) {
@@ -1272,6 +1475,9 @@ void SmushPlayer::play(const char *filename, int32 speed, int32 offset, int32 st
 				else
 					skipFrame = false;
 				timerCallback();
+			} else {
+				// Use the spare time to read the upcoming frames
+				prefetchNextChunk();
 			}
 
 			_vm->scummLoop_handleSound();
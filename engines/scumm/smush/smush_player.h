@@ -22,6 +22,7 @@
 #if !defined(SCUMM_SMUSH_PLAYER_H) && defined(ENABLE_SCUMM_7_8)
 #define SCUMM_SMUSH_PLAYER_H
 
+#include "common/queue.h"
 #include "common/util.h"
 
 namespace Audio {
@@ -34,6 +35,9 @@ namespace Scumm {
 #define SMUSH_MAX_TRACKS 4
 #define SMUSH_FADE_SIZE  0xC00
 
+#define SMUSH_PREFETCH_CHUNKS   2
+#define SMUSH_PREFETCH_MAX_SIZE 0x100000
+
 #define IS_SFX       0x00
 #define IS_BKG_MUSIC 0x40
 #define IS_SPEECH    0x80
@@ -87,6 +91,7 @@ class SmushDeltaBlocksDecoder;
 class SmushDeltaGlyphsDecoder;
 class IMuseDigital;
 class Insane;
+struct SmushFrameDecode;
 
 class SmushPlayer {
 	friend class Insane;
@@ -107,6 +112,16 @@ private:
 		int32 audioLength;
 	};
 
+	struct SmushPrefetchedChunk {
+		uint32 type;
+		int32 size;
+		byte *data;
+		// The frame's codec37/47 image, decoded on the job system
+		SmushFrameDecode *decode;
+		// Set if the frame uses codec37/47 but could not be decoded ahead
+		bool needsDeltaCodec;
+	};
+
 	struct SmushAudioTrack {
 		uint8 *blockPtr;
 		uint8 *fadeBuf;
@@ -141,6 +156,13 @@ private:
 	byte *_frameBuffer;
 	byte *_specialBuffer;
 
+	// Chunks read ahead of time while waiting for the next frame
+	Common::Queue<SmushPrefetchedChunk> _prefetchedChunks;
+	// Number of queued chunks with needsDeltaCodec set
+	int _undecodedDeltaChunks;
+	// Decoded image for the frame object being parsed, if any
+	SmushFrameDecode *_predecodedFrame;
+
 	Common::String _seekFile;
 	uint32 _startFrame;
 	uint32 _startTime;
@@ -229,13 +251,18 @@ protected:
 private:
 	SmushFont *getFont(int font);
 	void parseNextFrame();
+	void parseChunk(uint32 subType, int32 subSize, Common::SeekableReadStream &b);
+	void prefetchNextChunk();
+	void clearPrefetchedChunks();
 	void init(int32 spped);
 	void setupAnim(const char *file);
 	void updateScreen();
 	void tryCmpFile(const char *filename);
 
 	bool readString(const char *file);
-	void decodeFrameObject(int codec, const uint8 *src, int left, int top, int width, int height);
+	void decodeFrameObject(int codec, const uint8 *src, int left, int top, int width, int height, bool predecoded = false);
+	bool usePredecodedFrame();
+	void scheduleFrameDecode(SmushPrefetchedChunk &chunk);
 	void handleAnimHeader(int32 subSize, Common::SeekableReadStream &);
 	void handleFrame(int32 frameSize, Common::SeekableReadStream &);
 	void handleNewPalette(int32 subSize, Common::SeekableReadStream &);
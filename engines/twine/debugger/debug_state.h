@@ -93,6 +93,7 @@ public:
 	bool _sceneFlagsWindow = false;
 	bool _paletteWindow = false;
 	bool _loggerWindow = false;
+	bool _profilerWindow = false;
 	bool _frameTimeWindow = false;
 	bool _frameDataRecording = true;
 	bool _playFoundItemAnimation = false;
@@ -170,6 +170,9 @@ void onImGuiInit() {
 	_tinyFont = ImGui::addTTFFontFromArchive("LiberationSans-Regular.ttf", 10.0f, nullptr, nullptr);
 
 	_logger = new ImGuiEx::ImGuiLogger;
+#ifdef ENABLE_PROFILER
+	_profiler = new ImGuiEx::ImGuiProfiler;
+#endif
 
 	Common::setLogWatcher(onLog);
 }
@@ -837,6 +840,11 @@ static void debuggerMenu(TwinEEngine *engine) {
 		if (ImGui::MenuItem("Frame time")) {
 			engine->_debugState->_frameTimeWindow = true;
 		}
+#ifdef ENABLE_PROFILER
+		if (ImGui::MenuItem("Profiler")) {
+			engine->_debugState->_profilerWindow = true;
+		}
+#endif
 
 		ImGui::SeparatorText("Actions");
 
@@ -936,6 +944,9 @@ void onImGuiRender() {
 	sceneFlagsWindow(engine);
 	frameTimeWindow(engine);
 	_logger->draw("Logger", &engine->_debugState->_loggerWindow);
+#ifdef ENABLE_PROFILER
+	_profiler->draw("Profiler", &engine->_debugState->_profilerWindow);
+#endif
 
 	if (engine->_debugState->_openPopup) {
 		ImGui::OpenPopup(engine->_debugState->_openPopup);
@@ -947,6 +958,10 @@ void onImGuiCleanup() {
 	Common::setLogWatcher(nullptr);
 	delete _logger;
 	_logger = nullptr;
+#ifdef ENABLE_PROFILER
+	delete _profiler;
+	_profiler = nullptr;
+#endif
 }
 
 } // namespace TwinE
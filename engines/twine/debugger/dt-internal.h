@@ -23,11 +23,17 @@
 #define TWINE_DEBUGGER_DT_INTERNAL_H
 
 #include "backends/imgui/components/imgui_logger.h"
+#ifdef ENABLE_PROFILER
+#include "backends/imgui/components/imgui_profiler.h"
+#endif
 
 namespace TwinE {
 
 ImFont *_tinyFont = nullptr;
 ImGuiEx::ImGuiLogger *_logger = nullptr;
+#ifdef ENABLE_PROFILER
+ImGuiEx::ImGuiProfiler *_profiler = nullptr;
+#endif
 
 } // namespace TwinE
 
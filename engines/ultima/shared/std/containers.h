@@ -204,6 +204,10 @@ public:
  * Queue ordered by a provided priority function
  * NOTE: Unlike in the C std library, we have to provde a comparitor that sorts
  * the array so that the smallest priority comes last
+ *
+ * The container is kept sorted rather than as a heap, so the top is its last
+ * element. Popping never releases the storage of the container, so emptying a
+ * queue and filling it again reuses it.
  */
 template <class _Ty, class _Container, class _Pr>
 class priority_queue {
@@ -213,23 +217,23 @@ public:
 	explicit priority_queue(const _Pr &_Pred) : c(), comp(_Pred) {}
 
 	priority_queue(const _Pr &_Pred, const _Container &_Cont) : c(_Cont), comp(_Pred) {
-		make_heap(c.begin(), c.end(), comp);
+		Common::sort(c.begin(), c.end(), comp);
 	}
 
 	template <class _InIt>
 	priority_queue(_InIt _First, _InIt _Last, const _Pr &_Pred, const _Container &_Cont) : c(_Cont), comp(_Pred) {
 		c.insert(c.end(), _First, _Last);
-		make_heap(c.begin(), c.end(), comp);
+		Common::sort(c.begin(), c.end(), comp);
 	}
 
 	template <class _InIt>
 	priority_queue(_InIt _First, _InIt _Last) : c(_First, _Last), comp() {
-		make_heap(c.begin(), c.end(), comp);
+		Common::sort(c.begin(), c.end(), comp);
 	}
 
 	template <class _InIt>
 	priority_queue(_InIt _First, _InIt _Last, const _Pr &_Pred) : c(_First, _Last), comp(_Pred) {
-		make_heap(c.begin(), c.end(), comp);
+		Common::sort(c.begin(), c.end(), comp);
 	}
 
 	bool empty() const {
@@ -245,8 +249,17 @@ public:
 	}
 
 	void push(const typename _Container::value_type &_Val) {
-		c.push_back(_Val);
-		Common::sort(c.begin(), c.end(), comp);
+		// The container is kept sorted, so a binary search finds the
+		// insert position after any elements that sort before or equal
+		size_t lo = 0, hi = c.size();
+		while (lo < hi) {
+			size_t mid = (lo + hi) / 2;
+			if (comp(_Val, c[mid]))
+				hi = mid;
+			else
+				lo = mid + 1;
+		}
+		c.insert_at(lo, _Val);
 	}
 
 	void pop() {
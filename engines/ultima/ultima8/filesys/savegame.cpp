@@ -28,7 +28,7 @@ namespace Ultima8 {
 
 #define SAVEGAME_IDENT MKTAG('V', 'M', 'U', '8')
 #define PKZIP_IDENT MKTAG('P', 'K', 3, 4)
-#define SAVEGAME_VERSION 6
+#define SAVEGAME_VERSION 7
 #define SAVEGAME_MIN_VERSION 2
 
 class FileEntryArchive : public Common::Archive {
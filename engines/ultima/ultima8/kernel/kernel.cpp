@@ -19,6 +19,7 @@
  *
  */
 
+#include "common/system.h"
 #include "ultima/ultima8/misc/debugger.h"
 #include "ultima/ultima8/kernel/kernel.h"
 #include "ultima/ultima8/kernel/process.h"
@@ -41,12 +42,16 @@ const uint16 Kernel::PROC_TYPE_ALL = 6;
 // Used in Usecode functions to translate.
 static const uint16 CRU_PROC_TYPE_ALL = 0xc;
 
+// The highest process id handed out
+static const uint16 MAX_PROC_ID = 32766;
+
 Kernel::Kernel() : _loading(false), _tickNum(0), _paused(0),
-		_runningProcess(nullptr), _frameByFrame(false) {
+		_runningProcess(nullptr), _frameByFrame(false), _profiling(false) {
 	debug(1, "Creating Kernel...");
 
 	_kernel = this;
-	_pIDs = new idMan(1, 32766, 128);
+	_pIDs = new idMan(1, MAX_PROC_ID, 128);
+	_pidTable.resize(MAX_PROC_ID + 1);
 	_currentProcess = _processes.end();
 }
 
@@ -63,6 +68,7 @@ void Kernel::reset() {
 	debug(1, "Resetting Kernel...");
 
 	for (auto *p : _processes) {
+		unindexProcess(p);
 		if (p->_flags & Process::PROC_TERM_DISPOSE && p != _runningProcess) {
 			delete p;
 		} else {
@@ -70,6 +76,7 @@ void Kernel::reset() {
 		}
 	}
 	_processes.clear();
+	_typeCounts.clear();
 	_currentProcess = _processes.end();
 
 	_pIDs->clearAll();
@@ -132,6 +139,7 @@ ProcId Kernel::addProcessExec(Process *proc, bool dispose) {
 		proc->_flags |= Process::PROC_TERM_DISPOSE;
 	}
 	_processes.push_back(proc);
+	indexProcess(--_processes.end());
 	proc->_flags |= Process::PROC_ACTIVE;
 
 	Process *oldrunning = _runningProcess;
@@ -166,7 +174,15 @@ void Kernel::runProcesses() {
 		        (!_paused || (p->_flags & Process::PROC_RUNPAUSED)) &&
 				(_paused || _tickNum % p->getTicksPerRun() == 0)) {
 			_runningProcess = p;
-			p->run();
+			if (_profiling) {
+				ProcessProfile &profile = _profile[&p->GetClassType()];
+				const uint64 start = g_system->getMicros();
+				p->run();
+				profile._micros += g_system->getMicros() - start;
+				profile._runs++;
+			} else {
+				p->run();
+			}
 			_runningProcess = nullptr;
 
 			num_run++;
@@ -203,6 +219,7 @@ void Kernel::runProcesses() {
 		if (!_paused && (p->_flags & Process::PROC_TERMINATED)) {
 			// process is killed, so remove it from the list
 			_currentProcess = _processes.erase(_currentProcess);
+			unindexProcess(p);
 
 			// Clear pid
 			_pIDs->clearID(p->_pid);
@@ -220,6 +237,7 @@ void Kernel::runProcesses() {
 			// *shouldn't* be used, and the process should be cleaned up next tick.
 			//
 			_processes.push_back(p);
+			indexProcess(--_processes.end());
 			_currentProcess = _processes.erase(_currentProcess);
 		} else {
 			++_currentProcess;
@@ -233,11 +251,15 @@ void Kernel::setNextProcess(Process *proc) {
 	if (_currentProcess != _processes.end() && *_currentProcess == proc) return;
 
 	if (proc->_flags & Process::PROC_ACTIVE) {
-		for (ProcessIterator it = _processes.begin();
-		        it != _processes.end(); ++it) {
-			if (*it == proc) {
-				_processes.erase(it);
-				break;
+		if (proc->_pid < _pidTable.size() && _pidTable[proc->_pid]._proc == proc) {
+			_processes.erase(_pidTable[proc->_pid]._iter);
+		} else {
+			for (ProcessIterator it = _processes.begin();
+			        it != _processes.end(); ++it) {
+				if (*it == proc) {
+					_processes.erase(it);
+					break;
+				}
 			}
 		}
 	} else {
@@ -247,27 +269,89 @@ void Kernel::setNextProcess(Process *proc) {
 	if (_currentProcess == _processes.end()) {
 		// Not currently running processes, add to the start of the next run.
 		_processes.push_front(proc);
+		indexProcess(_processes.begin());
 	} else {
 		ProcessIterator t = _currentProcess;
 		++t;
 
 		_processes.insert(t, proc);
+		indexProcess(--t);
 	}
 }
 
 Process *Kernel::getProcess(ProcId pid) {
-	for (auto *p : _processes) {
-		if (p->_pid == pid)
-			return p;
-	}
+	if (pid < _pidTable.size())
+		return _pidTable[pid]._proc;
 	return nullptr;
 }
 
+void Kernel::indexProcess(ProcessIterator it) {
+	Process *proc = *it;
+	if (proc->_pid >= _pidTable.size())
+		return;
+
+	ProcessSlot &slot = _pidTable[proc->_pid];
+	if (slot._proc == proc) {
+		// Moved within the run list
+		slot._iter = it;
+	} else if (!slot._proc) {
+		slot._proc = proc;
+		slot._iter = it;
+		_typeCounts[proc->_type]++;
+	}
+}
+
+void Kernel::unindexProcess(Process *proc) {
+	if (proc->_pid >= _pidTable.size() || _pidTable[proc->_pid]._proc != proc)
+		return;
+
+	_pidTable[proc->_pid]._proc = nullptr;
+	if (--_typeCounts[proc->_type] == 0)
+		_typeCounts.erase(proc->_type);
+}
+
+bool Kernel::hasProcessType(uint16 processtype) const {
+	return processtype == PROC_TYPE_ALL || _typeCounts.contains(processtype);
+}
+
+void Kernel::setProcessType(Process *proc, uint16 processtype) {
+	if (proc->_type == processtype)
+		return;
+
+	if (proc->_pid < _pidTable.size() && _pidTable[proc->_pid]._proc == proc) {
+		if (--_typeCounts[proc->_type] == 0)
+			_typeCounts.erase(proc->_type);
+		_typeCounts[processtype]++;
+	}
+	proc->_type = processtype;
+}
+
 void Kernel::kernelStats() {
 	g_debugger->debugPrintf("Kernel memory stats:\n");
 	g_debugger->debugPrintf("Processes  : %u/32765\n", _processes.size());
 }
 
+void Kernel::setProfiling(bool profiling) {
+	if (profiling && !_profiling)
+		_profile.clear();
+	_profiling = profiling;
+}
+
+void Kernel::profileReport() {
+	g_debugger->debugPrintf("Process run times:\n");
+	uint64 totalMicros = 0;
+	for (const auto &i : _profile) {
+		totalMicros += i._value._micros;
+	}
+	for (const auto &i : _profile) {
+		const ProcessProfile &profile = i._value;
+		g_debugger->debugPrintf("%s: %u runs, %llu us (%u%%)\n", i._key->_className,
+			profile._runs, (unsigned long long)profile._micros,
+			totalMicros ? (uint)(profile._micros * 100 / totalMicros) : 0);
+	}
+	g_debugger->debugPrintf("Total: %llu us\n", (unsigned long long)totalMicros);
+}
+
 void Kernel::processTypes() {
 	g_debugger->debugPrintf("Current process types:\n");
 	Common::HashMap<Common::String, unsigned int> processtypes;
@@ -282,6 +366,9 @@ void Kernel::processTypes() {
 uint32 Kernel::getNumProcesses(ObjId objid, uint16 processtype) {
 	uint32 count = 0;
 
+	if (!hasProcessType(processtype))
+		return 0;
+
 	for (const auto *p : _processes) {
 		// Don't count us, we are not really here
 		if (p->is_terminated()) continue;
@@ -295,6 +382,9 @@ uint32 Kernel::getNumProcesses(ObjId objid, uint16 processtype) {
 }
 
 Process *Kernel::findProcess(ObjId objid, uint16 processtype) {
+	if (!hasProcessType(processtype))
+		return nullptr;
+
 	for (auto *p : _processes) {
 		// Don't count us, we are not really here
 		if (p->is_terminated()) continue;
@@ -310,6 +400,9 @@ Process *Kernel::findProcess(ObjId objid, uint16 processtype) {
 
 
 void Kernel::killProcesses(ObjId objid, uint16 processtype, bool fail) {
+	if (!hasProcessType(processtype))
+		return;
+
 	for (auto *p : _processes) {
 		if (p->_itemNum != 0 && (objid == 0 || objid == p->_itemNum) &&
 		        (processtype == PROC_TYPE_ALL || processtype == p->_type) &&
@@ -417,6 +510,7 @@ bool Kernel::load(Common::ReadStream *rs, uint32 version) {
 		Process *p = loadProcess(rs, version);
 		if (!p) return false;
 		_processes.push_back(p);
+		indexProcess(--_processes.end());
 	}
 
 	// Integrity check for processes
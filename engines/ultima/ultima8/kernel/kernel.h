@@ -22,8 +22,10 @@
 #ifndef ULTIMA8_KERNEL_KERNEL_H
 #define ULTIMA8_KERNEL_KERNEL_H
 
+#include "common/hash-ptr.h"
 #include "ultima/shared/std/containers.h"
 #include "ultima/shared/std/string.h"
+#include "ultima/ultima8/misc/classtype.h"
 #include "ultima/ultima8/usecode/intrinsics.h"
 
 namespace Ultima {
@@ -102,6 +104,14 @@ public:
 	void kernelStats();
 	void processTypes();
 
+	//! Start or stop timing process runs by process class.
+	//! Starting clears the previously collected times.
+	void setProfiling(bool profiling);
+	bool isProfiling() const {
+		return _profiling;
+	}
+	void profileReport();
+
 	bool canSave();
 	void save(Common::WriteStream *ws);
 	bool load(Common::ReadStream *rs, uint32 version);
@@ -144,12 +154,44 @@ public:
 
 	INTRINSIC(I_getNumProcesses);
 	INTRINSIC(I_resetRef);
+	//! change the type of a process, keeping the type counts in sync
+	void setProcessType(Process *proc, uint16 processtype);
+
 private:
 	Process *loadProcess(Common::ReadStream *rs, uint32 version);
 
+	//! add a process in the run list to the pid table
+	void indexProcess(ProcessIterator it);
+	//! remove a process from the pid table
+	void unindexProcess(Process *proc);
+	//! check if there are any processes of the given type in the run list
+	bool hasProcessType(uint16 processtype) const;
+
 	Std::list<Process *> _processes;
 	idMan   *_pIDs;
 
+	//! Processes in the run list by pid, with their position in the list
+	struct ProcessSlot {
+		Process *_proc;
+		ProcessIterator _iter;
+
+		ProcessSlot() : _proc(nullptr) {}
+	};
+	Common::Array<ProcessSlot> _pidTable;
+
+	//! Number of processes in the run list of each process type
+	Common::HashMap<uint16, uint32> _typeCounts;
+
+	//! Time spent running processes of each class, when profiling
+	struct ProcessProfile {
+		uint32 _runs;
+		uint64 _micros;
+
+		ProcessProfile() : _runs(0), _micros(0) {}
+	};
+	Common::HashMap<const RunTimeClassType *, ProcessProfile> _profile;
+	bool _profiling;
+
 	Std::list<Process *>::iterator _currentProcess;
 
 	Common::HashMap<Common::String, ProcessLoadFunc> _processLoaders;
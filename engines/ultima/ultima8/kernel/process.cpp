@@ -37,6 +37,10 @@ Process::Process(ObjId it, uint16 ty)
 	}
 }
 
+void Process::setType(uint16 ty) {
+	Kernel::get_instance()->setProcessType(this, ty);
+}
+
 void Process::fail() {
 	_flags |= PROC_FAILED;
 	terminate();
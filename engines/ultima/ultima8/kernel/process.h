@@ -90,9 +90,7 @@ public:
 	void setItemNum(ObjId it) {
 		_itemNum = it;
 	}
-	void setType(uint16 ty) {
-		_type = ty;
-	}
+	void setType(uint16 ty);
 	void setTicksPerRun(uint32 val) {
 		_ticksPerRun = val;
 	}
@@ -104,6 +104,7 @@ Debugger::Debugger() : GUI::Debugger() {
 	registerCmd("Kernel::listProcesses", WRAP_METHOD(Debugger, cmdListProcesses));
 	registerCmd("Kernel::toggleFrameByFrame", WRAP_METHOD(Debugger, cmdFrameByFrame));
 	registerCmd("Kernel::advanceFrame", WRAP_METHOD(Debugger, cmdAdvanceFrame));
+	registerCmd("Kernel::profileProcesses", WRAP_METHOD(Debugger, cmdProfileProcesses));
 
 	registerCmd("MainActor::teleport", WRAP_METHOD(Debugger, cmdTeleport));
 	registerCmd("MainActor::mark", WRAP_METHOD(Debugger, cmdMark));
@@ -983,6 +984,30 @@ bool Debugger::cmdAdvanceFrame(int argc, const char **argv) {
 	return true;
 }
 
+bool Debugger::cmdProfileProcesses(int argc, const char **argv) {
+	if (argc > 2) {
+		debugPrintf("Usage: %s [on|off]\n", argv[0]);
+		return true;
+	}
+
+	Kernel *kern = Kernel::get_instance();
+	bool flag = !kern->isProfiling();
+	if (argc > 1) {
+		if (scumm_stricmp(argv[1], "on") == 0 || scumm_stricmp(argv[1], "true") == 0)
+			flag = true;
+		else if (scumm_stricmp(argv[1], "off") == 0 || scumm_stricmp(argv[1], "false") == 0)
+			flag = false;
+	}
+
+	// Report what was collected so far when stopping
+	if (!flag && kern->isProfiling())
+		kern->profileReport();
+
+	kern->setProfiling(flag);
+	debugPrintf("ProfileProcesses = %s\n", strBool(flag));
+	return true;
+}
+
 
 bool Debugger::cmdTeleport(int argc, const char **argv) {
 	if (!Ultima8Engine::get_instance()->areCheatsEnabled()) {
@@ -83,6 +83,7 @@ private:
 	bool cmdProcessInfo(int argc, const char **argv);
 	bool cmdFrameByFrame(int argc, const char **argv);
 	bool cmdAdvanceFrame(int argc, const char **argv);
+	bool cmdProfileProcesses(int argc, const char **argv);
 
 	// Main Actor
 	bool cmdTeleport(int argc, const char **argv);
@@ -24,6 +24,7 @@
 #include "ultima/ultima8/misc/direction_util.h"
 #include "ultima/ultima8/world/actors/actor.h"
 #include "ultima/ultima8/world/actors/animation_tracker.h"
+#include "ultima/ultima8/world/get_object.h"
 
 #ifdef DEBUG_PATHFINDER
 #include "graphics/screen.h"
@@ -50,6 +51,17 @@ struct PathNode {
 // NOTE: this is just to keep some statistics
 static unsigned int expandednodes = 0;
 
+// Visited states closer than this block new nodes
+static const int VISITED_RANGE = 8;
+
+// Limits on the number of nodes expanded in a pathfind
+static const unsigned int NODELIMIT_MIN = 30;  //! constant
+static const unsigned int NODELIMIT_MAX = 200; //! constant
+
+static uint32 visitedCellKey(int32 cx, int32 cy) {
+	return (static_cast<uint32>(cx & 0xFFFF) << 16) | static_cast<uint32>(cy & 0xFFFF);
+}
+
 void PathfindingState::load(const Actor *_actor) {
 	_point = _actor->getLocation();
 	_lastAnim = _actor->getLastAnim();
@@ -113,11 +125,13 @@ bool PathNodeCmp::operator()(const PathNode *n1, const PathNode *n2) const {
 	return (n1->heuristicTotalCost > n2->heuristicTotalCost);
 }
 
-Pathfinder::Pathfinder() : _actor(nullptr), _targetItem(nullptr),
-		_hitMode(false), _expandTime(0), _target(),
-		_actorXd(0), _actorYd(0), _actorZd(0) {
+Pathfinder::Pathfinder() : _actorId(0), _actor(nullptr), _targetItem(nullptr),
+		_hitMode(false), _expandTime(0), _expandedNodes(0), _searching(false),
+		_target(), _actorXd(0), _actorYd(0), _actorZd(0),
+		_nodePool(sizeof(PathNode)) {
 	expandednodes = 0;
 	_visited.reserve(1500);
+	_visitedNext.reserve(1500);
 }
 
 Pathfinder::~Pathfinder() {
@@ -125,13 +139,29 @@ Pathfinder::~Pathfinder() {
 		_cleanupNodes.size(), _visited.size(), expandednodes, _expandTime);
 
 	// clean up _nodes
-	for (auto *node : _cleanupNodes)
-		delete node;
+	freeNodes();
+}
+
+PathNode *Pathfinder::allocNode() {
+	PathNode *node = new (_nodePool) PathNode();
+	_cleanupNodes.push_back(node);
+	return node;
+}
+
+void Pathfinder::freeNodes() {
+	for (auto *node : _cleanupNodes) {
+		node->~PathNode();
+		_nodePool.freeChunk(node);
+	}
 	_cleanupNodes.clear();
+
+	while (!_nodes.empty())
+		_nodes.pop();
 }
 
 void Pathfinder::init(Actor *actor, PathfindingState *state) {
 	_actor = actor;
+	_actorId = actor->getObjId();
 
 	_actor->getFootpadWorld(_actorXd, _actorYd, _actorZd);
 
@@ -171,21 +201,36 @@ bool Pathfinder::canReach() {
 
 bool Pathfinder::alreadyVisited(const Point3 &pt) const {
 	//
-	// There are more efficient search structures we could use for
-	// this, but for the number of points we end up having even on
-	// pathfind failure (~1200) the fancy structures don't justify
-	// their extra overhead.
-	//
-	// Linear search of an array is just as fast, or slightly faster.
+	// Visited states are bucketed in cells as large as the check range,
+	// so only the cells around the point can hold a state within range.
 	//
-	for (const auto &i : _visited) {
-		if (i.checkPoint(pt, 8*8))
-			return true;
+	const int32 cx = pt.x / VISITED_RANGE;
+	const int32 cy = pt.y / VISITED_RANGE;
+	for (int32 x = cx - 1; x <= cx + 1; x++) {
+		for (int32 y = cy - 1; y <= cy + 1; y++) {
+			Common::HashMap<uint32, int>::const_iterator it = _visitedCells.find(visitedCellKey(x, y));
+			if (it == _visitedCells.end())
+				continue;
+
+			for (int i = it->_value; i >= 0; i = _visitedNext[i]) {
+				if (_visited[i].checkPoint(pt, VISITED_RANGE * VISITED_RANGE))
+					return true;
+			}
+		}
 	}
 
 	return false;
 }
 
+void Pathfinder::addVisited(const PathfindingState &state) {
+	const uint32 key = visitedCellKey(state._point.x / VISITED_RANGE, state._point.y / VISITED_RANGE);
+
+	Common::HashMap<uint32, int>::iterator it = _visitedCells.find(key);
+	_visitedNext.push_back(it != _visitedCells.end() ? it->_value : -1);
+	_visitedCells[key] = _visited.size();
+	_visited.push_back(state);
+}
+
 bool Pathfinder::checkTarget(const PathNode *node) const {
 	// TODO: these ranges are probably a bit too high,
 	// but otherwise it won't work properly yet -wjp
@@ -348,7 +393,7 @@ static void drawpath(Graphics::ManagedSurface *screen, PathNode *to, uint32 rgb,
 
 void Pathfinder::newNode(PathNode *oldnode, PathfindingState &state,
 						 unsigned int steps) {
-	PathNode *newnode = new PathNode();
+	PathNode *newnode = allocNode();
 	newnode->state = state;
 	newnode->parent = oldnode;
 	newnode->depth = oldnode->depth + 1;
@@ -474,24 +519,29 @@ void Pathfinder::expandNode(PathNode *node) {
 			tracker.updateState(state);
 			if (!alreadyVisited(state._point)) {
 				newNode(node, state, 0);
-				_visited.push_back(state);
+				addVisited(state);
 			}
 		} else {
 			// an obstruction was encountered, so generate a visited node to block
 			// future evaluation at the endpoint.
-			_visited.push_back(state);
+			addVisited(state);
 		}
 
 		// TODO: maybe only allow partial steps close to target?
 		if (beststeps != 0 && (beststeps != steps ||
 		                       (!tracker.isDone() && _targetItem))) {
 			newNode(node, closeststate, beststeps);
-			_visited.push_back(closeststate);
+			addVisited(closeststate);
 		}
 	}
 }
 
 bool Pathfinder::pathfind(Std::vector<PathfindingAction> &path) {
+	startPathfind();
+	return continuePathfind(path, NODELIMIT_MAX) == PATHFIND_FOUND;
+}
+
+void Pathfinder::startPathfind() {
 	if (_targetItem) {
 		debugC(kDebugPath, "Actor %u pathfinding to item %u", _actor->getObjId(), _targetItem->getObjId());
 		debugC(kDebugPath, "Target Item: %s", _targetItem->dumpInfo().c_str());
@@ -512,10 +562,13 @@ bool Pathfinder::pathfind(Std::vector<PathfindingAction> &path) {
 	}
 #endif
 
+	// Forget any previous search, but keep the memory around
+	freeNodes();
+	_visited.resize(0);
+	_visitedNext.resize(0);
+	_visitedCells.clear();
 
-	path.clear();
-
-	PathNode *startnode = new PathNode();
+	PathNode *startnode = allocNode();
 	startnode->state = _start;
 	startnode->cost = 0;
 	startnode->parent = nullptr;
@@ -523,16 +576,31 @@ bool Pathfinder::pathfind(Std::vector<PathfindingAction> &path) {
 	startnode->stepsfromparent = 0;
 	_nodes.push(startnode);
 
-	unsigned int expandedNodes = 0;
-	const unsigned int NODELIMIT_MIN = 30;  //! constant
-	const unsigned int NODELIMIT_MAX = 200; //! constant
-	bool found = false;
-	uint32 starttime = g_system->getMillis();
+	_expandedNodes = 0;
+	_expandTime = 0;
+	_searching = true;
+}
+
+Pathfinder::PathfindResult Pathfinder::continuePathfind(Std::vector<PathfindingAction> &path,
+		unsigned int maxNodes) {
+	assert(_searching);
+
+	// The actor may have been destroyed since the last step
+	_actor = getActor(_actorId);
+	if (!_actor) {
+		_searching = false;
+		path.clear();
+		return PATHFIND_FAILED;
+	}
+
+	unsigned int nodeLimit = NODELIMIT_MAX;
+	if (maxNodes < NODELIMIT_MAX - _expandedNodes)
+		nodeLimit = _expandedNodes + maxNodes;
+	uint32 starttime = g_system->getMillis() - _expandTime;
 
-	while (expandedNodes < NODELIMIT_MAX && !_nodes.empty() && !found) {
-		// Take a copy here as the pop() below deletes the old node
-		PathNode *node = new PathNode(*_nodes.top());
-		_cleanupNodes.push_back(node);
+	while (_expandedNodes < nodeLimit && !_nodes.empty()) {
+		// Nodes stay allocated until the next search, so no copy is needed
+		PathNode *node = _nodes.top();
 		_nodes.pop();
 
 		debugC(kDebugPath, "Trying node: (%d, %d, %d) target=(%d, %d, %d)",
@@ -554,6 +622,7 @@ bool Pathfinder::pathfind(Std::vector<PathfindingAction> &path) {
 
 			unsigned int i = length;
 			if (length > 0) length++; // add space for final 'stand' action
+			path.clear();
 			path.resize(length);
 
 			// now backtrack through the _nodes to assemble the final animation
@@ -582,13 +651,14 @@ bool Pathfinder::pathfind(Std::vector<PathfindingAction> &path) {
 			}
 
 			_expandTime = g_system->getMillis() - starttime;
-			return true;
+			_searching = false;
+			return PATHFIND_FOUND;
 		}
 
 		expandNode(node);
-		expandedNodes++;
+		_expandedNodes++;
 
-		if (expandedNodes >= NODELIMIT_MIN && ((expandedNodes) % 5) == 0) {
+		if (_expandedNodes >= NODELIMIT_MIN && ((_expandedNodes) % 5) == 0) {
 			uint32 elapsed_ms = g_system->getMillis() - starttime;
 			if (elapsed_ms > 350) break;
 		}
@@ -596,13 +666,21 @@ bool Pathfinder::pathfind(Std::vector<PathfindingAction> &path) {
 
 	_expandTime = g_system->getMillis() - starttime;
 
+	// Out of this step's budget, but not out of nodes or time yet
+	if (_expandedNodes == nodeLimit && nodeLimit < NODELIMIT_MAX &&
+			!_nodes.empty() && _expandTime <= 350)
+		return PATHFIND_RUNNING;
+
+	_searching = false;
+	path.clear();
+
 	static int32 pfcalls = 0;
 	static int32 pftotaltime = 0;
 	pfcalls++;
 	pftotaltime += _expandTime;
 	debugC(kDebugPath, "maxout average = %dms.", pftotaltime / pfcalls);
 
-	return false;
+	return PATHFIND_FAILED;
 }
 
 } // End of namespace Ultima8
@@ -22,7 +22,10 @@
 #ifndef ULTIMA8_WORLD_ACTORS_PATHFINDER_H
 #define ULTIMA8_WORLD_ACTORS_PATHFINDER_H
 
+#include "common/hashmap.h"
+#include "common/memorypool.h"
 #include "ultima/shared/std/containers.h"
+#include "ultima/ultima8/misc/common_types.h"
 #include "ultima/ultima8/misc/direction.h"
 #include "ultima/ultima8/misc/point3.h"
 #include "ultima/ultima8/world/actors/animation.h"
@@ -80,6 +83,25 @@ public:
 	//! pathfind. If true, the found path is returned in path
 	bool pathfind(Std::vector<PathfindingAction> &path);
 
+	enum PathfindResult {
+		PATHFIND_RUNNING,
+		PATHFIND_FOUND,
+		PATHFIND_FAILED
+	};
+
+	//! start a pathfind that is run in steps by continuePathfind
+	void startPathfind();
+
+	//! expand at most maxNodes more nodes of the pathfind started with
+	//! startPathfind. When a path is found, it is returned in path
+	PathfindResult continuePathfind(Std::vector<PathfindingAction> &path,
+									unsigned int maxNodes);
+
+	//! is a pathfind started with startPathfind still running?
+	bool isSearching() const {
+		return _searching;
+	}
+
 #ifdef DEBUG_PATHFINDER
 	static ObjId _visualDebugActor;
 #endif
@@ -87,21 +109,40 @@ public:
 
 protected:
 	PathfindingState _start;
+	//! The actor is looked up by _actorId at each step of a search, since
+	//! it may be destroyed between steps.
+	ObjId _actorId;
 	Actor *_actor;
 	Point3 _target;
+	//! Set again by the owner of the pathfinder before each step
 	Item *_targetItem;
 	bool _hitMode;
 	int32 _expandTime;
+	unsigned int _expandedNodes;
+	bool _searching;
 
 	int32 _actorXd, _actorYd, _actorZd;
 
 	Common::Array<PathfindingState> _visited;
 	Std::priority_queue<PathNode *, Std::vector<PathNode *>, PathNodeCmp> _nodes;
 
+	/**
+	 * Visited states bucketed by position. Each cell holds the index of the
+	 * last state added to it, and _visitedNext chains to the previous one.
+	 */
+	Common::HashMap<uint32, int> _visitedCells;
+	Common::Array<int> _visitedNext;
+
+	/** Memory for the nodes, kept between searches */
+	Common::MemoryPool _nodePool;
+
 	/** List of nodes for garbage collection later and order is not important */
 	Std::vector<PathNode *> _cleanupNodes;
 
 	bool alreadyVisited(const Point3 &pt) const;
+	void addVisited(const PathfindingState &state);
+	PathNode *allocNode();
+	void freeNodes();
 	void newNode(PathNode *oldnode, PathfindingState &state,
 				 unsigned int steps);
 	void expandNode(PathNode *node);
@@ -31,16 +31,19 @@ namespace Ultima8 {
 static const unsigned int PATH_OK = 1;
 static const unsigned int PATH_FAILED = 0;
 
+// Nodes the pathfinder may expand in a single run of the process
+static const unsigned int PATHFIND_NODES_PER_RUN = 30;
+
 DEFINE_RUNTIME_CLASSTYPE_CODE(PathfinderProcess)
 
 PathfinderProcess::PathfinderProcess() : Process(),
 		_currentStep(0), _targetItem(0), _hitMode(false),
-		_target() {
+		_target(), _pathfinder(nullptr), _searchPending(false) {
 }
 
 PathfinderProcess::PathfinderProcess(Actor *actor, ObjId itemid, bool hit) :
 		_currentStep(0), _targetItem(itemid), _hitMode(hit),
-		_target() {
+		_target(), _pathfinder(nullptr), _searchPending(false) {
 	assert(actor);
 	_itemNum = actor->getObjId();
 	_type = PATHFINDER_PROC_TYPE;
@@ -58,16 +61,8 @@ PathfinderProcess::PathfinderProcess(Actor *actor, ObjId itemid, bool hit) :
 
 	_target = item->getLocation();
 
-	Pathfinder pf;
-	pf.init(actor);
-	pf.setTarget(item, hit);
-
-	bool ok = pf.pathfind(_path);
-
-	if (!ok) {
+	if (!startPathfind(actor)) {
 		// can't get there...
-		debugC(kDebugPath, "PathfinderProcess: actor %d failed to find path", _itemNum);
-		_result = PATH_FAILED;
 		terminateDeferred();
 		return;
 	}
@@ -78,21 +73,13 @@ PathfinderProcess::PathfinderProcess(Actor *actor, ObjId itemid, bool hit) :
 
 PathfinderProcess::PathfinderProcess(Actor *actor, const Point3 &target) :
 		_target(target), _targetItem(0), _currentStep(0),
-		_hitMode(false) {
+		_hitMode(false), _pathfinder(nullptr), _searchPending(false) {
 	assert(actor);
 	_itemNum = actor->getObjId();
 	_type = PATHFINDER_PROC_TYPE;
 
-	Pathfinder pf;
-	pf.init(actor);
-	pf.setTarget(_target);
-
-	bool ok = pf.pathfind(_path);
-
-	if (!ok) {
+	if (!startPathfind(actor)) {
 		// can't get there...
-		debugC(kDebugPath, "PathfinderProcess: actor %d failed to find path", _itemNum);
-		_result = PATH_FAILED;
 		terminateDeferred();
 		return;
 	}
@@ -102,6 +89,50 @@ PathfinderProcess::PathfinderProcess(Actor *actor, const Point3 &target) :
 }
 
 PathfinderProcess::~PathfinderProcess() {
+	delete _pathfinder;
+}
+
+bool PathfinderProcess::startPathfind(Actor *actor) {
+	if (!_pathfinder)
+		_pathfinder = new Pathfinder();
+
+	_pathfinder->init(actor);
+	if (_targetItem) {
+		Item *item = getItem(_targetItem);
+		if (!item) {
+			_result = PATH_FAILED;
+			return false;
+		}
+		_pathfinder->setTarget(item, _hitMode);
+	} else {
+		_pathfinder->setTarget(_target);
+	}
+
+	_pathfinder->startPathfind();
+	return continuePathfind(PATHFIND_NODES_PER_RUN);
+}
+
+bool PathfinderProcess::continuePathfind(unsigned int maxNodes) {
+	// The target may have been moved to another container since the last step
+	if (_targetItem) {
+		Item *item = getItem(_targetItem);
+		if (!item) {
+			warning("PathfinderProcess: target missing");
+			_result = PATH_FAILED;
+			return false;
+		}
+		_pathfinder->setTarget(item, _hitMode);
+	}
+
+	Pathfinder::PathfindResult result = _pathfinder->continuePathfind(_path, maxNodes);
+	if (result == Pathfinder::PATHFIND_FAILED) {
+		debugC(kDebugPath, "PathfinderProcess: actor %d failed to find path", _itemNum);
+		_result = PATH_FAILED;
+		return false;
+	}
+
+	_currentStep = 0;
+	return true;
 }
 
 void PathfinderProcess::terminate() {
@@ -121,6 +152,27 @@ void PathfinderProcess::run() {
 	// if not in the fastarea, do nothing
 	if (!actor->hasFlags(Item::FLG_FASTAREA)) return;
 
+	// a search was in progress when the game was saved, so start it again
+	if (_searchPending) {
+		_searchPending = false;
+		_path.clear();
+		if (!startPathfind(actor)) {
+			terminate();
+			return;
+		}
+		if (_pathfinder->isSearching())
+			return;
+	}
+
+	// carry on with a long search before anything else
+	if (_pathfinder && _pathfinder->isSearching()) {
+		if (!continuePathfind(PATHFIND_NODES_PER_RUN)) {
+			terminate();
+			return;
+		}
+		if (_pathfinder->isSearching())
+			return;
+	}
 
 	bool ok = true;
 
@@ -171,35 +223,28 @@ void PathfinderProcess::run() {
 		debugC(kDebugPath, "PathfinderProcess: recalculating _path");
 
 		// need to redetermine _path
-		ok = true;
-		Pathfinder pf;
-		pf.init(actor);
 		if (_targetItem) {
 			Item *item = getItem(_targetItem);
-			if (!item)
-				ok = false;
-			else {
+			if (item) {
 				if (_hitMode && !actor->isInCombat()) {
 					// Actor exited combat mode
 					_hitMode = false;
 				}
-				pf.setTarget(item, _hitMode);
 				_target = item->getLocation();
 			}
-		} else {
-			pf.setTarget(_target);
 		}
-		if (ok)
-			ok = pf.pathfind(_path);
 
+		_path.clear();
 		_currentStep = 0;
-		if (!ok) {
+		if (!startPathfind(actor)) {
 			// can't get there anymore
-			debugC(kDebugPath, "PathfinderProcess: actor %d failed to find path", _itemNum);
-			_result = PATH_FAILED;
 			terminate();
 			return;
 		}
+
+		// wait for the rest of the search in the next runs
+		if (_pathfinder->isSearching())
+			return;
 	}
 
 	if (_currentStep >= _path.size()) {
@@ -223,6 +268,10 @@ void PathfinderProcess::run() {
 }
 
 void PathfinderProcess::saveData(Common::WriteStream *ws) {
+	// The state of a search in progress isn't saved; it is started again
+	// after loading, without a path
+	const bool searchPending = _searchPending || (_pathfinder && _pathfinder->isSearching());
+
 	Process::saveData(ws);
 
 	ws->writeUint16LE(_targetItem);
@@ -230,13 +279,16 @@ void PathfinderProcess::saveData(Common::WriteStream *ws) {
 	ws->writeUint16LE(static_cast<uint16>(_target.y));
 	ws->writeUint16LE(static_cast<uint16>(_target.z));
 	ws->writeByte(_hitMode ? 1 : 0);
-	ws->writeUint16LE(static_cast<uint16>(_currentStep));
+	ws->writeUint16LE(static_cast<uint16>(searchPending ? 0 : _currentStep));
 
-	ws->writeUint16LE(static_cast<uint16>(_path.size()));
-	for (unsigned int i = 0; i < _path.size(); ++i) {
+	const unsigned int pathsize = searchPending ? 0 : _path.size();
+	ws->writeUint16LE(static_cast<uint16>(pathsize));
+	for (unsigned int i = 0; i < pathsize; ++i) {
 		ws->writeUint16LE(static_cast<uint16>(_path[i]._action));
 		ws->writeUint16LE(static_cast<uint16>(Direction_ToUsecodeDir(_path[i]._direction)));
 	}
+
+	ws->writeByte(searchPending ? 1 : 0);
 }
 
 bool PathfinderProcess::loadData(Common::ReadStream *rs, uint32 version) {
@@ -261,6 +313,10 @@ bool PathfinderProcess::loadData(Common::ReadStream *rs, uint32 version) {
 		_path[i]._direction = Direction_FromUsecodeDir(rs->readUint16LE());
 	}
 
+	// Earlier versions finished the search before saving
+	if (version >= 7)
+		_searchPending = (rs->readByte() != 0);
+
 	return true;
 }
 
@@ -48,6 +48,14 @@ public:
 	void saveData(Common::WriteStream *ws) override;
 
 protected:
+	//! start a pathfind to the target and run its first step
+	//! \return false if the pathfind failed
+	bool startPathfind(Actor *actor);
+
+	//! run the pathfind in progress for at most maxNodes nodes
+	//! \return false if the pathfind failed
+	bool continuePathfind(unsigned int maxNodes);
+
 	Point3 _target;
 	ObjId _targetItem;
 	bool _hitMode;
@@ -55,6 +63,14 @@ protected:
 	Std::vector<PathfindingAction> _path;
 	unsigned int _currentStep;
 
+	//! Pathfinder for the current path. Long searches are spread over
+	//! several runs of the process. Not saved.
+	Pathfinder *_pathfinder;
+
+	//! A search was in progress when the game was saved. It is started
+	//! again by the next run, as the search state itself isn't saved.
+	bool _searchPending;
+
 public:
 	static const uint16 PATHFINDER_PROC_TYPE = 0x204;
 };
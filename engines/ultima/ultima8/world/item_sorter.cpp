@@ -19,6 +19,7 @@
  *
  */
 
+#include "common/algorithm.h"
 #include "ultima/ultima.h"
 #include "ultima/ultima8/misc/common_types.h"
 #include "ultima/ultima8/world/item_sorter.h"
@@ -45,10 +46,22 @@ namespace Ultima8 {
 static const uint32 TRANSPARENT_COLOR = TEX32_PACK_RGBA(0x7F, 0x00, 0x00, 0x7F);
 static const uint32 HIGHLIGHT_COLOR = TEX32_PACK_RGBA(0xFF, 0xFF, 0x00, 0x1F);
 
+// Size in pixels of a screenspace bucket used to find overlapping items
+static const int32 GRID_CELL_SIZE = 64;
+
+// Order items the same way they appear in the display list
+static bool addOrderLessThan(const SortItem *si1, const SortItem *si2) {
+	if (si1->listLessThan(*si2))
+		return true;
+	if (si2->listLessThan(*si1))
+		return false;
+	return si1->_addOrder < si2->_addOrder;
+}
+
 ItemSorter::ItemSorter(int capacity) :
 	_shapes(nullptr), _clipWindow(0, 0, 0, 0), _items(nullptr), _itemsTail(nullptr),
 	_itemsUnused(nullptr), _painted(nullptr), _camSx(0), _camSy(0),
-	_sortLimit(0), _sortLimitChanged(false) {
+	_sortLimit(0), _sortLimitChanged(false), _addCount(0), _gridCols(0), _gridRows(0) {
 	int i = capacity;
 	while (i--) {
 		SortItem *next = _itemsUnused;
@@ -88,6 +101,17 @@ void ItemSorter::BeginDisplayList(const Rect &clipWindow, const Point3 &cam) {
 	_itemsTail = nullptr;
 	_painted = nullptr;
 
+	_keyTails.resize(0);
+	_addCount = 0;
+
+	// Resize the bucket grid to cover the clip window, keeping the memory
+	// of each bucket around for the next frame
+	_gridCols = MAX<int32>(1, (_clipWindow.width() + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE);
+	_gridRows = MAX<int32>(1, (_clipWindow.height() + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE);
+	_grid.resize(_gridCols * _gridRows);
+	for (uint i = 0; i < _grid.size(); i++)
+		_grid[i].resize(0);
+
 	// Screenspace bounding box bottom x coord (RNB x coord)
 	int32 camSx = (cam.x - cam.y) / 4;
 	// Screenspace bounding box bottom extent  (RNB y coord)
@@ -187,19 +211,39 @@ void ItemSorter::AddItem(const Point3 &pt, uint32 shapeNum, uint32 frame_num, ui
 	// are never deleted
 	si->_depends.clear();
 
-	// Iterate the list and compare _shapes
+	// Only items sharing a grid cell with us can have an intersecting
+	// screenspace rect, so gather those and process them in list order
+	int32 x0, y0, x1, y1;
+	GetGridCells(si->_sr, x0, y0, x1, y1);
+
+	_candidates.resize(0);
+	for (int32 y = y0; y <= y1; y++) {
+		for (int32 x = x0; x <= x1; x++) {
+			const Common::Array<SortItem *> &cell = _grid[y * _gridCols + x];
+			for (uint i = 0; i < cell.size(); i++) {
+				if (!cell[i]->_occluded)
+					_candidates.push_back(cell[i]);
+			}
+		}
+	}
 
-	// Ok,
-	SortItem *addpoint = nullptr;
-	for (SortItem *si2 = _items; si2 != nullptr; si2 = si2->_next) {
-		// Get the insert point... which is before the first item that has higher z than us
-		if (!addpoint && si->listLessThan(*si2))
-			addpoint = si2;
+	Common::sort(_candidates.begin(), _candidates.end(), addOrderLessThan);
 
+	// Items spanning several cells show up more than once
+	if (x0 != x1 || y0 != y1) {
+		uint n = 0;
+		for (uint i = 0; i < _candidates.size(); i++) {
+			if (n == 0 || _candidates[n - 1] != _candidates[i])
+				_candidates[n++] = _candidates[i];
+		}
+		_candidates.resize(n);
+	}
+
+#ifdef SORTITEM_OCCLUSION_EXPERIMENTAL
+	for (SortItem *si2 = _items; si2 != nullptr; si2 = si2->_next) {
 		if (si2->_occluded)
 			continue;
 
-#ifdef SORTITEM_OCCLUSION_EXPERIMENTAL
 		// Find adjoining rects for better occlusion
 		if (si->_occl && si2->_occl && si->_z == si2->_z) {
 			// Does this share an edge?
@@ -218,8 +262,16 @@ void ItemSorter::AddItem(const Point3 &pt, uint32 shapeNum, uint32 frame_num, ui
 				}
 			}
 		}
+	}
 #endif // SORTITEM_OCCLUSION_EXPERIMENTAL
 
+	for (uint i = 0; i < _candidates.size(); i++) {
+		SortItem *si2 = _candidates[i];
+
+		// An earlier candidate may have been occluded by us
+		if (si2->_occluded)
+			continue;
+
 		// Attempt to find paint dependency order
 		if (si->overlap(*si2)) {
 			if (si->below(*si2)) {
@@ -245,28 +297,57 @@ void ItemSorter::AddItem(const Point3 &pt, uint32 shapeNum, uint32 frame_num, ui
 
 	// Add it to the list
 	_itemsUnused = _itemsUnused->_next;
+	si->_addOrder = _addCount++;
+	InsertSorted(si);
+
+	// Occluded items are skipped by every later check, so keep them out of the grid
+	if (!si->_occluded) {
+		for (int32 y = y0; y <= y1; y++) {
+			for (int32 x = x0; x <= x1; x++)
+				_grid[y * _gridCols + x].push_back(si);
+		}
+	}
+}
 
-	// have a position
-	//addpoint = 0;
-	if (addpoint) {
-		si->_next = addpoint;
-		si->_prev = addpoint->_prev;
-		addpoint->_prev = si;
-		if (si->_prev)
-			si->_prev->_next = si;
+void ItemSorter::InsertSorted(SortItem *si) {
+	// Find the first key that sorts after ours. The item goes after
+	// the last item of the key before it, which is the last item in the
+	// list that does not sort after us.
+	uint lo = 0, hi = _keyTails.size();
+	while (lo < hi) {
+		uint mid = (lo + hi) / 2;
+		if (si->listLessThan(*_keyTails[mid]))
+			hi = mid;
 		else
-			_items = si;
+			lo = mid + 1;
 	}
-	// Add it to the end of the list
-	else {
-		if (_itemsTail)
-			_itemsTail->_next = si;
-		if (!_items)
-			_items = si;
-		si->_next = nullptr;
-		si->_prev = _itemsTail;
+
+	SortItem *prev = lo > 0 ? _keyTails[lo - 1] : nullptr;
+	if (prev && !prev->listLessThan(*si))
+		_keyTails[lo - 1] = si;
+	else
+		_keyTails.insert_at(lo, si);
+
+	si->_prev = prev;
+	si->_next = prev ? prev->_next : _items;
+	if (si->_prev)
+		si->_prev->_next = si;
+	else
+		_items = si;
+	if (si->_next)
+		si->_next->_prev = si;
+	else
 		_itemsTail = si;
-	}
+}
+
+void ItemSorter::GetGridCells(const Rect &r, int32 &x0, int32 &y0, int32 &x1, int32 &y1) const {
+	// Rects extending past the clip window are clamped to the edge cells.
+	// Two intersecting rects still share at least one cell after clamping.
+	// Empty frames still count as intersecting, so give them a cell too.
+	x0 = CLIP<int32>((r.left - _clipWindow.left) / GRID_CELL_SIZE, 0, _gridCols - 1);
+	x1 = CLIP<int32>((MAX(r.right - 1, r.left) - _clipWindow.left) / GRID_CELL_SIZE, 0, _gridCols - 1);
+	y0 = CLIP<int32>((r.top - _clipWindow.top) / GRID_CELL_SIZE, 0, _gridRows - 1);
+	y1 = CLIP<int32>((MAX(r.bottom - 1, r.top) - _clipWindow.top) / GRID_CELL_SIZE, 0, _gridRows - 1);
 }
 
 void ItemSorter::AddItem(const Item *add) {
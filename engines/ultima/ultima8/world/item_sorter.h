@@ -22,6 +22,7 @@
 #ifndef ULTIMA8_WORLD_ITEMSORTER_H
 #define ULTIMA8_WORLD_ITEMSORTER_H
 
+#include "common/array.h"
 #include "ultima/ultima8/misc/rect.h"
 
 namespace Ultima {
@@ -46,6 +47,18 @@ class ItemSorter {
 	int32       _sortLimit;
 	bool        _sortLimitChanged;
 
+	// Last item in the list for each distinct list sort key, in list order
+	Common::Array<SortItem *> _keyTails;
+	uint32      _addCount;
+
+	// Screenspace bucket grid over the clip window. Each cell holds the
+	// visible items whose frame rect touches it, in the order they were added
+	Common::Array<Common::Array<SortItem *> > _grid;
+	int32       _gridCols, _gridRows;
+
+	// Scratch buffer for overlap candidates during AddItem
+	Common::Array<SortItem *> _candidates;
+
 public:
 	ItemSorter(int capacity);
 	~ItemSorter();
@@ -71,6 +84,9 @@ public:
 
 private:
 	bool PaintSortItem(RenderSurface *surf, SortItem *si, bool showFootpad, int gridlines);
+
+	void InsertSorted(SortItem *si);
+	void GetGridCells(const Rect &r, int32 &x0, int32 &y0, int32 &x1, int32 &y1) const;
 };
 
 } // End of namespace Ultima8
@@ -1220,6 +1220,31 @@ ScValue *AdActor::scGetProperty(const Common::String &name) {
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+ScValue *AdActor::scGetSymbolProperty(TScSymbol symbol, const Common::String &name) {
+	switch (symbol) {
+	case SYM_DIRECTION:
+		_scValue->setInt(_dir);
+		return _scValue;
+
+	case SYM_X:
+		_scValue->setInt(_posX);
+		return _scValue;
+
+	case SYM_Y:
+		_scValue->setInt(_posY);
+		return _scValue;
+
+	case SYM_ACTIVE:
+		_scValue->setBool(_active);
+		return _scValue;
+
+	default:
+		return AdTalkHolder::scGetSymbolProperty(symbol, name);
+	}
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 bool AdActor::scSetProperty(const char *name, ScValue *value) {
 	//////////////////////////////////////////////////////////////////////////
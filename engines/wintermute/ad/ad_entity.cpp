@@ -1057,6 +1057,35 @@ ScValue *AdEntity::scGetProperty(const Common::String &name) {
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+ScValue *AdEntity::scGetSymbolProperty(TScSymbol symbol, const Common::String &name) {
+	switch (symbol) {
+	case SYM_WALK_TO_X:
+		_scValue->setInt(_walkToX);
+		return _scValue;
+
+	case SYM_WALK_TO_Y:
+		_scValue->setInt(_walkToY);
+		return _scValue;
+
+	case SYM_X:
+		_scValue->setInt(_posX);
+		return _scValue;
+
+	case SYM_Y:
+		_scValue->setInt(_posY);
+		return _scValue;
+
+	case SYM_ACTIVE:
+		_scValue->setBool(_active);
+		return _scValue;
+
+	default:
+		return AdTalkHolder::scGetSymbolProperty(symbol, name);
+	}
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 bool AdEntity::scSetProperty(const char *name, ScValue *value) {
 
@@ -1141,6 +1141,31 @@ ScValue *AdGame::scGetProperty(const Common::String &name) {
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+ScValue *AdGame::scGetSymbolProperty(TScSymbol symbol, const Common::String &name) {
+	switch (symbol) {
+	case SYM_SCENE:
+		if (_scene) {
+			_scValue->setNative(_scene, true);
+		} else {
+			_scValue->setNULL();
+		}
+		return _scValue;
+
+	case SYM_SELECTED_ITEM:
+		if (_selectedItem) {
+			_scValue->setNative(_selectedItem, true);
+		} else {
+			_scValue->setNULL();
+		}
+		return _scValue;
+
+	default:
+		return BaseGame::scGetSymbolProperty(symbol, name);
+	}
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 bool AdGame::scSetProperty(const char *name, ScValue *value) {
 
@@ -141,6 +141,7 @@ public:
 
 	// scripting interface
 	ScValue *scGetProperty(const Common::String &name) override;
+	ScValue *scGetSymbolProperty(TScSymbol symbol, const Common::String &name) override;
 	bool scSetProperty(const char *name, ScValue *value) override;
 	bool scCallMethod(ScScript *script, ScStack *stack, ScStack *thisStack, const char *name) override;
 	bool validMouse();
@@ -3013,6 +3013,39 @@ ScValue *BaseGame::scGetProperty(const Common::String &name) {
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+ScValue *BaseGame::scGetSymbolProperty(TScSymbol symbol, const Common::String &name) {
+	switch (symbol) {
+	case SYM_CURRENT_TIME:
+		_scValue->setInt((int)getTimer()->getTime());
+		return _scValue;
+
+	case SYM_MOUSE_X:
+		_scValue->setInt(_mousePos.x);
+		return _scValue;
+
+	case SYM_MOUSE_Y:
+		_scValue->setInt(_mousePos.y);
+		return _scValue;
+
+	case SYM_SCREEN_WIDTH:
+		_scValue->setInt(_renderer->getWidth());
+		return _scValue;
+
+	case SYM_SCREEN_HEIGHT:
+		_scValue->setInt(_renderer->getHeight());
+		return _scValue;
+
+	case SYM_INTERACTIVE:
+		_scValue->setBool(_interactive);
+		return _scValue;
+
+	default:
+		return BaseObject::scGetSymbolProperty(symbol, name);
+	}
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 bool BaseGame::scSetProperty(const char *name, ScValue *value) {
 	//////////////////////////////////////////////////////////////////////////
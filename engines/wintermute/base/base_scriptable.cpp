@@ -87,6 +87,12 @@ ScValue *BaseScriptable::scGetProperty(const Common::String &name) {
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+ScValue *BaseScriptable::scGetSymbolProperty(TScSymbol symbol, const Common::String &name) {
+	return scGetProperty(name);
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 bool BaseScriptable::scSetProperty(const char *name, ScValue *value) {
 	if (!_scProp) {
@@ -30,6 +30,7 @@
 
 
 #include "engines/wintermute/base/base_named_object.h"
+#include "engines/wintermute/base/scriptables/dcscript.h"
 #include "engines/wintermute/persistent.h"
 
 namespace Wintermute {
@@ -50,6 +51,10 @@ public:
 	virtual bool canHandleMethod(const char *eventMethod) const;
 	virtual bool scSetProperty(const char *name, ScValue *value);
 	virtual ScValue *scGetProperty(const Common::String &name);
+	// Same as scGetProperty(), for a name interned by the script. Overrides switch
+	// on the symbol before falling back to the name comparisons; they may only
+	// handle the properties none of their subclasses redefine.
+	virtual ScValue *scGetSymbolProperty(TScSymbol symbol, const Common::String &name);
 	virtual bool scCallMethod(ScScript *script, ScStack *stack, ScStack *thisStack, const char *name);
 	virtual const char *scToString();
 	virtual void *scToMemBuffer();
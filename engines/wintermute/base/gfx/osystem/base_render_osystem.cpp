@@ -39,7 +39,9 @@
 #include "common/queue.h"
 #include "common/config-manager.h"
 
-#define DIRTY_RECT_LIMIT 800
+// Above this number of separate dirty rects they get merged into a single one,
+// as the per-rect overhead of going through the render queue grows too large
+#define DIRTY_RECT_LIMIT 16
 
 namespace Wintermute {
 
@@ -56,7 +58,6 @@ BaseRenderOSystem::BaseRenderOSystem(BaseGame *inGame) : BaseRenderer(inGame) {
 
 	_borderLeft = _borderRight = _borderTop = _borderBottom = 0;
 	_ratioX = _ratioY = 1.0f;
-	_dirtyRect = nullptr;
 	_disableDirtyRects = false;
 	if (ConfMan.hasKey("dirty_rects")) {
 		_disableDirtyRects = !ConfMan.getBool("dirty_rects");
@@ -69,13 +70,9 @@ BaseRenderOSystem::BaseRenderOSystem(BaseGame *inGame) : BaseRenderer(inGame) {
 BaseRenderOSystem::~BaseRenderOSystem() {
 	RenderQueueIterator it = _renderQueue.begin();
 	while (it != _renderQueue.end()) {
-		RenderTicket *ticket = *it;
-		it = _renderQueue.erase(it);
-		delete ticket;
+		it = deleteTicket(it);
 	}
 
-	delete _dirtyRect;
-
 	_renderSurface->free();
 	delete _renderSurface;
 }
@@ -148,8 +145,7 @@ bool BaseRenderOSystem::forcedFlip() {
 bool BaseRenderOSystem::flip() {
 	if (_skipThisFrame) {
 		_skipThisFrame = false;
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		_dirtyRects.clear();
 		g_system->updateScreen();
 		_needsFlip = false;
 
@@ -170,9 +166,7 @@ bool BaseRenderOSystem::flip() {
 		RenderQueueIterator it = _renderQueue.begin();
 		while (it != _renderQueue.end()) {
 			if ((*it)->_wantsDraw == false) {
-				RenderTicket *ticket = *it;
-				it = _renderQueue.erase(it);
-				delete ticket;
+				it = deleteTicket(it);
 			} else {
 				(*it)->_wantsDraw = false;
 				++it;
@@ -188,8 +182,7 @@ bool BaseRenderOSystem::flip() {
 		if (_disableDirtyRects || screenChanged) {
 			g_system->copyRectToScreen(_renderSurface->getPixels(), _renderSurface->pitch, 0, 0, _renderSurface->w, _renderSurface->h);
 		}
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		_dirtyRects.clear();
 		_needsFlip = false;
 	}
 	_lastFrameIter = _renderQueue.end();
@@ -256,7 +249,7 @@ Graphics::PixelFormat BaseRenderOSystem::getPixelFormat() const {
 void BaseRenderOSystem::drawSurface(BaseSurfaceOSystem *owner, const Graphics::Surface *surf,
                                     Common::Rect *srcRect, Common::Rect *dstRect, Graphics::TransformStruct &transform) {
 	if (_disableDirtyRects) {
-		RenderTicket *ticket = new RenderTicket(owner, surf, srcRect, dstRect, transform);
+		RenderTicket *ticket = new (_ticketPool) RenderTicket(owner, surf, srcRect, dstRect, transform);
 		ticket->_wantsDraw = true;
 		_renderQueue.push_back(ticket);
 		drawFromSurface(ticket);
@@ -288,7 +281,7 @@ void BaseRenderOSystem::drawSurface(BaseSurfaceOSystem *owner, const Graphics::S
 			}
 		}
 	}
-	RenderTicket *ticket = new RenderTicket(owner, surf, srcRect, dstRect, transform);
+	RenderTicket *ticket = new (_ticketPool) RenderTicket(owner, surf, srcRect, dstRect, transform);
 	if (!_disableDirtyRects) {
 		drawFromTicket(ticket);
 	} else {
@@ -349,13 +342,51 @@ void BaseRenderOSystem::drawFromQueuedTicket(const RenderQueueIterator &ticket)
 	}
 }
 
+BaseRenderOSystem::RenderQueueIterator BaseRenderOSystem::deleteTicket(const RenderQueueIterator &ticket) {
+	RenderTicket *renderTicket = *ticket;
+	RenderQueueIterator next = _renderQueue.erase(ticket);
+	_ticketPool.deleteChunk(renderTicket);
+	return next;
+}
+
+static inline uint32 rectArea(const Common::Rect &rect) {
+	return (uint32)rect.width() * (uint32)rect.height();
+}
+
 void BaseRenderOSystem::addDirtyRect(const Common::Rect &rect) {
-	if (!_dirtyRect) {
-		_dirtyRect = new Common::Rect(rect);
-	} else {
-		_dirtyRect->extend(rect);
+	Common::Rect newRect(rect);
+	newRect.clip(_renderRect);
+	if (newRect.isEmpty()) {
+		return;
+	}
+
+	// Merge with the rects that overlap the new one or lie close enough, that
+	// redrawing the area in between costs less than redrawing them separately.
+	// The merged rect may grow to reach others, so start over after each merge.
+	uint i = 0;
+	while (i < _dirtyRects.size()) {
+		const Common::Rect &dirty = _dirtyRects[i];
+		Common::Rect merged(dirty);
+		merged.extend(newRect);
+		uint32 covered = rectArea(dirty) + rectArea(newRect) - rectArea(dirty.findIntersectingRect(newRect));
+		if (rectArea(merged) - covered <= covered / 4) {
+			newRect = merged;
+			_dirtyRects.remove_at(i);
+			i = 0;
+		} else {
+			++i;
+		}
+	}
+	_dirtyRects.push_back(newRect);
+
+	if (_dirtyRects.size() > DIRTY_RECT_LIMIT) {
+		Common::Rect bounds(_dirtyRects[0]);
+		for (i = 1; i < _dirtyRects.size(); ++i) {
+			bounds.extend(_dirtyRects[i]);
+		}
+		_dirtyRects.clear();
+		_dirtyRects.push_back(bounds);
 	}
-	_dirtyRect->clip(_renderRect);
 }
 
 void BaseRenderOSystem::drawTickets() {
@@ -366,15 +397,13 @@ void BaseRenderOSystem::drawTickets() {
 	// we have a copy of their data, so their invalidness won't affect us.
 	while (it != _renderQueue.end()) {
 		if ((*it)->_wantsDraw == false) {
-			RenderTicket *ticket = *it;
 			addDirtyRect((*it)->_dstRect);
-			it = _renderQueue.erase(it);
-			delete ticket;
+			it = deleteTicket(it);
 		} else {
 			++it;
 		}
 	}
-	if (!_dirtyRect || _dirtyRect->width() == 0 || _dirtyRect->height() == 0) {
+	if (_dirtyRects.empty()) {
 		it = _renderQueue.begin();
 		while (it != _renderQueue.end()) {
 			RenderTicket *ticket = *it;
@@ -384,29 +413,53 @@ void BaseRenderOSystem::drawTickets() {
 		return;
 	}
 
-	it = _renderQueue.begin();
 	_lastFrameIter = _renderQueue.end();
-	// A special case: If the screen has one giant OPAQUE rect to be drawn, then we skip filling
-	// the background color. Typical use-case: Fullscreen FMVs.
-	// Caveat: The FPS-counter will invalidate this.
-	if (it != _lastFrameIter && _renderQueue.front() == _renderQueue.back() && (*it)->_transform._alphaDisable == true) {
-		// If our single opaque rect fills the dirty rect, we can skip filling.
-		if (*_dirtyRect != (*it)->_dstRect) {
-			// Apply the clear-color to the dirty rect.
-			_renderSurface->fillRect(*_dirtyRect, _clearColor);
+	for (uint i = 0; i < _dirtyRects.size(); ++i) {
+		drawDirtyRect(_dirtyRects[i]);
+	}
+	for (it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
+		// Some tickets want redraw but don't actually clip the dirty area (typically the ones that shouldn't become clear-color)
+		(*it)->_wantsDraw = false;
+	}
+
+	it = _renderQueue.begin();
+	// Clean out the old tickets
+	while (it != _renderQueue.end()) {
+		if ((*it)->_isValid == false) {
+			addDirtyRect((*it)->_dstRect);
+			it = deleteTicket(it);
+		} else {
+			++it;
 		}
-		// Otherwise Do NOT fill.
-	} else {
+	}
+
+}
+
+void BaseRenderOSystem::drawDirtyRect(const Common::Rect &dirtyRect) {
+	// Look for the topmost opaque ticket covering the whole dirty rect, going
+	// from front to back. Typical use-case: Fullscreen FMVs and room backgrounds.
+	RenderQueueIterator it = _renderQueue.end();
+	bool occluded = false;
+	while (it != _renderQueue.begin()) {
+		--it;
+		if ((*it)->_dstRect.contains(dirtyRect) && (*it)->isOpaque()) {
+			occluded = true;
+			break;
+		}
+	}
+
+	if (!occluded) {
 		// Apply the clear-color to the dirty rect.
-		_renderSurface->fillRect(*_dirtyRect, _clearColor);
+		it = _renderQueue.begin();
+		_renderSurface->fillRect(dirtyRect, _clearColor);
 	}
 	for (; it != _renderQueue.end(); ++it) {
 		RenderTicket *ticket = *it;
-		if (ticket->_dstRect.intersects(*_dirtyRect)) {
+		if (ticket->_dstRect.intersects(dirtyRect)) {
 			// dstClip is the area we want redrawn.
 			Common::Rect dstClip(ticket->_dstRect);
 			// reduce it to the dirty rect
-			dstClip.clip(*_dirtyRect);
+			dstClip.clip(dirtyRect);
 			// we need to keep track of the position to redraw the dirty rect
 			Common::Rect pos(dstClip);
 			int16 offsetX = ticket->_dstRect.left;
@@ -417,24 +470,8 @@ void BaseRenderOSystem::drawTickets() {
 			drawFromSurface(ticket, &pos, &dstClip);
 			_needsFlip = true;
 		}
-		// Some tickets want redraw but don't actually clip the dirty area (typically the ones that shouldn't become clear-color)
-		ticket->_wantsDraw = false;
-	}
-	g_system->copyRectToScreen(_renderSurface->getBasePtr(_dirtyRect->left, _dirtyRect->top), _renderSurface->pitch, _dirtyRect->left, _dirtyRect->top, _dirtyRect->width(), _dirtyRect->height());
-
-	it = _renderQueue.begin();
-	// Clean out the old tickets
-	while (it != _renderQueue.end()) {
-		if ((*it)->_isValid == false) {
-			RenderTicket *ticket = *it;
-			addDirtyRect((*it)->_dstRect);
-			it = _renderQueue.erase(it);
-			delete ticket;
-		} else {
-			++it;
-		}
 	}
-
+	g_system->copyRectToScreen(_renderSurface->getBasePtr(dirtyRect.left, dirtyRect.top), _renderSurface->pitch, dirtyRect.left, dirtyRect.top, dirtyRect.width(), dirtyRect.height());
 }
 
 // Replacement for SDL2's SDL_RenderCopy
@@ -528,9 +565,7 @@ void BaseRenderOSystem::endSaveLoad() {
 	// Clear the scale-buffered tickets as we just loaded.
 	RenderQueueIterator it = _renderQueue.begin();
 	while (it != _renderQueue.end()) {
-		RenderTicket *ticket = *it;
-		it = _renderQueue.erase(it);
-		delete ticket;
+		it = deleteTicket(it);
 	}
 	// HACK: After a save the buffer will be drawn before the scripts get to update it,
 	// so just skip this single frame.
@@ -29,16 +29,18 @@
 #define WINTERMUTE_BASE_RENDERER_SDL_H
 
 #include "engines/wintermute/base/gfx/base_renderer.h"
+#include "engines/wintermute/base/gfx/osystem/render_ticket.h"
 
 #include "common/rect.h"
 #include "common/list.h"
+#include "common/array.h"
+#include "common/memorypool.h"
 
 #include "graphics/managed_surface.h"
 #include "graphics/transform_struct.h"
 
 namespace Wintermute {
 class BaseSurfaceOSystem;
-class RenderTicket;
 /**
  * A 2D-renderer implementation for WME.
  * This renderer makes use of a "ticket"-system, where all draw-calls
@@ -54,6 +56,11 @@ class RenderTicket;
  * being equal, this information is then used to check whether the draw order changed,
  * which will then create a need for redrawing, as we draw with an alpha-channel here.
  *
+ * The changed areas are collected in a short list of dirty rects, which are merged
+ * together when they overlap or lie close enough that a joint redraw is cheaper.
+ * Each dirty rect is then redrawn separately, starting from the topmost opaque
+ * ticket that covers it completely, since nothing beneath can be visible.
+ *
  * There is also a draw path that draws without tickets, for debugging purposes,
  * as well as to accommodate situations with large enough amounts of draw calls,
  * that there will be too much overhead involved with comparing the generated tickets.
@@ -119,6 +126,18 @@ private:
 	 * @param rect the region to be marked as dirty
 	 */
 	void addDirtyRect(const Common::Rect &rect);
+	/**
+	 * Redraw the tickets inside a single dirty rect, skipping those
+	 * that are hidden by an opaque ticket above them.
+	 * @param dirtyRect the region to be redrawn
+	 */
+	void drawDirtyRect(const Common::Rect &dirtyRect);
+	/**
+	 * Remove a ticket from the render queue and return it to the pool.
+	 * @param ticket iterator pointing to the ticket to be removed.
+	 * @return iterator pointing to the next ticket.
+	 */
+	RenderQueueIterator deleteTicket(const RenderQueueIterator &ticket);
 	/**
 	 * Traverse the tickets that are dirty, and draw them
 	 */
@@ -127,8 +146,9 @@ private:
 	void drawFromSurface(RenderTicket *ticket);
 	// Dirty-rects:
 	void drawFromSurface(RenderTicket *ticket, Common::Rect *dstRect, Common::Rect *clipRect);
-	Common::Rect *_dirtyRect;
+	Common::Array<Common::Rect> _dirtyRects;
 	Common::List<RenderTicket *> _renderQueue;
+	Common::ObjectPool<RenderTicket> _ticketPool;
 
 	bool _needsFlip;
 	RenderQueueIterator _lastFrameIter;
@@ -91,6 +91,22 @@ bool RenderTicket::operator==(const RenderTicket &t) const {
 	return true;
 }
 
+bool RenderTicket::isOpaque() const {
+	// Fade-tickets and tiled, rotated or blended draws may leave the background visible
+	if (!_surface || !_owner ||
+		_transform._angle != Graphics::kDefaultAngle ||
+		_transform._numTimesX * _transform._numTimesY != 1 ||
+		_transform._blendMode != Graphics::BLEND_NORMAL ||
+		(_transform._rgbaMod >> 24) != 0xFF) {
+		return false;
+	}
+	if (_surface->w != _dstRect.width() || _surface->h != _dstRect.height()) {
+		return false;
+	}
+	return _transform._alphaDisable ||
+		(_transform._rgbaMod == Graphics::kDefaultRgbaMod && _owner->getAlphaType() == Graphics::ALPHA_OPAQUE);
+}
+
 // Replacement for SDL2's SDL_RenderCopy
 void RenderTicket::drawToSurface(Graphics::ManagedSurface *_targetSurface) const {
 	if (!getSurface()) {
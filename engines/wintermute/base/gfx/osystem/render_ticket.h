@@ -68,6 +68,11 @@ public:
 
 	BaseSurfaceOSystem *_owner;
 	bool operator==(const RenderTicket &a) const;
+	/**
+	 * Tells whether drawing this ticket completely overwrites its destination
+	 * rect, hiding everything drawn there before.
+	 */
+	bool isOpaque() const;
 	const Common::Rect *getSrcRect() const { return &_srcRect; }
 private:
 	Graphics::Surface *_surface;
@@ -145,6 +145,26 @@ typedef enum {
 	ELEMENT_STRING = 0
 } TElementType;
 
+// interned names of the native object properties scripts read the most,
+// see BaseScriptable::scGetSymbolProperty()
+typedef enum {
+	SYM_NONE = 0,
+	SYM_ACTIVE,
+	SYM_CURRENT_TIME,
+	SYM_DIRECTION,
+	SYM_INTERACTIVE,
+	SYM_MOUSE_X,
+	SYM_MOUSE_Y,
+	SYM_SCENE,
+	SYM_SCREEN_HEIGHT,
+	SYM_SCREEN_WIDTH,
+	SYM_SELECTED_ITEM,
+	SYM_WALK_TO_X,
+	SYM_WALK_TO_Y,
+	SYM_X,
+	SYM_Y
+} TScSymbol;
+
 } // End of namespace Wintermute
 
 #endif
@@ -104,6 +104,10 @@ ScScript::ScScript(BaseGame *inGame, ScEngine *engine) : BaseClass(inGame) {
 
 	_tracingMode = false;
 
+	_varCache = nullptr;
+	_propCache = nullptr;
+	_symbolCache = nullptr;
+
 #ifdef ENABLE_FOXTAIL
 	initOpcodesType();
 #endif
@@ -188,6 +192,10 @@ bool ScScript::initTables() {
 		_symbols[index] = getString();
 	}
 
+	delete[] _varCache;
+	_varCache = new TVarCacheEntry[_numSymbols];
+	memset(_varCache, 0, _numSymbols * sizeof(TVarCacheEntry));
+
 	// load functions table
 	_iP = _header.funcTable;
 
@@ -397,6 +405,15 @@ void ScScript::cleanup() {
 	_symbols = nullptr;
 	_numSymbols = 0;
 
+	delete[] _varCache;
+	_varCache = nullptr;
+
+	delete[] _propCache;
+	_propCache = nullptr;
+
+	delete[] _symbolCache;
+	_symbolCache = nullptr;
+
 	if (_globals && !_thread) {
 		delete _globals;
 	}
@@ -745,7 +762,7 @@ bool ScScript::executeInstruction() {
 		break;
 
 	case II_PUSH_VAR: {
-		ScValue *var = getVar(_symbols[getDWORD()]);
+		ScValue *var = getSymbolVar(getDWORD());
 		// Disabled in original code
 		/*if (false && var->_type==VAL_OBJECT || var->_type == VAL_NATIVE) {
 			_operand->setReference(var);
@@ -757,15 +774,14 @@ bool ScScript::executeInstruction() {
 	}
 
 	case II_PUSH_VAR_REF: {
-		ScValue *var = getVar(_symbols[getDWORD()]);
+		ScValue *var = getSymbolVar(getDWORD());
 		_operand->setReference(var);
 		_stack->push(_operand);
 		break;
 	}
 
 	case II_POP_VAR: {
-		char *varName = _symbols[getDWORD()];
-		ScValue *var = getVar(varName);
+		ScValue *var = getSymbolVar(getDWORD());
 		if (var) {
 			ScValue *val = _stack->pop();
 			if (!val) {
@@ -816,7 +832,7 @@ bool ScScript::executeInstruction() {
 		break;
 
 	case II_PUSH_THIS:
-		_operand->setReference(getVar(_symbols[getDWORD()]));
+		_operand->setReference(getSymbolVar(getDWORD()));
 		_thisStack->push(_operand);
 		break;
 
@@ -826,7 +842,7 @@ bool ScScript::executeInstruction() {
 
 	case II_PUSH_BY_EXP: {
 		str = _stack->pop()->getString();
-		ScValue *val = _stack->pop()->getProp(str);
+		ScValue *val = getPropCached(_stack->pop(), str);
 		if (val) {
 			_stack->push(val);
 		} else {
@@ -845,7 +861,7 @@ bool ScScript::executeInstruction() {
 			runtimeError("Script stack corruption detected. Please report this script at WME bug reports forum.");
 			var->setNULL();
 		} else {
-			var->setProp(str, val);
+			setPropCached(var, str, val);
 		}
 
 		break;
@@ -1218,6 +1234,137 @@ ScValue *ScScript::getVar(char *name) {
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+ScValue *ScScript::getSymbolVar(uint32 symbol) {
+	ScValue *scope = _scopeStack->_sP >= 0 ? _scopeStack->getTop() : nullptr;
+	ScValue *globals = _globals;
+	ScValue *engineGlobals = _engine->_globals;
+
+	// The lookup result only depends on the properties of the searched scopes,
+	// reuse it as long as none of them got a property added or removed
+	bool cacheable = (!scope || scope->hasPlainProps()) && globals->hasPlainProps() && engineGlobals->hasPlainProps();
+	if (!cacheable) {
+		return getVar(_symbols[symbol]);
+	}
+
+	TVarCacheEntry &entry = _varCache[symbol];
+	uint32 scopeVersion = scope ? scope->_propsVersion : 0;
+	if (entry.value && entry.scopeVersion == scopeVersion &&
+	    entry.globalsVersion == globals->_propsVersion &&
+	    entry.engineGlobalsVersion == engineGlobals->_propsVersion) {
+		return entry.value;
+	}
+
+	ScValue *ret = getVar(_symbols[symbol]);
+	// getVar() may have defined the variable, so take the versions afterwards
+	entry.scopeVersion = scope ? scope->_propsVersion : 0;
+	entry.globalsVersion = globals->_propsVersion;
+	entry.engineGlobalsVersion = engineGlobals->_propsVersion;
+	entry.value = ret;
+	return ret;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+ScScript::TPropCacheEntry *ScScript::findPropCacheEntry(ScValue *object, const char *name) {
+	if (!_propCache) {
+		_propCache = new TPropCacheEntry[kPropCacheSize];
+	}
+	// Each II_PUSH_BY_EXP / II_POP_BY_EXP instruction has its own position, which
+	// also serves as the cache key; the name is checked, as it's computed at runtime
+	TPropCacheEntry &entry = _propCache[_iP % kPropCacheSize];
+	if (entry.pos != _iP || entry.objectVersion != object->_propsVersion || entry.name != name) {
+		entry.pos = _iP;
+		entry.objectVersion = object->_propsVersion;
+		entry.name = name;
+		entry.value = object->getProp(name);
+	}
+	return &entry;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+ScValue *ScScript::getPropCached(ScValue *object, const char *name) {
+	while (object->_type == VAL_VARIABLE_REF) {
+		object = object->_valRef;
+	}
+	// Native objects compute their properties on demand
+	if (!object->hasPlainProps()) {
+		return object->getProp(name, object->_type == VAL_NATIVE ? getSymbolCached(name) : SYM_NONE);
+	}
+	return findPropCacheEntry(object, name)->value;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+static TScSymbol lookupSymbol(const char *name) {
+	static const struct {
+		const char *name;
+		TScSymbol symbol;
+	} symbols[] = {
+		{ "Active", SYM_ACTIVE },
+		{ "CurrentTime", SYM_CURRENT_TIME },
+		{ "Direction", SYM_DIRECTION },
+		{ "Interactive", SYM_INTERACTIVE },
+		{ "MouseX", SYM_MOUSE_X },
+		{ "MouseY", SYM_MOUSE_Y },
+		{ "Scene", SYM_SCENE },
+		{ "ScreenHeight", SYM_SCREEN_HEIGHT },
+		{ "ScreenWidth", SYM_SCREEN_WIDTH },
+		{ "SelectedItem", SYM_SELECTED_ITEM },
+		{ "WalkToX", SYM_WALK_TO_X },
+		{ "WalkToY", SYM_WALK_TO_Y },
+		{ "X", SYM_X },
+		{ "Y", SYM_Y }
+	};
+
+	for (uint i = 0; i < ARRAYSIZE(symbols); i++) {
+		if (strcmp(name, symbols[i].name) == 0) {
+			return symbols[i].symbol;
+		}
+	}
+	return SYM_NONE;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+TScSymbol ScScript::getSymbolCached(const char *name) {
+	if (!_symbolCache) {
+		_symbolCache = new TSymbolCacheEntry[kPropCacheSize];
+	}
+	// Interned once per II_PUSH_BY_EXP instruction, so that native objects
+	// switch on the symbol instead of comparing the name to all their properties
+	TSymbolCacheEntry &entry = _symbolCache[_iP % kPropCacheSize];
+	if (entry.pos != _iP || entry.name != name) {
+		entry.pos = _iP;
+		entry.name = name;
+		entry.symbol = lookupSymbol(name);
+	}
+	return entry.symbol;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void ScScript::setPropCached(ScValue *object, const char *name, ScValue *val) {
+	while (object->_type == VAL_VARIABLE_REF) {
+		object = object->_valRef;
+	}
+	if (object->_type != VAL_OBJECT) {
+		object->setProp(name, val);
+		return;
+	}
+	// Assign existing property in place, same as ScValue::setProp() does
+	TPropCacheEntry *entry = findPropCacheEntry(object, name);
+	if (entry->value) {
+		entry->value->cleanup();
+		entry->value->copy(val);
+		entry->value->_isConstVar = false;
+	} else {
+		object->setProp(name, val);
+	}
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 bool ScScript::waitFor(BaseObject *object) {
 	if (_unbreakable) {
@@ -1301,6 +1448,12 @@ bool ScScript::persist(BasePersistenceManager *persistMgr) {
 
 	persistMgr->transferPtr(TMEMBER_PTR(_gameRef));
 
+	if (!persistMgr->getIsSaving()) {
+		_varCache = nullptr;
+		_propCache = nullptr;
+		_symbolCache = nullptr;
+	}
+
 	// buffer
 	if (persistMgr->getIsSaving()) {
 		if (_state != SCRIPT_PERSISTENT && _state != SCRIPT_FINISHED && _state != SCRIPT_THREAD_FINISHED) {
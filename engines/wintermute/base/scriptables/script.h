@@ -79,6 +79,7 @@ public:
 	TScriptState _state;
 	TScriptState _origState;
 	ScValue *getVar(char *name);
+	ScValue *getSymbolVar(uint32 symbol);
 	uint32 getFuncPos(const Common::String &name);
 	uint32 getEventPos(const Common::String &name) const;
 	uint32 getMethodPos(const Common::String &name) const;
@@ -164,6 +165,46 @@ private:
 	bool initScript();
 	bool initTables();
 
+	// Cached result of a variable lookup, one per symbol; valid while
+	// the property sets of the scopes searched by getVar() stay the same
+	typedef struct {
+		uint32 scopeVersion;
+		uint32 globalsVersion;
+		uint32 engineGlobalsVersion;
+		ScValue *value;
+	} TVarCacheEntry;
+
+	// Cached result of a property lookup in a script object,
+	// for the II_PUSH_BY_EXP and II_POP_BY_EXP instructions
+	struct TPropCacheEntry {
+		uint32 pos;
+		uint32 objectVersion;
+		Common::String name;
+		ScValue *value;
+
+		TPropCacheEntry() : pos(0), objectVersion(0), value(nullptr) {}
+	};
+
+	// Interned name of a native object property, for the II_PUSH_BY_EXP instruction
+	struct TSymbolCacheEntry {
+		uint32 pos;
+		Common::String name;
+		TScSymbol symbol;
+
+		TSymbolCacheEntry() : pos(0), symbol(SYM_NONE) {}
+	};
+
+	static const uint32 kPropCacheSize = 32;
+
+	TVarCacheEntry *_varCache;
+	TPropCacheEntry *_propCache;
+	TSymbolCacheEntry *_symbolCache;
+
+	TPropCacheEntry *findPropCacheEntry(ScValue *object, const char *name);
+	ScValue *getPropCached(ScValue *object, const char *name);
+	TScSymbol getSymbolCached(const char *name);
+	void setPropCached(ScValue *object, const char *name, ScValue *val);
+
 	virtual void preInstHook(uint32 inst);
 	virtual void postInstHook(uint32 inst);
 
@@ -53,6 +53,7 @@ ScValue::ScValue(BaseGame *inGame) : BaseClass(inGame) {
 	_valRef = nullptr;
 	_persistent = false;
 	_isConstVar = false;
+	touchProps();
 }
 
 
@@ -68,6 +69,7 @@ ScValue::ScValue(BaseGame *inGame, bool val) : BaseClass(inGame) {
 	_valRef = nullptr;
 	_persistent = false;
 	_isConstVar = false;
+	touchProps();
 }
 
 
@@ -83,6 +85,7 @@ ScValue::ScValue(BaseGame *inGame, int32 val) : BaseClass(inGame) {
 	_valRef = nullptr;
 	_persistent = false;
 	_isConstVar = false;
+	touchProps();
 }
 
 
@@ -98,6 +101,7 @@ ScValue::ScValue(BaseGame *inGame, double val) : BaseClass(inGame) {
 	_valRef = nullptr;
 	_persistent = false;
 	_isConstVar = false;
+	touchProps();
 }
 
 
@@ -114,6 +118,7 @@ ScValue::ScValue(BaseGame *inGame, const char *val) : BaseClass(inGame) {
 	_valRef = nullptr;
 	_persistent = false;
 	_isConstVar = false;
+	touchProps();
 }
 
 
@@ -157,9 +162,9 @@ ScValue::~ScValue() {
 
 
 //////////////////////////////////////////////////////////////////////////
-ScValue *ScValue::getProp(const char *name) {
+ScValue *ScValue::getProp(const char *name, TScSymbol symbol) {
 	if (_type == VAL_VARIABLE_REF) {
-		return _valRef->getProp(name);
+		return _valRef->getProp(name, symbol);
 	}
 
 	if (_type == VAL_STRING && strcmp(name, "Length") == 0) {
@@ -178,7 +183,11 @@ ScValue *ScValue::getProp(const char *name) {
 	ScValue *ret = nullptr;
 
 	if (_type == VAL_NATIVE && _valNative) {
-		ret = _valNative->scGetProperty(name);
+		if (symbol != SYM_NONE) {
+			ret = _valNative->scGetSymbolProperty(symbol, name);
+		} else {
+			ret = _valNative->scGetProperty(name);
+		}
 	}
 
 	if (ret == nullptr) {
@@ -200,6 +209,7 @@ bool ScValue::deleteProp(const char *name) {
 	if (_valIter != _valObject.end()) {
 		delete _valIter->_value;
 		_valIter->_value = nullptr;
+		touchProps();
 	}
 
 	return STATUS_OK;
@@ -227,6 +237,7 @@ bool ScValue::setProp(const char *name, ScValue *val, bool copyWhole, bool setAs
 		}
 		if (!newVal) {
 			newVal = new ScValue(_gameRef);
+			touchProps();
 		} else {
 			newVal->cleanup();
 		}
@@ -258,6 +269,21 @@ bool ScValue::setProp(const char *name, ScValue *val, bool copyWhole, bool setAs
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+bool ScValue::hasPlainProps() const {
+	return _type != VAL_VARIABLE_REF && _type != VAL_NATIVE && _type != VAL_STRING;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void ScValue::touchProps() {
+	// Stamps are taken from a single counter, so they never repeat
+	// between different values either
+	static uint32 lastVersion = 0;
+	_propsVersion = ++lastVersion;
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 bool ScValue::propExists(const char *name) {
 	if (_type == VAL_VARIABLE_REF) {
@@ -277,6 +303,7 @@ void ScValue::deleteProps() {
 		_valIter++;
 	}
 	_valObject.clear();
+	touchProps();
 }
 
 
@@ -742,6 +769,7 @@ void ScValue::copy(ScValue *orig, bool copyWhole) {
 			_valObject[orig->_valIter->_key]->copy(orig->_valIter->_value);
 			orig->_valIter++;
 		}
+		touchProps();
 	} else {
 		_valObject.clear();
 	}
@@ -817,6 +845,7 @@ bool ScValue::persist(BasePersistenceManager *persistMgr) {
 			_valObject[str] = val;
 			delete[] str;
 		}
+		touchProps();
 	}
 
 	persistMgr->transferPtr(TMEMBER_PTR(_valRef));
@@ -81,10 +81,16 @@ public:
 	bool isInt();
 	bool isObject();
 	bool setProp(const char *name, ScValue *val, bool copyWhole = false, bool setAsConst = false);
-	ScValue *getProp(const char *name);
+	ScValue *getProp(const char *name, TScSymbol symbol = SYM_NONE);
+	// Tells if getProp() result depends on the _valObject contents only
+	bool hasPlainProps() const;
+	// Unique stamp of the current set of properties; changes whenever
+	// a property is added or removed, so that lookups may be cached
+	uint32 _propsVersion;
 	BaseScriptable *_valNative;
 	ScValue *_valRef;
 private:
+	void touchProps();
 	bool _valBool;
 	int32 _valInt;
 	double _valFloat;
@@ -117,6 +117,8 @@ struct DrawStep {
 };
 
 VectorRenderer *createRenderer(int mode);
+/** Creates a renderer for surfaces of the given format instead of the overlay format. */
+VectorRenderer *createRenderer(int mode, const PixelFormat &format);
 
 /**
  * VectorRenderer: The core Vector Renderer Class
@@ -548,6 +550,25 @@ public:
 	 */
 	virtual void applyScreenShading(GUI::ThemeEngine::ShadingStyle) = 0;
 
+	/**
+	 * The part of the renderer state which a DrawStep does not always set
+	 * itself, and so may inherit from the steps drawn before it.
+	 */
+	struct InheritedState {
+		uint32 fgColor, bgColor, bevelColor;
+		uint32 gradientStart, gradientEnd;
+		ShadowFillMode shadowFillMode;
+		bool disableShadows;
+
+		bool operator==(const InheritedState &other) const {
+			return fgColor == other.fgColor && bgColor == other.bgColor && bevelColor == other.bevelColor &&
+			       gradientStart == other.gradientStart && gradientEnd == other.gradientEnd &&
+			       shadowFillMode == other.shadowFillMode && disableShadows == other.disableShadows;
+		}
+	};
+
+	virtual void getInheritedState(InheritedState &state) const = 0;
+
 protected:
 	ManagedSurface *_activeSurface; /**< Pointer to the surface currently being drawn */
 
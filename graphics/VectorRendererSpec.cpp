@@ -525,28 +525,31 @@ void colorVFillClip(PixelType *first, PixelType *last, int pitch, PixelType colo
 
 
 VectorRenderer *createRenderer(int mode) {
+	return createRenderer(mode, g_system->getOverlayFormat());
+}
+
+VectorRenderer *createRenderer(int mode, const PixelFormat &format) {
 #ifdef DISABLE_FANCY_THEMES
 	assert(mode == GUI::ThemeEngine::kGfxStandard);
 #endif
 
-	PixelFormat format = g_system->getOverlayFormat();
 	switch (mode) {
 	case GUI::ThemeEngine::kGfxStandard:
-		if (g_system->getOverlayFormat().bytesPerPixel == 4)
+		if (format.bytesPerPixel == 4)
 			return new VectorRendererSpec<uint32>(format);
-		else if (g_system->getOverlayFormat().bytesPerPixel == 2)
+		else if (format.bytesPerPixel == 2)
 			return new VectorRendererSpec<uint16>(format);
-		else if (g_system->getOverlayFormat().bytesPerPixel == 1)
+		else if (format.bytesPerPixel == 1)
 			return new VectorRendererSpec<uint8>(format);
 		break;
 #ifndef DISABLE_FANCY_THEMES
 	case GUI::ThemeEngine::kGfxAntialias:
-		if (g_system->getOverlayFormat().bytesPerPixel == 4)
+		if (format.bytesPerPixel == 4)
 			return new VectorRendererAA<uint32>(format);
-		else if (g_system->getOverlayFormat().bytesPerPixel == 2)
+		else if (format.bytesPerPixel == 2)
 			return new VectorRendererAA<uint16>(format);
 		// No AA with 8-bit
-		else if (g_system->getOverlayFormat().bytesPerPixel == 1)
+		else if (format.bytesPerPixel == 1)
 			return new VectorRendererSpec<uint8>(format);
 		break;
 #endif
@@ -810,6 +813,18 @@ blitManagedSurface(const Graphics::ManagedSurface *source, const Common::Point &
 	}
 }
 
+template<typename PixelType>
+void VectorRendererSpec<PixelType>::
+getInheritedState(InheritedState &state) const {
+	state.fgColor = _fgColor;
+	state.bgColor = _bgColor;
+	state.bevelColor = _bevelColor;
+	state.gradientStart = _gradientStart;
+	state.gradientEnd = _gradientEnd;
+	state.shadowFillMode = Base::_shadowFillMode;
+	state.disableShadows = Base::_disableShadows;
+}
+
 template<typename PixelType>
 void VectorRendererSpec<PixelType>::
 applyScreenShading(GUI::ThemeEngine::ShadingStyle shadingStyle) {
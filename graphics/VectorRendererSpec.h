@@ -92,6 +92,8 @@ public:
 
 	void applyScreenShading(GUI::ThemeEngine::ShadingStyle shadingStyle) override;
 
+	void getInheritedState(InheritedState &state) const override;
+
 protected:
 
 	Common::Rect _clippingArea;
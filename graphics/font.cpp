@@ -120,6 +120,10 @@ void drawStringImpl(const Font &font, SurfaceType *dst, const StringType &str, i
 		x = x + w - width;
 	x += deltax;
 
+	// The characters are handed to the font in runs, so it can draw them all at once
+	PositionedChar run[64];
+	uint count = 0;
+
 	typename StringType::unsigned_type last = 0;
 	for (typename StringType::const_iterator i = str.begin(), end = str.end(); i != end; ++i) {
 		const typename StringType::unsigned_type cur = *i;
@@ -130,14 +134,19 @@ void drawStringImpl(const Font &font, SurfaceType *dst, const StringType &str, i
 		if (x + charBox.right > rightX)
 			break;
 		if (x + charBox.right >= leftX) {
-			if (alpha)
-				font.drawAlphaChar(dst, cur, x, y, color);
-			else
-				font.drawChar(dst, cur, x, y, color);
+			run[count].chr = cur;
+			run[count].x = x;
+			if (++count == ARRAYSIZE(run)) {
+				font.drawChars(dst, run, count, y, color, alpha);
+				count = 0;
+			}
 		}
 
 		x += font.getCharWidth(cur);
 	}
+
+	if (count)
+		font.drawChars(dst, run, count, y, color, alpha);
 }
 
 template<class StringType>
@@ -494,6 +503,24 @@ void Font::drawAlphaChar(ManagedSurface *dst, uint32 chr, int x, int y, uint32 c
 	dst->addDirtyRect(charBox);
 }
 
+void Font::drawChars(Surface *dst, const PositionedChar *chars, uint count, int y, uint32 color, bool alpha) const {
+	for (uint i = 0; i < count; i++) {
+		if (alpha)
+			drawAlphaChar(dst, chars[i].chr, chars[i].x, y, color);
+		else
+			drawChar(dst, chars[i].chr, chars[i].x, y, color);
+	}
+}
+
+void Font::drawChars(ManagedSurface *dst, const PositionedChar *chars, uint count, int y, uint32 color, bool alpha) const {
+	for (uint i = 0; i < count; i++) {
+		if (alpha)
+			drawAlphaChar(dst, chars[i].chr, chars[i].x, y, color);
+		else
+			drawChar(dst, chars[i].chr, chars[i].x, y, color);
+	}
+}
+
 void Font::drawString(Surface *dst, const Common::String &str, int x, int y, int w, uint32 color, TextAlign align, int deltax, bool useEllipsis) const {
 	Common::String renderStr = useEllipsis ? handleEllipsis(*this, str, w) : str;
 	drawStringImpl(*this, dst, renderStr, x, y, w, color, align, deltax, false);
@@ -74,6 +74,12 @@ enum WordWrapMode {
  */
 TextAlign convertTextAlignH(TextAlign alignH, bool rtl);
 
+/** A character of a string, and the x coordinate at which drawString() draws it. */
+struct PositionedChar {
+	uint32 chr;
+	int x;
+};
+
 /**
  * Instances of this class represent a distinct font, with a built-in renderer.
  *
@@ -241,6 +247,23 @@ public:
 	virtual void drawAlphaChar(Surface *dst, uint32 chr, int x, int y, uint32 color) const;
 	virtual void drawAlphaChar(ManagedSurface *dst, uint32 chr, int x, int y, uint32 color) const;
 
+	/**
+	 * Draw a run of characters on one line, as laid out by drawString().
+	 *
+	 * The default implementation calls drawChar(), or drawAlphaChar() if
+	 * @p alpha is set, for each character. Fonts can override this to draw
+	 * the whole run at once.
+	 *
+	 * @param dst   The surface to draw on.
+	 * @param chars The characters to draw, and where to draw them.
+	 * @param count Number of characters in @p chars.
+	 * @param y     The y coordinate where to draw the characters.
+	 * @param color The color of the characters.
+	 * @param alpha Whether to store the alpha channel, see drawAlphaChar().
+	 */
+	virtual void drawChars(Surface *dst, const PositionedChar *chars, uint count, int y, uint32 color, bool alpha) const;
+	virtual void drawChars(ManagedSurface *dst, const PositionedChar *chars, uint count, int y, uint32 color, bool alpha) const;
+
 	/** @overload */
 
 	/**
@@ -87,8 +87,56 @@ inline int divRoundToNearest(int dividend, int divisor) {
 	return (dividend + (divisor / 2)) / divisor;
 }
 
+/** Width and height of the glyph cache pages. */
+const int kGlyphPageSize = 256;
+
+const uint32 kDefaultGlyphCacheBudget = 4 * 1024 * 1024;
+
 } // End of anonymous namespace
 
+class TTFFont;
+
+/**
+ * A surface holding rendered glyphs of one font. The glyphs are packed into
+ * shelves, rows as high as their highest glyph, from top to bottom.
+ */
+struct TTFGlyphPage {
+	TTFGlyphPage(const TTFFont *owner_, int w, int h)
+		: owner(owner_), shelfX(0), shelfY(0), shelfHeight(0), lastUse(0) {
+		surface.create(w, h, PixelFormat::createFormatCLUT8());
+	}
+
+	~TTFGlyphPage() {
+		surface.free();
+	}
+
+	/** Find room for a glyph, returns false if the page is full. */
+	bool allocate(int w, int h, int &x, int &y) {
+		if (shelfX + w > surface.w) {
+			shelfX = 0;
+			shelfY += shelfHeight;
+			shelfHeight = 0;
+		}
+
+		if (w > surface.w || shelfY + h > surface.h)
+			return false;
+
+		x = shelfX;
+		y = shelfY;
+		shelfX += w;
+		shelfHeight = MAX(shelfHeight, h);
+		return true;
+	}
+
+	uint32 getSize() const { return surface.pitch * surface.h; }
+
+	const TTFFont *owner;
+	Surface surface;
+	int shelfX, shelfY, shelfHeight;
+	uint32 lastUse;               ///< Use count of the last time a glyph of this page was drawn
+	Common::Array<uint32> chars;  ///< Keys of the glyphs rendered into this page, see TTFFont::_glyphs
+};
+
 class TTFLibrary : public Common::Singleton<TTFLibrary> {
 public:
 	TTFLibrary();
@@ -101,10 +149,31 @@ public:
 
 	bool loadFont(Common::SeekableReadStream *ttfFile, FT_Stream stream, const int32 face_index, FT_Face &face);
 	void closeFont(FT_Face &face);
+
+	/**
+	 * Add a glyph page to the cache budget. The least recently used pages
+	 * of all fonts are dropped first if the new page does not fit.
+	 */
+	void addGlyphPage(TTFGlyphPage *page);
+	void removeGlyphPage(TTFGlyphPage *page);
+
+	void setGlyphCacheBudget(uint32 bytes);
+	TTFGlyphCacheStats &getGlyphCacheStats() { return _glyphCacheStats; }
+
+	/** Start drawing a run of glyphs, the pages used by it are the most recently used. */
+	void nextGlyphUse() { _glyphUse++; }
+	uint32 getGlyphUse() const { return _glyphUse; }
+
 private:
 	FT_Library _library;
 	bool _initialized;
 
+	Common::Array<TTFGlyphPage *> _glyphPages;
+	TTFGlyphCacheStats _glyphCacheStats;
+	uint32 _glyphUse;
+
+	void trimGlyphCache(uint32 room);
+
 	static unsigned long readCallback(FT_Stream stream, unsigned long offset, unsigned char *buffer, unsigned long count);
 };
 
@@ -114,9 +183,15 @@ void shutdownTTF() {
 
 #define g_ttf ::Graphics::TTFLibrary::instance()
 
-TTFLibrary::TTFLibrary() : _library(), _initialized(false) {
+TTFLibrary::TTFLibrary() : _library(), _initialized(false), _glyphUse(0) {
 	if (!FT_Init_FreeType(&_library))
 		_initialized = true;
+
+	_glyphCacheStats.hits = 0;
+	_glyphCacheStats.misses = 0;
+	_glyphCacheStats.evictions = 0;
+	_glyphCacheStats.size = 0;
+	_glyphCacheStats.budget = kDefaultGlyphCacheBudget;
 }
 
 TTFLibrary::~TTFLibrary() {
@@ -182,6 +257,12 @@ public:
 	void drawAlphaChar(Surface *dst, uint32 chr, int x, int y, uint32 color) const override;
 	void drawAlphaChar(ManagedSurface *dst, uint32 chr, int x, int y, uint32 color) const override;
 
+	void drawChars(Surface *dst, const PositionedChar *chars, uint count, int y, uint32 color, bool alpha) const override;
+	void drawChars(ManagedSurface *dst, const PositionedChar *chars, uint count, int y, uint32 color, bool alpha) const override;
+
+	/** Forget the glyphs rendered into a page, and delete it. */
+	void dropGlyphPage(TTFGlyphPage *page) const;
+
 private:
 	bool _initialized;
 	FT_StreamRec_ _stream;
@@ -194,15 +275,25 @@ private:
 	int _ascent, _descent;
 
 	struct Glyph {
-		Surface image;
 		int xOffset, yOffset;
 		int advance;
 		FT_UInt slot;
+		int width, height;      ///< Size of the rendered glyph
+		TTFGlyphPage *page;     ///< Page holding the rendered glyph, nullptr if it was dropped
+		int pageX, pageY;       ///< Position of the rendered glyph in its page
 	};
 
-	bool cacheGlyph(Glyph &glyph, uint32 chr) const;
+	/**
+	 * Render the glyph of the character chr, which is stored in _glyphs
+	 * under key. The two differ for fonts loaded with a character mapping.
+	 */
+	bool cacheGlyph(Glyph &glyph, uint32 key, uint32 chr) const;
+	bool renderGlyphToPage(Glyph &glyph, uint32 key) const;
+	uint8 *allocateGlyph(Glyph &glyph, uint32 key) const;
+	const uint8 *getGlyphPixels(Glyph &glyph, uint32 key) const;
 	typedef Common::HashMap<uint32, Glyph> GlyphCache;
 	mutable GlyphCache _glyphs;
+	mutable Common::Array<TTFGlyphPage *> _glyphPages;
 	bool _allowLateCaching;
 	void assureCached(uint32 chr) const;
 
@@ -211,7 +302,9 @@ private:
 	int computePointSize(int size, TTFSizeMode sizeMode) const;
 	int readPointSizeFromVDMXTable(int height) const;
 	int computePointSizeFromHeaders(int height) const;
-	void drawCharIntern(Surface *dst, uint32 chr, int x, int y, uint32 color,
+	void drawCharsIntern(Surface *dst, const PositionedChar *chars, uint count, int y, uint32 color,
+		const uint32 *transparentColor, bool alpha, Common::Rect *bounds) const;
+	void drawGlyph(Surface *dst, Glyph &glyph, uint32 chr, int x, int y, uint32 color,
 		const uint32 *transparentColor, bool alpha) const;
 
 	FT_Int32 _loadFlags;
@@ -230,18 +323,26 @@ TTFFont::TTFFont()
 }
 
 TTFFont::~TTFFont() {
+	// shutdownTTF() already released the faces along with the library, and
+	// the glyph cache budget along with it
+	const bool hasLibrary = TTFLibrary::hasInstance();
+
 	if (_initialized) {
-		g_ttf.closeFont(_face);
+		if (hasLibrary)
+			g_ttf.closeFont(_face);
 
 		if (_disposeAfterUse == DisposeAfterUse::YES)
 			delete _ttfFile;
 		_ttfFile = 0;
 
-		for (GlyphCache::iterator i = _glyphs.begin(), end = _glyphs.end(); i != end; ++i)
-			i->_value.image.free();
-
 		_initialized = false;
 	}
+
+	for (uint i = 0; i < _glyphPages.size(); i++) {
+		if (hasLibrary)
+			g_ttf.removeGlyphPage(_glyphPages[i]);
+		delete _glyphPages[i];
+	}
 }
 
 
@@ -368,7 +469,7 @@ bool TTFFont::load(Common::SeekableReadStream *ttfFile, DisposeAfterUse::Flag di
 
 		// Load all ISO-8859-1 characters.
 		for (uint i = 0; i < 256; ++i) {
-			if (!cacheGlyph(_glyphs[i], i)) {
+			if (!cacheGlyph(_glyphs[i], i, i)) {
 				_glyphs.erase(i);
 			}
 		}
@@ -381,7 +482,7 @@ bool TTFFont::load(Common::SeekableReadStream *ttfFile, DisposeAfterUse::Flag di
 			const bool isRequired = (mapping[i] & 0x80000000) != 0;
 			// Check whether loading an important glyph fails and error out if
 			// that is the case.
-			if (!cacheGlyph(_glyphs[i], unicode)) {
+			if (!cacheGlyph(_glyphs[i], i, unicode)) {
 				_glyphs.erase(i);
 				if (isRequired) {
 					g_ttf.closeFont(_face);
@@ -594,10 +695,8 @@ Common::Rect TTFFont::getBoundingBox(uint32 chr) const {
 	if (glyphEntry == _glyphs.end()) {
 		return Common::Rect();
 	} else {
-		const int xOffset = glyphEntry->_value.xOffset;
-		const int yOffset = glyphEntry->_value.yOffset;
-		const Graphics::Surface &image = glyphEntry->_value.image;
-		return Common::Rect(xOffset, yOffset, xOffset + image.w, yOffset + image.h);
+		const Glyph &glyph = glyphEntry->_value;
+		return Common::Rect(glyph.xOffset, glyph.yOffset, glyph.xOffset + glyph.width, glyph.yOffset + glyph.height);
 	}
 }
 
@@ -673,43 +772,69 @@ static void renderAlphaGlyph(uint8 *dstPos, const int dstPitch, const uint8 *src
 } // End of anonymous namespace
 
 void TTFFont::drawChar(Surface *dst, uint32 chr, int x, int y, uint32 color) const {
-	drawCharIntern(dst, chr, x, y, color, nullptr, false);
+	const PositionedChar positioned = { chr, x };
+	drawCharsIntern(dst, &positioned, 1, y, color, nullptr, false, nullptr);
 }
 
 void TTFFont::drawChar(ManagedSurface *dst, uint32 chr, int x, int y, uint32 color) const {
-	if (dst->hasTransparentColor()) {
-		uint32 transColor = dst->getTransparentColor();
-		drawCharIntern(dst->surfacePtr(), chr, x, y, color, &transColor, false);
-	} else {
-		drawCharIntern(dst->surfacePtr(), chr, x, y, color, nullptr, false);
-	}
-
-	Common::Rect charBox = getBoundingBox(chr);
-	charBox.translate(x, y);
-	dst->addDirtyRect(charBox);
+	const PositionedChar positioned = { chr, x };
+	drawChars(dst, &positioned, 1, y, color, false);
 }
 
 void TTFFont::drawAlphaChar(Surface *dst, uint32 chr, int x, int y, uint32 color) const {
-	drawCharIntern(dst, chr, x, y, color, nullptr, true);
+	const PositionedChar positioned = { chr, x };
+	drawCharsIntern(dst, &positioned, 1, y, color, nullptr, true, nullptr);
 }
 
 void TTFFont::drawAlphaChar(ManagedSurface *dst, uint32 chr, int x, int y, uint32 color) const {
-	drawCharIntern(dst->surfacePtr(), chr, x, y, color, nullptr, true);
+	const PositionedChar positioned = { chr, x };
+	drawChars(dst, &positioned, 1, y, color, true);
+}
 
-	Common::Rect charBox = getBoundingBox(chr);
-	charBox.translate(x, y);
-	dst->addDirtyRect(charBox);
+void TTFFont::drawChars(Surface *dst, const PositionedChar *chars, uint count, int y, uint32 color, bool alpha) const {
+	drawCharsIntern(dst, chars, count, y, color, nullptr, alpha, nullptr);
 }
 
-void TTFFont::drawCharIntern(Surface * dst, uint32 chr, int x, int y, uint32 color,
-		const uint32 *transparentColor, bool alpha) const {
-	assureCached(chr);
-	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
-	if (glyphEntry == _glyphs.end())
-		return;
+void TTFFont::drawChars(ManagedSurface *dst, const PositionedChar *chars, uint count, int y, uint32 color, bool alpha) const {
+	Common::Rect bounds;
+	if (!alpha && dst->hasTransparentColor()) {
+		uint32 transColor = dst->getTransparentColor();
+		drawCharsIntern(dst->surfacePtr(), chars, count, y, color, &transColor, alpha, &bounds);
+	} else {
+		drawCharsIntern(dst->surfacePtr(), chars, count, y, color, nullptr, alpha, &bounds);
+	}
+
+	if (!bounds.isEmpty())
+		dst->addDirtyRect(bounds);
+}
 
-	const Glyph &glyph = glyphEntry->_value;
+void TTFFont::drawCharsIntern(Surface *dst, const PositionedChar *chars, uint count, int y, uint32 color,
+		const uint32 *transparentColor, bool alpha, Common::Rect *bounds) const {
+	g_ttf.nextGlyphUse();
+
+	for (uint i = 0; i < count; i++) {
+		const uint32 chr = chars[i].chr;
+		assureCached(chr);
+		GlyphCache::iterator glyphEntry = _glyphs.find(chr);
+		if (glyphEntry == _glyphs.end())
+			continue;
+
+		Glyph &glyph = glyphEntry->_value;
+		if (bounds && glyph.width && glyph.height) {
+			const Common::Rect charBox(chars[i].x + glyph.xOffset, y + glyph.yOffset,
+			                           chars[i].x + glyph.xOffset + glyph.width, y + glyph.yOffset + glyph.height);
+			if (bounds->isEmpty())
+				*bounds = charBox;
+			else
+				bounds->extend(charBox);
+		}
 
+		drawGlyph(dst, glyph, chr, chars[i].x, y, color, transparentColor, alpha);
+	}
+}
+
+void TTFFont::drawGlyph(Surface *dst, Glyph &glyph, uint32 chr, int x, int y, uint32 color,
+		const uint32 *transparentColor, bool alpha) const {
 	x += glyph.xOffset;
 	y += glyph.yOffset;
 
@@ -718,14 +843,13 @@ void TTFFont::drawCharIntern(Surface * dst, uint32 chr, int x, int y, uint32 col
 	if (y > dst->h)
 		return;
 
-	int w = glyph.image.w;
-	int h = glyph.image.h;
-
-	const uint8 *srcPos = (const uint8 *)glyph.image.getPixels();
+	int w = glyph.width;
+	int h = glyph.height;
+	int srcX = 0, srcY = 0;
 
 	// Make sure we are not drawing outside the screen bounds
 	if (x < 0) {
-		srcPos -= x;
+		srcX -= x;
 		w += x;
 		x = 0;
 	}
@@ -737,7 +861,7 @@ void TTFFont::drawCharIntern(Surface * dst, uint32 chr, int x, int y, uint32 col
 		return;
 
 	if (y < 0) {
-		srcPos -= y * glyph.image.pitch;
+		srcY -= y;
 		h += y;
 		y = 0;
 	}
@@ -748,15 +872,21 @@ void TTFFont::drawCharIntern(Surface * dst, uint32 chr, int x, int y, uint32 col
 	if (h <= 0)
 		return;
 
+	const uint8 *srcPos = getGlyphPixels(glyph, chr);
+	if (!srcPos)
+		return;
+
+	const int srcPitch = glyph.page->surface.pitch;
+	srcPos += srcY * srcPitch + srcX;
 	uint8 *dstPos = (uint8 *)dst->getBasePtr(x, y);
 
 	if (alpha) {
 		if (dst->format.bytesPerPixel == 1) {
-			renderAlphaGlyph<uint8>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format);
+			renderAlphaGlyph<uint8>(dstPos, dst->pitch, srcPos, srcPitch, w, h, color, dst->format);
 		} else if (dst->format.bytesPerPixel == 2) {
-			renderAlphaGlyph<uint16>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format);
+			renderAlphaGlyph<uint16>(dstPos, dst->pitch, srcPos, srcPitch, w, h, color, dst->format);
 		} else if (dst->format.bytesPerPixel == 4) {
-			renderAlphaGlyph<uint32>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format);
+			renderAlphaGlyph<uint32>(dstPos, dst->pitch, srcPos, srcPitch, w, h, color, dst->format);
 		}
 	} else {
 		if (dst->format.isCLUT8()) {
@@ -775,24 +905,84 @@ void TTFFont::drawCharIntern(Surface * dst, uint32 chr, int x, int y, uint32 col
 				}
 
 				dstPos += dst->pitch;
-				srcPos += glyph.image.pitch;
+				srcPos += srcPitch;
 			}
 		} else if (dst->format.bytesPerPixel == 1) {
-			renderGlyph<uint8>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format, transparentColor);
+			renderGlyph<uint8>(dstPos, dst->pitch, srcPos, srcPitch, w, h, color, dst->format, transparentColor);
 		} else if (dst->format.bytesPerPixel == 2) {
-			renderGlyph<uint16>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format, transparentColor);
+			renderGlyph<uint16>(dstPos, dst->pitch, srcPos, srcPitch, w, h, color, dst->format, transparentColor);
 		} else if (dst->format.bytesPerPixel == 4) {
-			renderGlyph<uint32>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format, transparentColor);
+			renderGlyph<uint32>(dstPos, dst->pitch, srcPos, srcPitch, w, h, color, dst->format, transparentColor);
 		}
 	}
 }
 
-bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
+const uint8 *TTFFont::getGlyphPixels(Glyph &glyph, uint32 key) const {
+	TTFGlyphCacheStats &stats = g_ttf.getGlyphCacheStats();
+
+	if (glyph.page) {
+		stats.hits++;
+	} else {
+		// The page of the glyph was dropped, render it again
+		stats.misses++;
+		if (!renderGlyphToPage(glyph, key) || !glyph.page)
+			return nullptr;
+	}
+
+	glyph.page->lastUse = g_ttf.getGlyphUse();
+	return (const uint8 *)glyph.page->surface.getBasePtr(glyph.pageX, glyph.pageY);
+}
+
+uint8 *TTFFont::allocateGlyph(Glyph &glyph, uint32 key) const {
+	TTFGlyphPage *page = _glyphPages.empty() ? nullptr : _glyphPages.back();
+	int x = 0, y = 0;
+
+	if (!page || !page->allocate(glyph.width, glyph.height, x, y)) {
+		// Glyphs larger than a page get a page of their own
+		page = new TTFGlyphPage(this, MAX(kGlyphPageSize, glyph.width), MAX(kGlyphPageSize, glyph.height));
+		g_ttf.addGlyphPage(page);
+		_glyphPages.push_back(page);
+
+		page->allocate(glyph.width, glyph.height, x, y);
+	}
+
+	page->chars.push_back(key);
+	glyph.page = page;
+	glyph.pageX = x;
+	glyph.pageY = y;
+	return (uint8 *)page->surface.getBasePtr(x, y);
+}
+
+void TTFFont::dropGlyphPage(TTFGlyphPage *page) const {
+	for (uint i = 0; i < page->chars.size(); i++) {
+		GlyphCache::iterator glyphEntry = _glyphs.find(page->chars[i]);
+		if (glyphEntry != _glyphs.end() && glyphEntry->_value.page == page)
+			glyphEntry->_value.page = nullptr;
+	}
+
+	for (uint i = 0; i < _glyphPages.size(); i++) {
+		if (_glyphPages[i] == page) {
+			_glyphPages.remove_at(i);
+			break;
+		}
+	}
+
+	delete page;
+}
+
+bool TTFFont::cacheGlyph(Glyph &glyph, uint32 key, uint32 chr) const {
 	FT_UInt slot = FT_Get_Char_Index(_face, chr);
 	if (!slot)
 		return false;
 
 	glyph.slot = slot;
+	glyph.page = nullptr;
+
+	return renderGlyphToPage(glyph, key);
+}
+
+bool TTFFont::renderGlyphToPage(Glyph &glyph, uint32 key) const {
+	const FT_UInt slot = glyph.slot;
 
 	// We use the light target and render mode to improve the looks of the
 	// glyphs. It is most noticeable in FreeSansBold.ttf, where otherwise the
@@ -851,8 +1041,23 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 		bitmap = &_face->glyph->bitmap;
 	}
 
+	if (bitmap->pixel_mode != FT_PIXEL_MODE_MONO && bitmap->pixel_mode != FT_PIXEL_MODE_GRAY) {
+		warning("TTFFont::cacheGlyph: Unsupported pixel mode %d", bitmap->pixel_mode);
+		return false;
+	}
 
-	glyph.image.create(bitmap->width, bitmap->rows, PixelFormat::createFormatCLUT8());
+	glyph.width = bitmap->width;
+	glyph.height = bitmap->rows;
+	glyph.page = nullptr;
+
+	if (!glyph.width || !glyph.height) {
+#if FAKE_BOLD == 1
+		if (_fakeBold) {
+			FT_Bitmap_Done(_face->glyph->library, &ownBitmap);
+		}
+#endif
+		return true;
+	}
 
 	const uint8 *src = bitmap->buffer;
 	int srcPitch = bitmap->pitch;
@@ -861,10 +1066,10 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 		srcPitch = -srcPitch;
 	}
 
-	uint8 *dst = (uint8 *)glyph.image.getPixels();
+	uint8 *dst = allocateGlyph(glyph, key);
+	const int dstPitch = glyph.page->surface.pitch;
 
-	switch (bitmap->pixel_mode) {
-	case FT_PIXEL_MODE_MONO:
+	if (bitmap->pixel_mode == FT_PIXEL_MODE_MONO) {
 		for (int y = 0; y < (int)bitmap->rows; ++y) {
 			const uint8 *curSrc = src;
 			uint8 mask = 0;
@@ -873,29 +1078,20 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 				if ((x % 8) == 0)
 					mask = *curSrc++;
 
-				if (mask & 0x80)
-					*dst = 255;
+				dst[x] = (mask & 0x80) ? 255 : 0;
 
 				mask <<= 1;
-				++dst;
 			}
 
+			dst += dstPitch;
 			src += srcPitch;
 		}
-		break;
-
-	case FT_PIXEL_MODE_GRAY:
+	} else {
 		for (int y = 0; y < (int)bitmap->rows; ++y) {
 			memcpy(dst, src, bitmap->width);
-			dst += glyph.image.pitch;
+			dst += dstPitch;
 			src += srcPitch;
 		}
-		break;
-
-	default:
-		warning("TTFFont::cacheGlyph: Unsupported pixel mode %d", bitmap->pixel_mode);
-		glyph.image.free();
-		return false;
 	}
 
 #if FAKE_BOLD == 1
@@ -913,11 +1109,66 @@ void TTFFont::assureCached(uint32 chr) const {
 	}
 
 	Glyph newGlyph;
-	if (cacheGlyph(newGlyph, chr)) {
+	if (cacheGlyph(newGlyph, chr, chr)) {
 		_glyphs[chr] = newGlyph;
 	}
 }
 
+void TTFLibrary::addGlyphPage(TTFGlyphPage *page) {
+	trimGlyphCache(page->getSize());
+
+	page->lastUse = _glyphUse;
+	_glyphPages.push_back(page);
+	_glyphCacheStats.size += page->getSize();
+}
+
+void TTFLibrary::removeGlyphPage(TTFGlyphPage *page) {
+	for (uint i = 0; i < _glyphPages.size(); i++) {
+		if (_glyphPages[i] == page) {
+			_glyphPages.remove_at(i);
+			_glyphCacheStats.size -= page->getSize();
+			break;
+		}
+	}
+}
+
+void TTFLibrary::setGlyphCacheBudget(uint32 bytes) {
+	_glyphCacheStats.budget = bytes;
+	trimGlyphCache(0);
+}
+
+void TTFLibrary::trimGlyphCache(uint32 room) {
+	while (!_glyphPages.empty() && _glyphCacheStats.size + room > _glyphCacheStats.budget) {
+		uint oldest = 0;
+		for (uint i = 1; i < _glyphPages.size(); i++) {
+			if (_glyphPages[i]->lastUse < _glyphPages[oldest]->lastUse)
+				oldest = i;
+		}
+
+		TTFGlyphPage *page = _glyphPages[oldest];
+		_glyphPages.remove_at(oldest);
+		_glyphCacheStats.size -= page->getSize();
+		_glyphCacheStats.evictions++;
+
+		page->owner->dropGlyphPage(page);
+	}
+}
+
+void setTTFGlyphCacheBudget(uint32 bytes) {
+	g_ttf.setGlyphCacheBudget(bytes);
+}
+
+void getTTFGlyphCacheStats(TTFGlyphCacheStats &stats) {
+	stats = g_ttf.getGlyphCacheStats();
+}
+
+void resetTTFGlyphCacheStats() {
+	TTFGlyphCacheStats &stats = g_ttf.getGlyphCacheStats();
+	stats.hits = 0;
+	stats.misses = 0;
+	stats.evictions = 0;
+}
+
 Font *loadTTFFont(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse, int size, TTFSizeMode sizeMode, uint xdpi, uint ydpi, TTFRenderMode renderMode, const uint32 *mapping, bool stemDarkening) {
 	TTFFont *font = new TTFFont();
 
@@ -142,6 +142,38 @@ Font *loadTTFFontFromArchive(const Common::String &filename, int size, TTFSizeMo
  */
 Font *findTTFace(const Common::Array<Common::Path> &files, const Common::U32String &faceName, bool bold, bool italic, int size, uint xdpi = 0, uint ydpi = 0,TTFRenderMode renderMode = kTTFRenderModeLight, const uint32 *mapping = 0);
 
+/**
+ * Statistics of the glyph cache shared by all TTF fonts.
+ */
+struct TTFGlyphCacheStats {
+	uint32 hits;      ///< Glyphs drawn from the cache
+	uint32 misses;    ///< Glyphs which had to be rendered again to be drawn
+	uint32 evictions; ///< Cache pages dropped to stay within the budget
+	uint32 size;      ///< Bytes used by the cache pages
+	uint32 budget;    ///< Bytes the cache pages may use, see setTTFGlyphCacheBudget()
+};
+
+/**
+ * Sets how much memory the rendered glyphs of all TTF fonts may use.
+ *
+ * The glyphs are kept in pages, and the least recently used pages are
+ * dropped when this is exceeded. Dropped glyphs are rendered again when
+ * they are drawn the next time.
+ *
+ * @param bytes The budget in bytes.
+ */
+void setTTFGlyphCacheBudget(uint32 bytes);
+
+/**
+ * Gets the statistics of the glyph cache shared by all TTF fonts.
+ */
+void getTTFGlyphCacheStats(TTFGlyphCacheStats &stats);
+
+/**
+ * Resets the hit, miss and eviction counters of the glyph cache.
+ */
+void resetTTFGlyphCacheStats();
+
 void shutdownTTF();
 
 } // End of namespace Graphics
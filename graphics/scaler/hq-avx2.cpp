@@ -0,0 +1,84 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "graphics/scaler/hq.h"
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace {
+
+/** Set the lanes where one channel differs by more than the threshold. */
+FORCEINLINE __m256i diffChannel(__m256i yuv1, __m256i yuv2, int mask, int threshold) {
+	const __m256i diff = _mm256_sub_epi32(_mm256_and_si256(yuv1, _mm256_set1_epi32(mask)), _mm256_and_si256(yuv2, _mm256_set1_epi32(mask)));
+	return _mm256_cmpgt_epi32(_mm256_abs_epi32(diff), _mm256_set1_epi32(threshold));
+}
+
+/** The same as diffYUV(), giving a mask of bit for the lanes which differ. */
+FORCEINLINE __m256i diffYUV(__m256i yuv1, const uint32 *yuv2, int bit) {
+	const __m256i other = _mm256_loadu_si256((const __m256i *)yuv2);
+	const __m256i diff = _mm256_or_si256(_mm256_or_si256(diffChannel(yuv1, other, 0x00FF0000, 0x00300000),
+	                                                     diffChannel(yuv1, other, 0x0000FF00, 0x00000700)),
+	                                     diffChannel(yuv1, other, 0x000000FF, 0x00000006));
+	return _mm256_and_si256(diff, _mm256_set1_epi32(bit));
+}
+
+FORCEINLINE __m128i findPatterns8(const uint32 *above, const uint32 *center, const uint32 *below) {
+	const __m256i yuv5 = _mm256_loadu_si256((const __m256i *)(center + 1));
+	__m256i pattern = diffYUV(yuv5, above, 0x0001);
+	pattern = _mm256_or_si256(pattern, diffYUV(yuv5, above + 1, 0x0002));
+	pattern = _mm256_or_si256(pattern, diffYUV(yuv5, above + 2, 0x0004));
+	pattern = _mm256_or_si256(pattern, diffYUV(yuv5, center, 0x0008));
+	pattern = _mm256_or_si256(pattern, diffYUV(yuv5, center + 2, 0x0010));
+	pattern = _mm256_or_si256(pattern, diffYUV(yuv5, below, 0x0020));
+	pattern = _mm256_or_si256(pattern, diffYUV(yuv5, below + 1, 0x0040));
+	pattern = _mm256_or_si256(pattern, diffYUV(yuv5, below + 2, 0x0080));
+
+	// Packing works within 128 bit lanes, so pack the halves instead
+	return _mm_packs_epi32(_mm256_castsi256_si128(pattern), _mm256_extracti128_si256(pattern, 1));
+}
+
+} // End of anonymous namespace
+
+void HQScaler::findPatternsAVX2(const uint32 *above, const uint32 *center, const uint32 *below, uint8 *patterns, int width) {
+	int i = 0;
+	for (; i + 16 <= width; i += 16) {
+		const __m128i bytes = _mm_packus_epi16(findPatterns8(above + i, center + i, below + i),
+		                                       findPatterns8(above + i + 8, center + i + 8, below + i + 8));
+		_mm_storeu_si128((__m128i *)(patterns + i), bytes);
+	}
+
+	findPatternsGeneric(above + i, center + i, below + i, patterns + i, width - i);
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
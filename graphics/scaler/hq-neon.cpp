@@ -0,0 +1,94 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "graphics/scaler/hq.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+namespace {
+
+/** Set the lanes where one channel differs by more than the threshold. */
+FORCEINLINE uint32x4_t diffChannel(uint32x4_t yuv1, uint32x4_t yuv2, uint32 mask, uint32 threshold) {
+	const uint32x4_t diff = vabdq_u32(vandq_u32(yuv1, vdupq_n_u32(mask)), vandq_u32(yuv2, vdupq_n_u32(mask)));
+	return vcgtq_u32(diff, vdupq_n_u32(threshold));
+}
+
+/** The same as diffYUV(), giving a mask of bit for the lanes which differ. */
+FORCEINLINE uint32x4_t diffYUV(uint32x4_t yuv1, const uint32 *yuv2, uint32 bit) {
+	const uint32x4_t other = vld1q_u32(yuv2);
+	const uint32x4_t diff = vorrq_u32(vorrq_u32(diffChannel(yuv1, other, 0x00FF0000, 0x00300000),
+	                                            diffChannel(yuv1, other, 0x0000FF00, 0x00000700)),
+	                                  diffChannel(yuv1, other, 0x000000FF, 0x00000006));
+	return vandq_u32(diff, vdupq_n_u32(bit));
+}
+
+FORCEINLINE uint16x4_t findPatterns4(const uint32 *above, const uint32 *center, const uint32 *below) {
+	const uint32x4_t yuv5 = vld1q_u32(center + 1);
+	uint32x4_t pattern = diffYUV(yuv5, above, 0x0001);
+	pattern = vorrq_u32(pattern, diffYUV(yuv5, above + 1, 0x0002));
+	pattern = vorrq_u32(pattern, diffYUV(yuv5, above + 2, 0x0004));
+	pattern = vorrq_u32(pattern, diffYUV(yuv5, center, 0x0008));
+	pattern = vorrq_u32(pattern, diffYUV(yuv5, center + 2, 0x0010));
+	pattern = vorrq_u32(pattern, diffYUV(yuv5, below, 0x0020));
+	pattern = vorrq_u32(pattern, diffYUV(yuv5, below + 1, 0x0040));
+	pattern = vorrq_u32(pattern, diffYUV(yuv5, below + 2, 0x0080));
+	return vmovn_u32(pattern);
+}
+
+} // End of anonymous namespace
+
+void HQScaler::findPatternsNEON(const uint32 *above, const uint32 *center, const uint32 *below, uint8 *patterns, int width) {
+	int i = 0;
+	for (; i + 8 <= width; i += 8) {
+		const uint16x8_t words = vcombine_u16(findPatterns4(above + i, center + i, below + i),
+		                                      findPatterns4(above + i + 4, center + i + 4, below + i + 4));
+		vst1_u8(patterns + i, vmovn_u16(words));
+	}
+
+	findPatternsGeneric(above + i, center + i, below + i, patterns + i, width - i);
+}
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
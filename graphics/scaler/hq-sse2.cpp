@@ -0,0 +1,91 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "graphics/scaler/hq.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace {
+
+/** Set the lanes where one channel differs by more than the threshold. */
+FORCEINLINE __m128i diffChannel(__m128i yuv1, __m128i yuv2, int mask, int threshold) {
+	const __m128i diff = _mm_sub_epi32(_mm_and_si128(yuv1, _mm_set1_epi32(mask)), _mm_and_si128(yuv2, _mm_set1_epi32(mask)));
+	const __m128i sign = _mm_srai_epi32(diff, 31);
+	return _mm_cmpgt_epi32(_mm_sub_epi32(_mm_xor_si128(diff, sign), sign), _mm_set1_epi32(threshold));
+}
+
+/** The same as diffYUV(), giving a mask of bit for the lanes which differ. */
+FORCEINLINE __m128i diffYUV(__m128i yuv1, const uint32 *yuv2, int bit) {
+	const __m128i other = _mm_loadu_si128((const __m128i *)yuv2);
+	const __m128i diff = _mm_or_si128(_mm_or_si128(diffChannel(yuv1, other, 0x00FF0000, 0x00300000),
+	                                               diffChannel(yuv1, other, 0x0000FF00, 0x00000700)),
+	                                  diffChannel(yuv1, other, 0x000000FF, 0x00000006));
+	return _mm_and_si128(diff, _mm_set1_epi32(bit));
+}
+
+FORCEINLINE __m128i findPatterns4(const uint32 *above, const uint32 *center, const uint32 *below) {
+	const __m128i yuv5 = _mm_loadu_si128((const __m128i *)(center + 1));
+	__m128i pattern = diffYUV(yuv5, above, 0x0001);
+	pattern = _mm_or_si128(pattern, diffYUV(yuv5, above + 1, 0x0002));
+	pattern = _mm_or_si128(pattern, diffYUV(yuv5, above + 2, 0x0004));
+	pattern = _mm_or_si128(pattern, diffYUV(yuv5, center, 0x0008));
+	pattern = _mm_or_si128(pattern, diffYUV(yuv5, center + 2, 0x0010));
+	pattern = _mm_or_si128(pattern, diffYUV(yuv5, below, 0x0020));
+	pattern = _mm_or_si128(pattern, diffYUV(yuv5, below + 1, 0x0040));
+	pattern = _mm_or_si128(pattern, diffYUV(yuv5, below + 2, 0x0080));
+	return pattern;
+}
+
+} // End of anonymous namespace
+
+void HQScaler::findPatternsSSE2(const uint32 *above, const uint32 *center, const uint32 *below, uint8 *patterns, int width) {
+	int i = 0;
+	for (; i + 8 <= width; i += 8) {
+		const __m128i words = _mm_packs_epi32(findPatterns4(above + i, center + i, below + i),
+		                                      findPatterns4(above + i + 4, center + i + 4, below + i + 4));
+		_mm_storel_epi64((__m128i *)(patterns + i), _mm_packus_epi16(words, words));
+	}
+
+	findPatternsGeneric(above + i, center + i, below + i, patterns + i, width - i);
+}
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
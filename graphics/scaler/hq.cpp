@@ -21,6 +21,7 @@
 #include "graphics/scaler/hq.h"
 #include "graphics/scaler.h"
 #include "graphics/scaler/intern.h"
+#include "common/system.h"
 
 // RGB-to-YUV lookup table
 
@@ -193,13 +194,56 @@ static inline uint32 ConvertYUV(uint32 x, const uint32 *RGBtoYUV) {
 	return RGBtoYUV[r | g | b];
 }
 
+/** Number of pixels whose patterns are found in one go. */
+static const int kPatternRun = 64;
+
+/**
+ * Find the patterns of count pixels in a row, starting at p.
+ */
+template<typename ColorMask>
+static void findPatterns(const typename ColorMask::PixelType *p, uint32 nextlineSrc, int count, uint8 *patterns, const uint32 *RGBtoYUV, HQScaler::FindPatternsFunc findPatternsFunc) {
+	uint32 yuv[3][kPatternRun + 2];
+
+	p -= 1 + nextlineSrc;
+	for (int row = 0; row < 3; row++) {
+		for (int i = 0; i < count + 2; i++) {
+			if (ColorMask::kBytesPerPixel == 2)
+				yuv[row][i] = RGBtoYUV[p[i]];
+			else
+				yuv[row][i] = ConvertYUV<ColorMask>(p[i], RGBtoYUV);
+		}
+		p += nextlineSrc;
+	}
+
+	findPatternsFunc(yuv[0], yuv[1], yuv[2], patterns, count);
+}
+
+HQScaler::FindPatternsFunc HQScaler::findPatternsFunc = nullptr;
+
+void HQScaler::findPatternsGeneric(const uint32 *above, const uint32 *center, const uint32 *below, uint8 *patterns, int width) {
+	for (int i = 0; i < width; i++) {
+		// Equal pixels have equal YUV values, so diffYUV() needs no shortcut for them
+		const int yuv5 = center[i + 1];
+		int pattern = 0;
+		if (diffYUV(yuv5, above[i])) pattern |= 0x0001;
+		if (diffYUV(yuv5, above[i + 1])) pattern |= 0x0002;
+		if (diffYUV(yuv5, above[i + 2])) pattern |= 0x0004;
+		if (diffYUV(yuv5, center[i])) pattern |= 0x0008;
+		if (diffYUV(yuv5, center[i + 2])) pattern |= 0x0010;
+		if (diffYUV(yuv5, below[i])) pattern |= 0x0020;
+		if (diffYUV(yuv5, below[i + 1])) pattern |= 0x0040;
+		if (diffYUV(yuv5, below[i + 2])) pattern |= 0x0080;
+		patterns[i] = pattern;
+	}
+}
+
 /*
  * The HQ2x high quality 2x graphics filter.
  * Original author Maxim Stepin (https://web.archive.org/web/20090204033742/http://www.hiend3d.com/hq2x.html).
  * Adapted for ScummVM to 16 bit output and optimized by Max Horn.
  */
 template<typename ColorMask>
-static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, const uint32 *RGBtoYUV) {
+static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, const uint32 *RGBtoYUV, HQScaler::FindPatternsFunc findPatternsFunc) {
 	typedef typename ColorMask::PixelType Pixel;
 
 	int w1, w2, w3, w4, w5, w6, w7, w8, w9;
@@ -230,24 +274,22 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 		w5 = *(p);
 		w8 = *(p + nextlineSrc);
 
+		uint8 patterns[kPatternRun];
+		const uint8 *nextPattern = patterns + kPatternRun;
 		int tmpWidth = width;
 		while (tmpWidth--) {
+			if (nextPattern == patterns + kPatternRun) {
+				findPatterns<ColorMask>(p, nextlineSrc, MIN<int>(tmpWidth + 1, kPatternRun), patterns, RGBtoYUV, findPatternsFunc);
+				nextPattern = patterns;
+			}
+
 			p++;
 
 			w3 = *(p - nextlineSrc);
 			w6 = *(p);
 			w9 = *(p + nextlineSrc);
 
-			int pattern = 0;
-			const int yuv5 = YUV(5);
-			if (w5 != w1 && diffYUV(yuv5, YUV(1))) pattern |= 0x0001;
-			if (w5 != w2 && diffYUV(yuv5, YUV(2))) pattern |= 0x0002;
-			if (w5 != w3 && diffYUV(yuv5, YUV(3))) pattern |= 0x0004;
-			if (w5 != w4 && diffYUV(yuv5, YUV(4))) pattern |= 0x0008;
-			if (w5 != w6 && diffYUV(yuv5, YUV(6))) pattern |= 0x0010;
-			if (w5 != w7 && diffYUV(yuv5, YUV(7))) pattern |= 0x0020;
-			if (w5 != w8 && diffYUV(yuv5, YUV(8))) pattern |= 0x0040;
-			if (w5 != w9 && diffYUV(yuv5, YUV(9))) pattern |= 0x0080;
+			const int pattern = *nextPattern++;
 
 			switch (pattern) {
 			case 0:
@@ -2116,7 +2158,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
  * Adapted for ScummVM to 16 bit output and optimized by Max Horn.
  */
 template<typename ColorMask>
-static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, const uint32 *RGBtoYUV) {
+static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, const uint32 *RGBtoYUV, HQScaler::FindPatternsFunc findPatternsFunc) {
 	typedef typename ColorMask::PixelType Pixel;
 
 	int  w1, w2, w3, w4, w5, w6, w7, w8, w9;
@@ -2148,24 +2190,22 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 		w5 = *(p);
 		w8 = *(p + nextlineSrc);
 
+		uint8 patterns[kPatternRun];
+		const uint8 *nextPattern = patterns + kPatternRun;
 		int tmpWidth = width;
 		while (tmpWidth--) {
+			if (nextPattern == patterns + kPatternRun) {
+				findPatterns<ColorMask>(p, nextlineSrc, MIN<int>(tmpWidth + 1, kPatternRun), patterns, RGBtoYUV, findPatternsFunc);
+				nextPattern = patterns;
+			}
+
 			p++;
 
 			w3 = *(p - nextlineSrc);
 			w6 = *(p);
 			w9 = *(p + nextlineSrc);
 
-			int pattern = 0;
-			const int yuv5 = YUV(5);
-			if (w5 != w1 && diffYUV(yuv5, YUV(1))) pattern |= 0x0001;
-			if (w5 != w2 && diffYUV(yuv5, YUV(2))) pattern |= 0x0002;
-			if (w5 != w3 && diffYUV(yuv5, YUV(3))) pattern |= 0x0004;
-			if (w5 != w4 && diffYUV(yuv5, YUV(4))) pattern |= 0x0008;
-			if (w5 != w6 && diffYUV(yuv5, YUV(6))) pattern |= 0x0010;
-			if (w5 != w7 && diffYUV(yuv5, YUV(7))) pattern |= 0x0020;
-			if (w5 != w8 && diffYUV(yuv5, YUV(8))) pattern |= 0x0040;
-			if (w5 != w9 && diffYUV(yuv5, YUV(9))) pattern |= 0x0080;
+			const int pattern = *nextPattern++;
 
 			switch (pattern) {
 			case 0:
@@ -4954,6 +4994,22 @@ HQScaler::HQScaler(const Graphics::PixelFormat &format) : Scaler(format),
 	_RGBtoYUV(nullptr) {
 	_factor = 2;
 
+	if (!findPatternsFunc) {
+		findPatternsFunc = findPatternsGeneric;
+#ifdef SCUMMVM_NEON
+		if (g_system->hasFeature(OSystem::kFeatureCpuNEON))
+			findPatternsFunc = findPatternsNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+		if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+			findPatternsFunc = findPatternsSSE2;
+#endif
+#ifdef SCUMMVM_AVX2
+		if (g_system->hasFeature(OSystem::kFeatureCpuAVX2))
+			findPatternsFunc = findPatternsAVX2;
+#endif
+	}
+
 	if (format.bytesPerPixel == 2) {
 		initLUT(format);
 	} else {
@@ -4987,19 +5043,19 @@ void HQScaler::HQ3x16(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint3
 void HQScaler::HQ2x16(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
 	if (_format.gLoss == 2)
 		HQ2x_implementation<Graphics::ColorMasks<565> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV, findPatternsFunc);
 	else
 		HQ2x_implementation<Graphics::ColorMasks<555> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV, findPatternsFunc);
 }
 
 void HQScaler::HQ3x16(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
 	if (_format.gLoss == 2)
 		HQ3x_implementation<Graphics::ColorMasks<565> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV, findPatternsFunc);
 	else
 		HQ3x_implementation<Graphics::ColorMasks<555> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV, findPatternsFunc);
 }
 #endif
 
@@ -5007,15 +5063,15 @@ void HQScaler::HQ2x32(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint3
 	if (_format.aLoss == 0) {
 		if (_format.aShift == 0) {
 			HQ2x_implementation<Graphics::ColorMasks<-8888> >(srcPtr, srcPitch, dstPtr,
-					dstPitch, width, height, _RGBtoYUV);
+					dstPitch, width, height, _RGBtoYUV, findPatternsFunc);
 		} else {
 			HQ2x_implementation<Graphics::ColorMasks<8888> >(srcPtr, srcPitch, dstPtr,
-					dstPitch, width, height, _RGBtoYUV);
+					dstPitch, width, height, _RGBtoYUV, findPatternsFunc);
 		}
 	} else {
 		assert((_format.rMax() | _format.gMax() | _format.bMax()) <= 0xffffff);
 		HQ2x_implementation<Graphics::ColorMasks<888> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV, findPatternsFunc);
 	}
 }
 
@@ -5023,15 +5079,15 @@ void HQScaler::HQ3x32(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint3
 	if (_format.aLoss == 0) {
 		if (_format.aShift == 0) {
 			HQ3x_implementation<Graphics::ColorMasks<-8888> >(srcPtr, srcPitch, dstPtr,
-					dstPitch, width, height, _RGBtoYUV);
+					dstPitch, width, height, _RGBtoYUV, findPatternsFunc);
 		} else {
 			HQ3x_implementation<Graphics::ColorMasks<8888> >(srcPtr, srcPitch, dstPtr,
-					dstPitch, width, height, _RGBtoYUV);
+					dstPitch, width, height, _RGBtoYUV, findPatternsFunc);
 		}
 	} else {
 		assert((_format.rMax() | _format.gMax() | _format.bMax()) <= 0xffffff);
 		HQ3x_implementation<Graphics::ColorMasks<888> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV, findPatternsFunc);
 	}
 }
 
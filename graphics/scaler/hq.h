@@ -33,6 +33,33 @@ public:
 	~HQScaler();
 	uint increaseFactor() override;
 	uint decreaseFactor() override;
+
+	/**
+	 * Find the HQx pattern of a run of pixels, from the YUV values of the
+	 * rows above, at and below them. Each row starts one pixel to the left
+	 * of the first pixel and holds width + 2 values. Bits 0 to 7 of a pattern
+	 * are set for the neighbours 1 to 9 (skipping the pixel itself) which
+	 * differ noticeably from the pixel.
+	 */
+	typedef void (*FindPatternsFunc)(const uint32 *above, const uint32 *center, const uint32 *below, uint8 *patterns, int width);
+
+	static void findPatternsGeneric(const uint32 *above, const uint32 *center, const uint32 *below, uint8 *patterns, int width);
+#ifdef SCUMMVM_NEON
+	static void findPatternsNEON(const uint32 *above, const uint32 *center, const uint32 *below, uint8 *patterns, int width);
+#endif
+#ifdef SCUMMVM_SSE2
+	static void findPatternsSSE2(const uint32 *above, const uint32 *center, const uint32 *below, uint8 *patterns, int width);
+#endif
+#ifdef SCUMMVM_AVX2
+	static void findPatternsAVX2(const uint32 *above, const uint32 *center, const uint32 *below, uint8 *patterns, int width);
+#endif
+
+	/**
+	 * The pattern finder used by all HQ scalers. It is picked from the CPU
+	 * features when the first scaler is created, unless it was set before.
+	 */
+	static FindPatternsFunc findPatternsFunc;
+
 protected:
 	virtual void scaleIntern(const uint8 *srcPtr, uint32 srcPitch,
 							uint8 *dstPtr, uint32 dstPitch, int width, int height, int x, int y) override;
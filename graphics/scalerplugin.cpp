@@ -20,7 +20,13 @@
 
 #include "graphics/scalerplugin.h"
 
+#include "common/jobsystem.h"
+
 namespace {
+
+/** Bands should be a lot taller than the rows the scaler reads around them. */
+const uint kMinBandHeight = 16;
+
 /**
  * Trivial 'scaler' - in fact it doesn't do any scaling but just copies the
  * source to the destination.
@@ -57,6 +63,21 @@ void Scaler::scale(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
 	}
 }
 
+void Scaler::scaleInBands(Common::JobSystem *jobSystem, uint margin, const uint8 *srcPtr, uint32 srcPitch,
+                          uint8 *dstPtr, uint32 dstPitch, int width, int height, int x, int y) {
+	const uint bandHeight = MAX(kMinBandHeight, margin * 4);
+
+	if (!jobSystem || jobSystem->getWorkerCount() == 0 || !canScaleInBands() || (uint)height < bandHeight * 2) {
+		scale(srcPtr, srcPitch, dstPtr, dstPitch, width, height, x, y);
+		return;
+	}
+
+	jobSystem->parallelFor(0, height, bandHeight, [=](uint begin, uint end) {
+		scale(srcPtr + begin * srcPitch, srcPitch, dstPtr + begin * _factor * dstPitch, dstPitch,
+		      width, end - begin, x, y + begin);
+	}, "Scaler band");
+}
+
 SourceScaler::SourceScaler(const Graphics::PixelFormat &format) : Scaler(format), _width(0), _height(0), _oldSrc(NULL), _enable(false) {
 }
 
@@ -25,6 +25,10 @@
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
 
+namespace Common {
+class JobSystem;
+}
+
 class Scaler {
 public:
 	Scaler(const Graphics::PixelFormat &format) : _format(format) {}
@@ -45,6 +49,30 @@ public:
 	void scale(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
 	           uint32 dstPitch, int width, int height, int x, int y);
 
+	/**
+	 * Scale a rect like scale(), but split it into horizontal bands which
+	 * are scaled concurrently by the workers of a job system.
+	 *
+	 * The bands read the source rows around them, so the whole source must
+	 * stay unchanged until this returns. Small rects, scalers which cannot
+	 * run concurrently and job systems without workers fall back to a
+	 * single scale() call.
+	 *
+	 * @param jobSystem The job system to use, may be nullptr.
+	 * @param margin    The number of pixels the scaler reads outside the
+	 *                  rect, see ScalerPluginObject::extraPixels().
+	 * @see scale
+	 */
+	void scaleInBands(Common::JobSystem *jobSystem, uint margin, const uint8 *srcPtr, uint32 srcPitch,
+	                  uint8 *dstPtr, uint32 dstPitch, int width, int height, int x, int y);
+
+	/**
+	 * Whether scale() may be called concurrently for rects which do not
+	 * overlap. Scalers which keep state between or during calls must
+	 * return false.
+	 */
+	virtual bool canScaleInBands() const { return true; }
+
 	/**
 	 * Increase the factor of scaling.
 	 * @return The new factor
@@ -122,6 +150,9 @@ public:
 
 	virtual uint setFactor(uint factor) final;
 
+	/** The old source is updated by every call. */
+	virtual bool canScaleInBands() const final { return false; }
+
 protected:
 
 	virtual void scaleIntern(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
@@ -354,8 +354,8 @@ void GLContext::init(int screenW, int screenH, Graphics::PixelFormat pixelFormat
 	color_mask_red = color_mask_green = color_mask_blue = color_mask_alpha = true;
 
 	_currentAllocatorIndex = 0;
-	_drawCallAllocator[0].initialize(drawCallMemorySize);
-	_drawCallAllocator[1].initialize(drawCallMemorySize);
+	_drawCallAllocator[0].setBlockSize(drawCallMemorySize);
+	_drawCallAllocator[1].setBlockSize(drawCallMemorySize);
 	_debugRectsEnabled = false;
 	_profilingEnabled = false;
 }
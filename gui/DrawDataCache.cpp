@@ -0,0 +1,176 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "graphics/managed_surface.h"
+
+#include "gui/DrawDataCache.h"
+
+namespace GUI {
+
+struct CachedDrawData {
+	DrawDataCache::Key key;
+	Common::Array<byte> before; ///< Pixels before the steps were drawn
+	Common::Array<byte> after;  ///< Pixels after the steps were drawn
+	Common::List<CachedDrawData *>::iterator lruPos;
+};
+
+static void copyPixelsFrom(const Graphics::ManagedSurface &surface, const Common::Rect &r, Common::Array<byte> &pixels) {
+	const uint rowSize = r.width() * surface.format.bytesPerPixel;
+	pixels.resize(rowSize * r.height());
+	for (int y = 0; y < r.height(); y++)
+		memcpy(&pixels[y * rowSize], surface.getBasePtr(r.left, r.top + y), rowSize);
+}
+
+static void copyPixelsTo(Graphics::ManagedSurface &surface, const Common::Rect &r, const Common::Array<byte> &pixels) {
+	const uint rowSize = r.width() * surface.format.bytesPerPixel;
+	for (int y = 0; y < r.height(); y++)
+		memcpy(surface.getBasePtr(r.left, r.top + y), &pixels[y * rowSize], rowSize);
+}
+
+static bool equalPixels(const Graphics::ManagedSurface &surface, const Common::Rect &r, const Common::Array<byte> &pixels) {
+	const uint rowSize = r.width() * surface.format.bytesPerPixel;
+	for (int y = 0; y < r.height(); y++) {
+		if (memcmp(surface.getBasePtr(r.left, r.top + y), &pixels[y * rowSize], rowSize))
+			return false;
+	}
+	return true;
+}
+
+static uint32 hashPixels(const Common::CRC32 &crc, const Graphics::ManagedSurface &surface, const Common::Rect &r) {
+	const uint rowSize = r.width() * surface.format.bytesPerPixel;
+	uint32 remainder = crc.getInitRemainder();
+	for (int y = 0; y < r.height(); y++)
+		remainder = crc.update(remainder, (const byte *)surface.getBasePtr(r.left, r.top + y), rowSize);
+	return crc.finalize(remainder);
+}
+
+DrawDataCache::DrawDataCache(uint32 maxSize) : _size(0), _maxSize(maxSize), _hits(0) {
+}
+
+DrawDataCache::~DrawDataCache() {
+	clear();
+}
+
+bool DrawDataCache::canCache(const Common::List<Graphics::DrawStep> &steps) {
+	bool expensive = false;
+
+	for (Common::List<Graphics::DrawStep>::const_iterator step = steps.begin(); step != steps.end(); ++step) {
+		// Filling the surface draws outside of the widget, and shadows of
+		// fixed size shapes are not part of the offsets
+		if (step->drawingCall == &Graphics::VectorRenderer::drawCallback_FILLSURFACE ||
+		    (!step->autoWidth && !step->autoHeight && step->shadow))
+			return false;
+
+		// Flat rectangles, lines and bitmaps cost about as much as copying
+		// the pixels they cover, let alone comparing them beforehand
+		const bool flat = step->fillMode != Graphics::VectorRenderer::kFillGradient && !step->shadow && !step->bevel;
+		if (!flat ||
+		    (step->drawingCall != &Graphics::VectorRenderer::drawCallback_SQUARE &&
+		     step->drawingCall != &Graphics::VectorRenderer::drawCallback_LINE &&
+		     step->drawingCall != &Graphics::VectorRenderer::drawCallback_BITMAP &&
+		     step->drawingCall != &Graphics::VectorRenderer::drawCallback_VOID))
+			expensive = true;
+	}
+
+	return expensive;
+}
+
+void DrawDataCache::drawSteps(Graphics::VectorRenderer *renderer, uint32 id, const Common::List<Graphics::DrawStep> &steps,
+                              const Common::Rect &area, const Common::Rect &stepsRect, const Common::Rect &clip, uint32 dynamic) {
+	Graphics::ManagedSurface *surface = renderer->getActiveSurface();
+
+	Common::Rect capture = stepsRect;
+	capture.clip(surface->w, surface->h);
+	const uint32 size = capture.width() * capture.height() * surface->format.bytesPerPixel * 2;
+
+	// Large elements are drawn once per dialog anyway
+	if (capture.isEmpty() || size > _maxSize / 4) {
+		for (Common::List<Graphics::DrawStep>::const_iterator step = steps.begin(); step != steps.end(); ++step)
+			renderer->drawStep(area, clip, *step, dynamic);
+		return;
+	}
+
+	Key key;
+	key.id = id;
+	key.dynamic = dynamic;
+	key.width = area.width();
+	key.height = area.height();
+	key.capture = capture;
+	key.capture.translate(-area.left, -area.top);
+	key.hasClip = !clip.isEmpty();
+	key.clip = key.hasClip ? clip.findIntersectingRect(capture) : Common::Rect();
+	key.clip.translate(-area.left, -area.top);
+	key.parity = (area.left & 1) | ((area.top & 1) << 1);
+	renderer->getInheritedState(key.state);
+	key.pixelHash = hashPixels(_crc, *surface, capture);
+
+	EntryMap::iterator found = _entries.find(key);
+	if (found != _entries.end()) {
+		CachedDrawData *cached = found->_value;
+
+		// The checksum only narrows the search down to a single entry
+		if (equalPixels(*surface, capture, cached->before)) {
+			copyPixelsTo(*surface, capture, cached->after);
+
+			_lru.erase(cached->lruPos);
+			_lru.push_front(cached);
+			cached->lruPos = _lru.begin();
+			_hits++;
+			return;
+		}
+
+		evict(cached);
+	}
+
+	CachedDrawData *entry = new CachedDrawData();
+	entry->key = key;
+	copyPixelsFrom(*surface, capture, entry->before);
+
+	for (Common::List<Graphics::DrawStep>::const_iterator step = steps.begin(); step != steps.end(); ++step)
+		renderer->drawStep(area, clip, *step, dynamic);
+
+	copyPixelsFrom(*surface, capture, entry->after);
+
+	_lru.push_front(entry);
+	entry->lruPos = _lru.begin();
+	_entries[key] = entry;
+	_size += size;
+
+	while (_size > _maxSize)
+		evict(_lru.back());
+}
+
+void DrawDataCache::evict(CachedDrawData *entry) {
+	_size -= entry->before.size() + entry->after.size();
+	_entries.erase(entry->key);
+	_lru.erase(entry->lruPos);
+	delete entry;
+}
+
+void DrawDataCache::clear() {
+	for (Common::List<CachedDrawData *>::iterator i = _lru.begin(); i != _lru.end(); ++i)
+		delete *i;
+	_lru.clear();
+	_entries.clear();
+	_size = 0;
+}
+
+} // End of namespace GUI
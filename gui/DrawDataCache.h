@@ -0,0 +1,121 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GUI_DRAW_DATA_CACHE_H
+#define GUI_DRAW_DATA_CACHE_H
+
+#include "common/scummsys.h"
+#include "common/array.h"
+#include "common/crc.h"
+#include "common/hashmap.h"
+#include "common/list.h"
+#include "common/noncopyable.h"
+#include "common/rect.h"
+
+#include "graphics/VectorRenderer.h"
+
+namespace GUI {
+
+struct CachedDrawData;
+
+/**
+ * Keeps the results of running the steps of DrawData items, so that drawing
+ * an item again in the same size and style over the same pixels is a copy.
+ *
+ * Entries are looked up by the size, style and clipping of the item along
+ * with a checksum of the pixels under it, and are evicted in least recently
+ * used order once they hold more than the given number of bytes.
+ *
+ * The cache does not know which widgets changed. Widgets are only drawn
+ * again when they are marked as dirty (see Widget::markAsDirty()), and
+ * redrawing a whole dialog marks all of its widgets, so most hits come from
+ * such redraws, e.g. after a dialog on top of it has been closed.
+ */
+class DrawDataCache : Common::NonCopyable {
+public:
+	DrawDataCache(uint32 maxSize);
+	~DrawDataCache();
+
+	/**
+	 * Whether the result of the steps can be kept: they must only draw
+	 * inside the area of the item and its shadow offset, and be more
+	 * expensive than copying their result.
+	 */
+	static bool canCache(const Common::List<Graphics::DrawStep> &steps);
+
+	/**
+	 * Runs the steps on the active surface of the renderer, or copies their
+	 * result from the last time they were run in the same way.
+	 *
+	 * @param id        Identifies the steps, e.g. the DrawData type.
+	 * @param area      Area of the GUI element.
+	 * @param stepsRect Area the steps may draw to, including shadows, before clipping.
+	 * @param clip      Clipping rect, empty if there is none.
+	 */
+	void drawSteps(Graphics::VectorRenderer *renderer, uint32 id, const Common::List<Graphics::DrawStep> &steps,
+	               const Common::Rect &area, const Common::Rect &stepsRect, const Common::Rect &clip, uint32 dynamic);
+
+	/** Forgets all the results. */
+	void clear();
+
+	/** Number of items drawn by copying a result, for profiling and tests. */
+	uint32 getHitCount() const { return _hits; }
+
+	struct Key {
+		uint32 id;
+		uint32 dynamic;
+		int16 width, height;    ///< Size of the area of the GUI element
+		Common::Rect capture;   ///< Copied pixels, relative to the area
+		Common::Rect clip;      ///< Clipping rect, relative to the area
+		bool hasClip;
+		byte parity;            ///< Odd coordinates of the area, which the gradient dithering depends on
+		Graphics::VectorRenderer::InheritedState state;
+		uint32 pixelHash;       ///< Checksum of the pixels before the steps were drawn
+
+		bool operator==(const Key &other) const {
+			return id == other.id && dynamic == other.dynamic && width == other.width && height == other.height &&
+			       capture == other.capture && hasClip == other.hasClip && (!hasClip || clip == other.clip) &&
+			       parity == other.parity && state == other.state && pixelHash == other.pixelHash;
+		}
+	};
+
+	struct Key_Hash {
+		uint operator()(const Key &key) const {
+			return key.pixelHash ^ (key.id << 24) ^ (key.dynamic * 31) ^ (key.width << 12) ^ key.height;
+		}
+	};
+
+private:
+	void evict(CachedDrawData *entry);
+
+	typedef Common::HashMap<Key, CachedDrawData *, Key_Hash> EntryMap;
+
+	EntryMap _entries;
+	Common::List<CachedDrawData *> _lru; ///< The most recently used first
+	uint32 _size;                        ///< Number of bytes of pixels kept
+	uint32 _maxSize;
+	uint32 _hits;
+	const Common::CRC32 _crc;            ///< Hashes the pixels under a widget
+};
+
+} // End of namespace GUI
+
+#endif
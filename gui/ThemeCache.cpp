@@ -0,0 +1,706 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/array.h"
+#include "common/endian.h"
+#include "common/stream.h"
+
+#include "graphics/managed_surface.h"
+#include "graphics/VectorRenderer.h"
+
+#include "gui/ThemeCache.h"
+#include "gui/ThemeEval.h"
+
+#include "base/version.h"
+
+namespace GUI {
+
+namespace {
+
+const uint32 kCacheTag = MKTAG('T', 'H', 'M', 'C');
+const uint32 kCacheVersion = 1;
+
+const byte kNoDrawingCall = 0xFF;
+
+/** The drawing functions a DrawStep may point to, stored by their index. */
+const Graphics::DrawingFunctionCallback kDrawingCalls[] = {
+	&Graphics::VectorRenderer::drawCallback_CIRCLE,
+	&Graphics::VectorRenderer::drawCallback_SQUARE,
+	&Graphics::VectorRenderer::drawCallback_ROUNDSQ,
+	&Graphics::VectorRenderer::drawCallback_BEVELSQ,
+	&Graphics::VectorRenderer::drawCallback_LINE,
+	&Graphics::VectorRenderer::drawCallback_TRIANGLE,
+	&Graphics::VectorRenderer::drawCallback_FILLSURFACE,
+	&Graphics::VectorRenderer::drawCallback_TAB,
+	&Graphics::VectorRenderer::drawCallback_VOID,
+	&Graphics::VectorRenderer::drawCallback_BITMAP,
+	&Graphics::VectorRenderer::drawCallback_CROSS
+};
+
+void writeColor(Common::WriteStream &stream, const Graphics::DrawStep::Color &color) {
+	stream.writeByte(color.r);
+	stream.writeByte(color.g);
+	stream.writeByte(color.b);
+	stream.writeByte(color.set);
+}
+
+void readColor(Common::ReadStream &stream, Graphics::DrawStep::Color &color) {
+	color.r = stream.readByte();
+	color.g = stream.readByte();
+	color.b = stream.readByte();
+	color.set = stream.readByte() != 0;
+}
+
+void writeRect(Common::WriteStream &stream, const Common::Rect &rect) {
+	stream.writeSint16LE(rect.left);
+	stream.writeSint16LE(rect.top);
+	stream.writeSint16LE(rect.right);
+	stream.writeSint16LE(rect.bottom);
+}
+
+void readRect(Common::ReadStream &stream, Common::Rect &rect) {
+	rect.left = stream.readSint16LE();
+	rect.top = stream.readSint16LE();
+	rect.right = stream.readSint16LE();
+	rect.bottom = stream.readSint16LE();
+}
+
+void writeFormat(Common::WriteStream &stream, const Graphics::PixelFormat &format) {
+	stream.writeByte(format.bytesPerPixel);
+	stream.writeByte(format.rLoss);
+	stream.writeByte(format.gLoss);
+	stream.writeByte(format.bLoss);
+	stream.writeByte(format.aLoss);
+	stream.writeByte(format.rShift);
+	stream.writeByte(format.gShift);
+	stream.writeByte(format.bShift);
+	stream.writeByte(format.aShift);
+}
+
+void readFormat(Common::ReadStream &stream, Graphics::PixelFormat &format) {
+	format.bytesPerPixel = stream.readByte();
+	format.rLoss = stream.readByte();
+	format.gLoss = stream.readByte();
+	format.bLoss = stream.readByte();
+	format.aLoss = stream.readByte();
+	format.rShift = stream.readByte();
+	format.gShift = stream.readByte();
+	format.bShift = stream.readByte();
+	format.aShift = stream.readByte();
+}
+
+struct CachedBitmap {
+	Common::String name;
+	Graphics::ManagedSurface *surface;
+};
+
+void freeBitmaps(Common::Array<CachedBitmap> &bitmaps) {
+	for (uint i = 0; i < bitmaps.size(); i++)
+		delete bitmaps[i].surface;
+	bitmaps.clear();
+}
+
+} // End of anonymous namespace
+
+void ThemeCache::startRecording() {
+	delete _ops;
+	_ops = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::YES);
+	_bitmaps.clear();
+	_recording = true;
+}
+
+void ThemeCache::clear() {
+	delete _ops;
+	_ops = nullptr;
+	_bitmaps.clear();
+	_recording = false;
+}
+
+void ThemeCache::recordDrawData(const Common::String &data, bool cached) {
+	if (!_recording)
+		return;
+
+	_ops->writeByte(kOpDrawData);
+	writeString(*_ops, data);
+	_ops->writeByte(cached);
+}
+
+void ThemeCache::recordDrawStep(const Common::String &drawDataId, const Graphics::DrawStep &step, const Common::String &bitmap) {
+	if (!_recording)
+		return;
+
+	byte drawingCall = kNoDrawingCall;
+	for (uint i = 0; i < ARRAYSIZE(kDrawingCalls); i++) {
+		if (step.drawingCall == kDrawingCalls[i])
+			drawingCall = i;
+	}
+
+	// A step with a bitmap which is not one of the theme bitmaps cannot
+	// be restored, and neither can one with an unknown drawing function
+	if ((step.drawingCall && drawingCall == kNoDrawingCall) || (step.blitSrc && bitmap.empty())) {
+		warning("ThemeCache: Cannot record a draw step of '%s'", drawDataId.c_str());
+		clear();
+		return;
+	}
+
+	_ops->writeByte(kOpDrawStep);
+	writeString(*_ops, drawDataId);
+	_ops->writeByte(drawingCall);
+	writeString(*_ops, bitmap);
+	_ops->writeByte(step.alphaType);
+
+	writeColor(*_ops, step.fgColor);
+	writeColor(*_ops, step.bgColor);
+	writeColor(*_ops, step.gradColor1);
+	writeColor(*_ops, step.gradColor2);
+	writeColor(*_ops, step.bevelColor);
+
+	_ops->writeByte(step.autoWidth);
+	_ops->writeByte(step.autoHeight);
+	_ops->writeSint16LE(step.x);
+	_ops->writeSint16LE(step.y);
+	_ops->writeSint16LE(step.w);
+	_ops->writeSint16LE(step.h);
+	writeRect(*_ops, step.padding);
+	writeRect(*_ops, step.clip);
+	_ops->writeByte(step.xAlign);
+	_ops->writeByte(step.yAlign);
+
+	_ops->writeByte(step.shadow);
+	_ops->writeByte(step.stroke);
+	_ops->writeByte(step.factor);
+	_ops->writeByte(step.radius);
+	_ops->writeByte(step.bevel);
+	_ops->writeByte(step.fillMode);
+	_ops->writeByte(step.shadowFillMode);
+	_ops->writeUint32LE(step.extraData);
+	_ops->writeUint32LE(step.scale);
+	_ops->writeUint32LE(step.shadowIntensity);
+	_ops->writeByte(step.autoscale);
+}
+
+void ThemeCache::recordTextData(const Common::String &drawDataId, TextData textId, TextColor colorId, Graphics::TextAlign alignH, ThemeEngine::TextAlignVertical alignV) {
+	if (!_recording)
+		return;
+
+	_ops->writeByte(kOpTextData);
+	writeString(*_ops, drawDataId);
+	_ops->writeSint32LE(textId);
+	_ops->writeSint32LE(colorId);
+	_ops->writeSint32LE(alignH);
+	_ops->writeSint32LE(alignV);
+}
+
+void ThemeCache::recordFont(TextData textId, const Common::String &language, const Common::String &file, const Common::String &scalableFile, int pointsize) {
+	if (!_recording)
+		return;
+
+	_ops->writeByte(kOpFont);
+	_ops->writeSint32LE(textId);
+	writeString(*_ops, language);
+	writeString(*_ops, file);
+	writeString(*_ops, scalableFile);
+	_ops->writeSint32LE(pointsize);
+}
+
+void ThemeCache::recordFontNames(TextData textId, const Common::String &language, const Common::String &file, const Common::String &scalableFile, int pointsize) {
+	if (!_recording)
+		return;
+
+	_ops->writeByte(kOpFontNames);
+	_ops->writeSint32LE(textId);
+	writeString(*_ops, language);
+	writeString(*_ops, file);
+	writeString(*_ops, scalableFile);
+	_ops->writeSint32LE(pointsize);
+}
+
+void ThemeCache::recordTextColor(TextColor colorId, int r, int g, int b) {
+	if (!_recording)
+		return;
+
+	_ops->writeByte(kOpTextColor);
+	_ops->writeSint32LE(colorId);
+	_ops->writeSint32LE(r);
+	_ops->writeSint32LE(g);
+	_ops->writeSint32LE(b);
+}
+
+void ThemeCache::recordBitmap(const Common::String &filename) {
+	if (!_recording)
+		return;
+
+	// Bitmaps are stored ahead of the recording, so they need no op
+	for (uint i = 0; i < _bitmaps.size(); i++) {
+		if (_bitmaps[i] == filename)
+			return;
+	}
+	_bitmaps.push_back(filename);
+}
+
+void ThemeCache::recordCursor(const Common::String &filename, int hotspotX, int hotspotY) {
+	if (!_recording)
+		return;
+
+	_ops->writeByte(kOpCursor);
+	writeString(*_ops, filename);
+	_ops->writeSint32LE(hotspotX);
+	_ops->writeSint32LE(hotspotY);
+}
+
+void ThemeCache::recordVar(const Common::String &name, int val) {
+	if (!_recording)
+		return;
+
+	_ops->writeByte(kOpVar);
+	writeString(*_ops, name);
+	_ops->writeSint32LE(val);
+}
+
+void ThemeCache::recordDialog(const Common::String &name, const Common::String &overlays, int16 maxWidth, int16 maxHeight, int inset) {
+	if (!_recording)
+		return;
+
+	_ops->writeByte(kOpDialog);
+	writeString(*_ops, name);
+	writeString(*_ops, overlays);
+	_ops->writeSint16LE(maxWidth);
+	_ops->writeSint16LE(maxHeight);
+	_ops->writeSint32LE(inset);
+}
+
+void ThemeCache::recordLayout(ThemeLayout::LayoutType type, int spacing, ThemeLayout::ItemAlign itemAlign) {
+	if (!_recording)
+		return;
+
+	_ops->writeByte(kOpLayout);
+	_ops->writeSint32LE(type);
+	_ops->writeSint32LE(spacing);
+	_ops->writeSint32LE(itemAlign);
+}
+
+void ThemeCache::recordWidget(const Common::String &name, const Common::String &type, int w, int h, Graphics::TextAlign align, bool useRTL) {
+	if (!_recording)
+		return;
+
+	_ops->writeByte(kOpWidget);
+	writeString(*_ops, name);
+	writeString(*_ops, type);
+	_ops->writeSint32LE(w);
+	_ops->writeSint32LE(h);
+	_ops->writeSint32LE(align);
+	_ops->writeByte(useRTL);
+}
+
+void ThemeCache::recordImportedLayout(const Common::String &name) {
+	if (!_recording)
+		return;
+
+	_ops->writeByte(kOpImportedLayout);
+	writeString(*_ops, name);
+}
+
+void ThemeCache::recordSpace(int size) {
+	if (!_recording)
+		return;
+
+	_ops->writeByte(kOpSpace);
+	_ops->writeSint32LE(size);
+}
+
+void ThemeCache::recordPadding(int16 l, int16 r, int16 t, int16 b) {
+	if (!_recording)
+		return;
+
+	_ops->writeByte(kOpPadding);
+	_ops->writeSint16LE(l);
+	_ops->writeSint16LE(r);
+	_ops->writeSint16LE(t);
+	_ops->writeSint16LE(b);
+}
+
+void ThemeCache::recordCloseLayout() {
+	if (_recording)
+		_ops->writeByte(kOpCloseLayout);
+}
+
+void ThemeCache::recordCloseDialog() {
+	if (_recording)
+		_ops->writeByte(kOpCloseDialog);
+}
+
+void ThemeCache::writeKey(Common::WriteStream &stream, const Key &key) {
+	writeString(stream, SCUMMVM_THEME_VERSION_STR);
+	writeString(stream, gScummVMFullVersion);
+	writeString(stream, key.themeId);
+	stream.writeUint32LE(key.themeHash);
+	stream.writeSint16LE(key.baseWidth);
+	stream.writeSint16LE(key.baseHeight);
+	stream.writeFloatLE(key.scaleFactor);
+	writeFormat(stream, key.format);
+
+	// The bitmaps are stored in the native byte order
+#ifdef SCUMM_BIG_ENDIAN
+	stream.writeByte(1);
+#else
+	stream.writeByte(0);
+#endif
+}
+
+void ThemeCache::writeString(Common::WriteStream &stream, const Common::String &str) {
+	stream.writeUint32LE(str.size());
+	stream.write(str.c_str(), str.size());
+}
+
+Common::String ThemeCache::readString(Common::ReadStream &stream) {
+	const uint32 size = stream.readUint32LE();
+	Common::String str;
+
+	// Stop at absurd sizes, which can only come from a broken file
+	if (stream.err() || stream.eos() || size > 0x10000)
+		return str;
+
+	char buffer[256];
+	uint32 left = size;
+	while (left > 0) {
+		const uint32 chunk = MIN<uint32>(left, sizeof(buffer));
+		if (stream.read(buffer, chunk) != chunk)
+			break;
+		str += Common::String(buffer, chunk);
+		left -= chunk;
+	}
+	return str;
+}
+
+bool ThemeCache::save(Common::WriteStream &stream, const Key &key, const Common::String &themeName, const ThemeEngine &engine) const {
+	if (_recording || !_ops)
+		return false;
+
+	stream.writeUint32BE(kCacheTag);
+	stream.writeUint32BE(kCacheVersion);
+	writeKey(stream, key);
+	writeString(stream, themeName);
+
+	stream.writeUint32LE(_bitmaps.size());
+	for (uint i = 0; i < _bitmaps.size(); i++) {
+		const Graphics::ManagedSurface *surf = engine._bitmaps.getValOrDefault(_bitmaps[i], nullptr);
+
+		writeString(stream, _bitmaps[i]);
+		stream.writeByte(surf != nullptr);
+		if (!surf)
+			continue;
+
+		writeFormat(stream, surf->format);
+		stream.writeUint16LE(surf->w);
+		stream.writeUint16LE(surf->h);
+		stream.writeByte(surf->hasTransparentColor());
+		stream.writeUint32LE(surf->hasTransparentColor() ? surf->getTransparentColor() : 0);
+
+		for (int y = 0; y < surf->h; y++)
+			stream.write(surf->getBasePtr(0, y), surf->w * surf->format.bytesPerPixel);
+	}
+
+	stream.write(_ops->getData(), _ops->size());
+	stream.writeByte(kOpEnd);
+
+	return stream.flush() && !stream.err();
+}
+
+bool ThemeCache::load(Common::SeekableReadStream &stream, const Key &key, ThemeEngine &engine, Common::String &themeName) {
+	if (stream.readUint32BE() != kCacheTag || stream.readUint32BE() != kCacheVersion)
+		return false;
+
+	// Compare the key byte for byte with the one the file was written with
+	Common::MemoryWriteStreamDynamic expected(DisposeAfterUse::YES);
+	writeKey(expected, key);
+
+	Common::Array<byte> stored;
+	stored.resize(expected.size());
+	if (stream.read(stored.begin(), stored.size()) != stored.size() || memcmp(stored.begin(), expected.getData(), stored.size()))
+		return false;
+
+	themeName = readString(stream);
+
+	// Read all the bitmaps before touching the engine
+	Common::Array<CachedBitmap> bitmaps;
+	const uint32 count = stream.readUint32LE();
+	for (uint32 i = 0; i < count && !stream.err() && !stream.eos(); i++) {
+		CachedBitmap bitmap;
+		bitmap.name = readString(stream);
+		bitmap.surface = nullptr;
+
+		if (stream.readByte()) {
+			Graphics::PixelFormat format;
+			readFormat(stream, format);
+			const uint16 w = stream.readUint16LE();
+			const uint16 h = stream.readUint16LE();
+			const bool hasTransparentColor = stream.readByte() != 0;
+			const uint32 transparentColor = stream.readUint32LE();
+
+			if (format.bytesPerPixel < 2 || format.bytesPerPixel > 4 || stream.err() || stream.eos())
+				break;
+
+			bitmap.surface = new Graphics::ManagedSurface(w, h, format);
+			for (int y = 0; y < h; y++)
+				stream.read(bitmap.surface->getBasePtr(0, y), w * format.bytesPerPixel);
+
+			if (hasTransparentColor)
+				bitmap.surface->setTransparentColor(transparentColor);
+		}
+
+		bitmaps.push_back(bitmap);
+	}
+
+	if (bitmaps.size() != count || stream.err() || stream.eos()) {
+		freeBitmaps(bitmaps);
+		return false;
+	}
+
+	// Bitmaps which are already loaded would not have been loaded again
+	// by the parser either
+	for (uint i = 0; i < bitmaps.size(); i++) {
+		if (engine._bitmaps.contains(bitmaps[i].name) && engine._bitmaps[bitmaps[i].name]) {
+			delete bitmaps[i].surface;
+			continue;
+		}
+		engine._bitmaps[bitmaps[i].name] = bitmaps[i].surface;
+	}
+
+	return replay(stream, engine);
+}
+
+bool ThemeCache::replay(Common::SeekableReadStream &stream, ThemeEngine &engine) {
+	ThemeEval *eval = engine.getEvaluator();
+
+	while (!stream.err() && !stream.eos()) {
+		const byte op = stream.readByte();
+		if (stream.err() || stream.eos())
+			break;
+
+		switch (op) {
+		case kOpEnd:
+			return true;
+
+		case kOpDrawData: {
+			const Common::String data = readString(stream);
+			const bool cached = stream.readByte() != 0;
+			if (stream.err() || stream.eos() || !engine.addDrawData(data, cached))
+				return false;
+			break;
+		}
+
+		case kOpDrawStep: {
+			const Common::String drawDataId = readString(stream);
+			const byte drawingCall = stream.readByte();
+			const Common::String bitmap = readString(stream);
+
+			Graphics::DrawStep step;
+			if (drawingCall != kNoDrawingCall) {
+				if (drawingCall >= ARRAYSIZE(kDrawingCalls))
+					return false;
+				step.drawingCall = kDrawingCalls[drawingCall];
+			}
+			if (!bitmap.empty()) {
+				step.blitSrc = engine.getImageSurface(bitmap);
+				if (!step.blitSrc)
+					return false;
+			}
+			step.alphaType = (Graphics::AlphaType)stream.readByte();
+
+			readColor(stream, step.fgColor);
+			readColor(stream, step.bgColor);
+			readColor(stream, step.gradColor1);
+			readColor(stream, step.gradColor2);
+			readColor(stream, step.bevelColor);
+
+			step.autoWidth = stream.readByte() != 0;
+			step.autoHeight = stream.readByte() != 0;
+			step.x = stream.readSint16LE();
+			step.y = stream.readSint16LE();
+			step.w = stream.readSint16LE();
+			step.h = stream.readSint16LE();
+			readRect(stream, step.padding);
+			readRect(stream, step.clip);
+			step.xAlign = (Graphics::DrawStep::VectorAlignment)stream.readByte();
+			step.yAlign = (Graphics::DrawStep::VectorAlignment)stream.readByte();
+
+			step.shadow = stream.readByte();
+			step.stroke = stream.readByte();
+			step.factor = stream.readByte();
+			step.radius = stream.readByte();
+			step.bevel = stream.readByte();
+			step.fillMode = stream.readByte();
+			step.shadowFillMode = stream.readByte();
+			step.extraData = stream.readUint32LE();
+			step.scale = stream.readUint32LE();
+			step.shadowIntensity = stream.readUint32LE();
+			step.autoscale = (ThemeEngine::AutoScaleMode)stream.readByte();
+
+			// addDrawStep() asserts on unknown draw data
+			const DrawData id = engine.parseDrawDataId(drawDataId);
+			if (stream.err() || stream.eos() || id == kDDNone || !engine._widgets[id])
+				return false;
+			engine.addDrawStep(drawDataId, step);
+			break;
+		}
+
+		case kOpTextData: {
+			const Common::String drawDataId = readString(stream);
+			const TextData textId = (TextData)stream.readSint32LE();
+			const TextColor colorId = (TextColor)stream.readSint32LE();
+			const Graphics::TextAlign alignH = (Graphics::TextAlign)stream.readSint32LE();
+			const ThemeEngine::TextAlignVertical alignV = (ThemeEngine::TextAlignVertical)stream.readSint32LE();
+			if (stream.err() || stream.eos() || !engine.addTextData(drawDataId, textId, colorId, alignH, alignV))
+				return false;
+			break;
+		}
+
+		case kOpFont:
+		case kOpFontNames: {
+			const TextData textId = (TextData)stream.readSint32LE();
+			const Common::String language = readString(stream);
+			const Common::String file = readString(stream);
+			const Common::String scalableFile = readString(stream);
+			const int pointsize = stream.readSint32LE();
+			if (stream.err() || stream.eos() || textId < -1 || textId >= kTextDataMAX)
+				return false;
+
+			if (op == kOpFontNames)
+				engine.storeFontNames(textId, language, file, scalableFile, pointsize);
+			else if (!engine.addFont(textId, language, file, scalableFile, pointsize))
+				return false;
+			break;
+		}
+
+		case kOpTextColor: {
+			const TextColor colorId = (TextColor)stream.readSint32LE();
+			const int r = stream.readSint32LE();
+			const int g = stream.readSint32LE();
+			const int b = stream.readSint32LE();
+			if (stream.err() || stream.eos() || !engine.addTextColor(colorId, r, g, b))
+				return false;
+			break;
+		}
+
+		case kOpCursor: {
+			const Common::String filename = readString(stream);
+			const int hotspotX = stream.readSint32LE();
+			const int hotspotY = stream.readSint32LE();
+			if (stream.err() || stream.eos() || !engine.createCursor(filename, hotspotX, hotspotY))
+				return false;
+			break;
+		}
+
+		case kOpVar: {
+			const Common::String name = readString(stream);
+			const int val = stream.readSint32LE();
+			if (stream.err() || stream.eos())
+				return false;
+			eval->setVar(name, val);
+			break;
+		}
+
+		case kOpDialog: {
+			const Common::String name = readString(stream);
+			const Common::String overlays = readString(stream);
+			const int16 maxWidth = stream.readSint16LE();
+			const int16 maxHeight = stream.readSint16LE();
+			const int inset = stream.readSint32LE();
+			if (stream.err() || stream.eos())
+				return false;
+			eval->addDialog(name, overlays, maxWidth, maxHeight, inset);
+			break;
+		}
+
+		case kOpLayout: {
+			const ThemeLayout::LayoutType type = (ThemeLayout::LayoutType)stream.readSint32LE();
+			const int spacing = stream.readSint32LE();
+			const ThemeLayout::ItemAlign itemAlign = (ThemeLayout::ItemAlign)stream.readSint32LE();
+			if (stream.err() || stream.eos() || !eval->hasOpenLayout())
+				return false;
+			// ThemeLayoutStacked asserts on any other type
+			if (type != ThemeLayout::kLayoutVertical && type != ThemeLayout::kLayoutHorizontal)
+				return false;
+			eval->addLayout(type, spacing, itemAlign);
+			break;
+		}
+
+		case kOpWidget: {
+			const Common::String name = readString(stream);
+			const Common::String type = readString(stream);
+			const int w = stream.readSint32LE();
+			const int h = stream.readSint32LE();
+			const Graphics::TextAlign align = (Graphics::TextAlign)stream.readSint32LE();
+			const bool useRTL = stream.readByte() != 0;
+			if (stream.err() || stream.eos() || !eval->hasOpenLayout())
+				return false;
+			eval->addWidget(name, type, w, h, align, useRTL);
+			break;
+		}
+
+		case kOpImportedLayout: {
+			const Common::String name = readString(stream);
+			if (stream.err() || stream.eos() || !eval->hasOpenLayout() || !eval->hasDialog(name))
+				return false;
+			eval->addImportedLayout(name);
+			break;
+		}
+
+		case kOpSpace: {
+			const int size = stream.readSint32LE();
+			if (stream.err() || stream.eos() || !eval->hasOpenLayout())
+				return false;
+			eval->addSpace(size);
+			break;
+		}
+
+		case kOpPadding: {
+			const int16 l = stream.readSint16LE();
+			const int16 r = stream.readSint16LE();
+			const int16 t = stream.readSint16LE();
+			const int16 b = stream.readSint16LE();
+			if (stream.err() || stream.eos() || !eval->hasOpenLayout())
+				return false;
+			eval->addPadding(l, r, t, b);
+			break;
+		}
+
+		case kOpCloseLayout:
+			if (!eval->hasOpenLayout())
+				return false;
+			eval->closeLayout();
+			break;
+
+		case kOpCloseDialog:
+			if (!eval->hasOpenLayout())
+				return false;
+			eval->closeDialog();
+			break;
+
+		default:
+			return false;
+		}
+	}
+
+	return false;
+}
+
+} // End of namespace GUI
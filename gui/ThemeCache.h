@@ -0,0 +1,137 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GUI_THEME_CACHE_H
+#define GUI_THEME_CACHE_H
+
+#include "common/scummsys.h"
+#include "common/memstream.h"
+#include "common/noncopyable.h"
+#include "common/str.h"
+#include "common/str-array.h"
+#include "graphics/pixelformat.h"
+
+#include "gui/ThemeEngine.h"
+#include "gui/ThemeLayout.h"
+
+namespace GUI {
+
+/**
+ * A binary cache of a parsed theme.
+ *
+ * While a theme is parsed, ThemeEngine and ThemeEval pass every element
+ * added by the ThemeParser on to the cache, which records them in order,
+ * along with the bitmaps loaded for them. Loading the recording adds the
+ * same elements again, without parsing the STX files or rasterizing the
+ * SVG images.
+ *
+ * A recording is only valid for the theme contents, base resolution, scale
+ * factor and overlay format it was made with. All of them are stored in the
+ * header of the cache file and checked when loading it.
+ */
+class ThemeCache : Common::NonCopyable {
+public:
+	struct Key {
+		Common::String themeId;
+		uint32 themeHash;            ///< See ThemeEngine::computeThemeHash()
+		int16 baseWidth, baseHeight;
+		float scaleFactor;
+		Graphics::PixelFormat format; ///< Format of the bitmaps
+	};
+
+	ThemeCache() : _recording(false), _ops(nullptr) {}
+	~ThemeCache() { delete _ops; }
+
+	/** Forget the previous recording and record the elements added from now on. */
+	void startRecording();
+	void stopRecording() { _recording = false; }
+	bool isRecording() const { return _recording; }
+
+	/** Forget the recording, or give up on one which cannot be replayed. */
+	void clear();
+
+	void recordDrawData(const Common::String &data, bool cached);
+	void recordDrawStep(const Common::String &drawDataId, const Graphics::DrawStep &step, const Common::String &bitmap);
+	void recordTextData(const Common::String &drawDataId, TextData textId, TextColor colorId, Graphics::TextAlign alignH, ThemeEngine::TextAlignVertical alignV);
+	void recordFont(TextData textId, const Common::String &language, const Common::String &file, const Common::String &scalableFile, int pointsize);
+	void recordFontNames(TextData textId, const Common::String &language, const Common::String &file, const Common::String &scalableFile, int pointsize);
+	void recordTextColor(TextColor colorId, int r, int g, int b);
+	void recordBitmap(const Common::String &filename);
+	void recordCursor(const Common::String &filename, int hotspotX, int hotspotY);
+
+	void recordVar(const Common::String &name, int val);
+	void recordDialog(const Common::String &name, const Common::String &overlays, int16 maxWidth, int16 maxHeight, int inset);
+	void recordLayout(ThemeLayout::LayoutType type, int spacing, ThemeLayout::ItemAlign itemAlign);
+	void recordWidget(const Common::String &name, const Common::String &type, int w, int h, Graphics::TextAlign align, bool useRTL);
+	void recordImportedLayout(const Common::String &name);
+	void recordSpace(int size);
+	void recordPadding(int16 l, int16 r, int16 t, int16 b);
+	void recordCloseLayout();
+	void recordCloseDialog();
+
+	/**
+	 * Write the recording and the bitmaps it loaded.
+	 *
+	 * @param themeName The name from the THEMERC file of the theme.
+	 */
+	bool save(Common::WriteStream &stream, const Key &key, const Common::String &themeName, const ThemeEngine &engine) const;
+
+	/**
+	 * Add the elements of a cache file to the engine, if the file was made
+	 * for the given key. Elements may have been added even if this fails,
+	 * in which case the theme has to be unloaded.
+	 */
+	static bool load(Common::SeekableReadStream &stream, const Key &key, ThemeEngine &engine, Common::String &themeName);
+
+private:
+	enum Op {
+		kOpEnd,
+		kOpDrawData,
+		kOpDrawStep,
+		kOpTextData,
+		kOpFont,
+		kOpFontNames,
+		kOpTextColor,
+		kOpCursor,
+		kOpVar,
+		kOpDialog,
+		kOpLayout,
+		kOpWidget,
+		kOpImportedLayout,
+		kOpSpace,
+		kOpPadding,
+		kOpCloseLayout,
+		kOpCloseDialog
+	};
+
+	static void writeKey(Common::WriteStream &stream, const Key &key);
+	static void writeString(Common::WriteStream &stream, const Common::String &str);
+	static Common::String readString(Common::ReadStream &stream);
+	static bool replay(Common::SeekableReadStream &stream, ThemeEngine &engine);
+
+	bool _recording;
+	Common::MemoryWriteStreamDynamic *_ops;
+	Common::StringArray _bitmaps;
+};
+
+} // End of namespace GUI
+
+#endif
@@ -21,6 +21,7 @@
 
 #include "common/system.h"
 #include "common/config-manager.h"
+#include "common/crc.h"
 #include "common/file.h"
 #include "common/fs.h"
 #include "common/compression/unzip.h"
@@ -41,6 +42,8 @@
 #include "image/png.h"
 
 #include "gui/widget.h"
+#include "gui/DrawDataCache.h"
+#include "gui/ThemeCache.h"
 #include "gui/ThemeEngine.h"
 #include "gui/ThemeEval.h"
 #include "gui/ThemeParser.h"
@@ -83,6 +86,9 @@ struct WidgetDrawData {
 	uint16 _backgroundOffset;
 	uint16 _shadowOffset;
 
+	/** Whether the result of the steps is kept in the DrawDataCache, see DrawDataCache::canCache() */
+	bool _cacheable;
+
 	DrawLayer _layer;
 
 
@@ -96,6 +102,9 @@ struct WidgetDrawData {
 	void calcBackgroundOffset();
 };
 
+/** Upper limit for the pixels kept by the DrawDataCache. */
+static const uint32 kDrawDataCacheSize = 8 * 1024 * 1024;
+
 /**********************************************************
  *  Data definitions for theme engine elements
  *********************************************************/
@@ -198,6 +207,9 @@ ThemeEngine::ThemeEngine(Common::String id, GraphicsMode mode) :
 	_parser = new ThemeParser(this);
 	_themeEval = new GUI::ThemeEval();
 	_themeEval->setScaleFactor(_scaleFactor);
+	_themeCache = new GUI::ThemeCache();
+	_drawDataCache = new DrawDataCache(kDrawDataCacheSize);
+	_themeEval->setCache(_themeCache);
 
 	_useCursor = false;
 
@@ -245,6 +257,7 @@ ThemeEngine::~ThemeEngine() {
 
 	unloadTheme();
 	unloadExtraFont();
+	delete _drawDataCache;
 
 	// Release all graphics surfaces
 	for (auto &bitmap : _bitmaps) {
@@ -258,6 +271,7 @@ ThemeEngine::~ThemeEngine() {
 
 	delete _parser;
 	delete _themeEval;
+	delete _themeCache;
 	delete[] _cursor;
 }
 
@@ -463,6 +477,7 @@ void ThemeEngine::setGraphicsMode(GraphicsMode mode) {
 	delete _vectorRenderer;
 	_vectorRenderer = Graphics::createRenderer(mode);
 	_vectorRenderer->setSurface(&_screen);
+	_drawDataCache->clear();
 
 	// Since we reinitialized our screen surfaces we know nothing has been
 	// drawn so far. Sometimes we still end up with dirty screen bits in the
@@ -484,6 +499,7 @@ void WidgetDrawData::calcBackgroundOffset() {
 
 	_backgroundOffset = maxBevel;
 	_shadowOffset = maxShadow;
+	_cacheable = DrawDataCache::canCache(_steps);
 }
 
 void ThemeEngine::restoreBackground(Common::Rect r) {
@@ -506,6 +522,15 @@ void ThemeEngine::restoreBackground(Common::Rect r) {
 void ThemeEngine::addDrawStep(const Common::String &drawDataId, const Graphics::DrawStep &step) {
 	DrawData id = parseDrawDataId(drawDataId);
 
+	Common::String bitmap;
+	if (step.blitSrc && _themeCache->isRecording()) {
+		for (const auto &entry : _bitmaps) {
+			if (entry._value == step.blitSrc)
+				bitmap = entry._key;
+		}
+	}
+	_themeCache->recordDrawStep(drawDataId, step, bitmap);
+
 	assert(id != kDDNone && _widgets[id] != nullptr);
 	_widgets[id]->_steps.push_back(step);
 }
@@ -513,6 +538,8 @@ void ThemeEngine::addDrawStep(const Common::String &drawDataId, const Graphics::
 bool ThemeEngine::addTextData(const Common::String &drawDataId, TextData textId, TextColor colorId, Graphics::TextAlign alignH, TextAlignVertical alignV) {
 	DrawData id = parseDrawDataId(drawDataId);
 
+	_themeCache->recordTextData(drawDataId, textId, colorId, alignH, alignV);
+
 	if (id == -1 || textId == -1 || colorId == kTextColorMAX || !_widgets[id])
 		return false;
 
@@ -525,6 +552,8 @@ bool ThemeEngine::addTextData(const Common::String &drawDataId, TextData textId,
 }
 
 bool ThemeEngine::addFont(TextData textId, const Common::String &language, const Common::String &file, const Common::String &scalableFile, const int pointsize) {
+	_themeCache->recordFont(textId, language, file, scalableFile, pointsize);
+
 	if (textId == -1)
 		return false;
 
@@ -604,6 +633,8 @@ Common::Array<Common::Language> getLangIdentifiers(const Common::String &languag
 }
 
 void ThemeEngine::storeFontNames(TextData textId, const Common::String &language, const Common::String &file, const Common::String &scalableFile, const int pointsize) {
+	_themeCache->recordFontNames(textId, language, file, scalableFile, pointsize);
+
 	if (language.empty())
 		return;
 
@@ -630,6 +661,8 @@ bool ThemeEngine::loadExtraFont(FontStyle style, Common::Language lang) {
 }
 
 bool ThemeEngine::addTextColor(TextColor colorId, int r, int g, int b) {
+	_themeCache->recordTextColor(colorId, r, g, b);
+
 	if (colorId >= kTextColorMAX)
 		return false;
 
@@ -646,6 +679,8 @@ bool ThemeEngine::addTextColor(TextColor colorId, int r, int g, int b) {
 }
 
 bool ThemeEngine::addBitmap(const Common::String &filename, const Common::String &scalablefile, int width, int height) {
+	_themeCache->recordBitmap(filename);
+
 	// Nothing has to be done if the bitmap already has been loaded.
 	Graphics::ManagedSurface *surf = _bitmaps[filename];
 	if (surf) {
@@ -740,6 +775,8 @@ bool ThemeEngine::addBitmap(const Common::String &filename, const Common::String
 bool ThemeEngine::addDrawData(const Common::String &data, bool cached) {
 	DrawData id = parseDrawDataId(data);
 
+	_themeCache->recordDrawData(data, cached);
+
 	if (id == -1)
 		return false;
 
@@ -749,6 +786,7 @@ bool ThemeEngine::addDrawData(const Common::String &data, bool cached) {
 	_widgets[id] = new WidgetDrawData;
 	_widgets[id]->_layer = kDrawDataDefaults[id].layer;
 	_widgets[id]->_textDataId = kTextDataNone;
+	_widgets[id]->_cacheable = false;
 
 	return true;
 }
@@ -764,6 +802,8 @@ void ThemeEngine::loadTheme(const Common::String &themeId) {
 
 	if (themeId == "builtin") {
 		_themeOk = loadDefaultXML();
+	} else if (ConfMan.getBool("gui_theme_cache")) {
+		_themeOk = loadThemeCached(themeId);
 	} else {
 		// Load the archive containing image and XML data
 		_themeOk = loadThemeXML(themeId);
@@ -808,6 +848,7 @@ void ThemeEngine::unloadTheme() {
 	}
 
 	_themeEval->reset();
+	_drawDataCache->clear();
 	_themeOk = false;
 }
 
@@ -911,6 +952,117 @@ bool ThemeEngine::loadThemeXML(const Common::String &themeId) {
 	return true;
 }
 
+uint32 ThemeEngine::computeThemeHash() const {
+	if (!_themeArchive || _themeFile.empty())
+		return 0;
+
+	Common::CRC32 crc;
+	uint32 hash = 0;
+
+	Common::FSNode node(_themeFile);
+	if (node.isDirectory()) {
+		// Combine the names and contents of the members, whatever order
+		// they are listed in. The members of a theme are small, and this
+		// catches edits that keep the size of a file.
+		Common::ArchiveMemberList members;
+		_themeArchive->listMembers(members);
+
+		byte buffer[4096];
+		for (auto &member : members) {
+			Common::SeekableReadStream *stream = member->createReadStream();
+			if (!stream)
+				return 0;
+
+			const Common::String name = member->getName();
+			uint32 remainder = crc.update(crc.getInitRemainder(), (const byte *)name.c_str(), name.size() + 1);
+			uint32 read;
+			while ((read = stream->read(buffer, sizeof(buffer))) > 0)
+				remainder = crc.update(remainder, buffer, read);
+
+			const bool failed = stream->err();
+			delete stream;
+			if (failed)
+				return 0;
+
+			hash += crc.finalize(remainder);
+		}
+	} else {
+		// Look for the zip file the same way init() does
+		Common::ArchiveMemberPtr member = SearchMan.getMember(_themeFile);
+		Common::SeekableReadStream *stream = member ? member->createReadStream() : node.createReadStream();
+		if (!stream)
+			return 0;
+
+		// The central directory at the end of the zip file holds the CRC
+		// and size of every member, so there is no need to read the rest
+		const uint32 tailSize = MIN<int64>(stream->size(), 64 * 1024);
+		byte *tail = (byte *)malloc(tailSize);
+		stream->seek(-(int32)tailSize, SEEK_END);
+		if (!tail || stream->read(tail, tailSize) != tailSize) {
+			free(tail);
+			delete stream;
+			return 0;
+		}
+
+		hash = crc.crcFast(tail, tailSize) ^ (uint32)stream->size();
+		free(tail);
+		delete stream;
+	}
+
+	return hash ? hash : 1;
+}
+
+bool ThemeEngine::loadThemeCached(const Common::String &themeId) {
+	ThemeCache::Key key;
+	key.themeId = _themeId;
+	key.themeHash = computeThemeHash();
+	key.baseWidth = _baseWidth;
+	key.baseHeight = _baseHeight;
+	key.scaleFactor = _scaleFactor;
+	key.format = _overlayFormat;
+
+	const Common::FSNode cacheDir(ConfMan.getPath("themecachepath"));
+	if (!key.themeHash || ConfMan.getPath("themecachepath").empty() || !cacheDir.isDirectory())
+		return loadThemeXML(themeId);
+
+	// There is a single file per theme, which is replaced whenever the theme,
+	// the resolution or the scale factor changes
+	const Common::FSNode cacheFile = cacheDir.getChild(_themeId + ".cache");
+
+	Common::SeekableReadStream *in = cacheFile.exists() ? cacheFile.createReadStream() : nullptr;
+	if (in) {
+		const bool loaded = ThemeCache::load(*in, key, *this, _themeName);
+		delete in;
+
+		if (loaded) {
+			debug(6, "Loaded theme %s from '%s'", themeId.c_str(), cacheFile.getPath().toString(Common::Path::kNativeSeparator).c_str());
+			return true;
+		}
+
+		// Throw away whatever the cache added before it turned out to be unusable
+		_themeOk = true;
+		unloadTheme();
+	}
+
+	_themeCache->startRecording();
+	const bool result = loadThemeXML(themeId);
+	_themeCache->stopRecording();
+
+	if (result) {
+		// The write is atomic, so a failed one leaves the previous file behind,
+		// which is rejected by its key next time
+		Common::SeekableWriteStream *out = cacheFile.createWriteStream();
+		if (out) {
+			_themeCache->save(*out, key, _themeName, *this);
+			out->finalize();
+			delete out;
+		}
+	}
+
+	_themeCache->clear();
+	return result;
+}
+
 
 
 /**********************************************************
@@ -934,6 +1086,7 @@ void ThemeEngine::drawDD(DrawData type, const Common::Rect &r, uint32 dynamic, b
 		extendedRect.right += drawData->_shadowOffset - drawData->_backgroundOffset;
 		extendedRect.bottom += drawData->_shadowOffset - drawData->_backgroundOffset;
 	}
+	const Common::Rect stepsRect = extendedRect;
 
 	if (!_clip.isEmpty()) {
 		extendedRect.clip(_clip);
@@ -948,9 +1101,13 @@ void ThemeEngine::drawDD(DrawData type, const Common::Rect &r, uint32 dynamic, b
 		restoreBackground(extendedRect);
 
 	if (drawData->_layer == _layerToDraw) {
-		Common::List<Graphics::DrawStep>::const_iterator step;
-		for (step = drawData->_steps.begin(); step != drawData->_steps.end(); ++step) {
-			_vectorRenderer->drawStep(area, _clip, *step, dynamic);
+		if (drawData->_cacheable) {
+			_drawDataCache->drawSteps(_vectorRenderer, type, drawData->_steps, area, stepsRect, _clip, dynamic);
+		} else {
+			Common::List<Graphics::DrawStep>::const_iterator step;
+			for (step = drawData->_steps.begin(); step != drawData->_steps.end(); ++step) {
+				_vectorRenderer->drawStep(area, _clip, *step, dynamic);
+			}
 		}
 
 		addDirtyRect(extendedRect);
@@ -1556,6 +1713,22 @@ void ThemeEngine::addDirtyRect(Common::Rect r) {
 			++it;
 	}
 
+	// Merge it with the rectangles it overlaps, unless that makes it cover
+	// more than the two of them do, so the overlap is not copied twice
+	for (it = _dirtyScreen.begin(); it != _dirtyScreen.end();) {
+		if (it->intersects(r)) {
+			Common::Rect merged = r;
+			merged.extend(*it);
+			if (merged.width() * merged.height() <= r.width() * r.height() + it->width() * it->height()) {
+				r = merged;
+				_dirtyScreen.erase(it);
+				it = _dirtyScreen.begin();
+				continue;
+			}
+		}
+		++it;
+	}
+
 	// If we got here, we can safely add r to the list of dirty rects.
 	_dirtyScreen.push_back(r);
 }
@@ -1580,6 +1753,8 @@ void ThemeEngine::applyScreenShading(ShadingStyle style) {
 }
 
 bool ThemeEngine::createCursor(const Common::String &filename, int hotspotX, int hotspotY) {
+	_themeCache->recordCursor(filename, hotspotX, hotspotY);
+
 	// Try to locate the specified file among all loaded bitmaps
 	const Graphics::ManagedSurface *cursor = _bitmaps[filename];
 	if (!cursor)
@@ -49,8 +49,10 @@ namespace GUI {
 
 struct WidgetDrawData;
 struct TextDrawData;
+class DrawDataCache;
 class Dialog;
 class GuiObject;
+class ThemeCache;
 class ThemeEval;
 class ThemeParser;
 
@@ -212,6 +214,7 @@ protected:
 
 	friend class GUI::Dialog;
 	friend class GUI::GuiObject;
+	friend class GUI::ThemeCache;
 
 public:
 	/// Vertical alignment of the text.
@@ -634,6 +637,7 @@ protected:
 
 public:
 	inline ThemeEval *getEvaluator() { return _themeEval; }
+	inline ThemeCache *getThemeCache() { return _themeCache; }
 	inline Graphics::VectorRenderer *renderer() { return _vectorRenderer; }
 
 	inline bool supportsImages() const { return true; }
@@ -675,6 +679,22 @@ protected:
 	 */
 	bool loadThemeXML(const Common::String &themeId);
 
+	/**
+	 * Loads the given theme from the theme cache, or parses it with
+	 * loadThemeXML() and writes the cache file for the next time.
+	 *
+	 * @param themeId Theme identifier.
+	 * @returns true if the theme was successfully loaded.
+	 */
+	bool loadThemeCached(const Common::String &themeId);
+
+	/**
+	 * Computes a checksum which changes with the theme files, from the
+	 * central directory of the zip file or the names and contents of the
+	 * files of a theme directory. Returns 0 if they cannot be read.
+	 */
+	uint32 computeThemeHash() const;
+
 	/**
 	 * Loads the default theme file (the embedded XML file found
 	 * in ThemeDefaultXML.cpp).
@@ -756,6 +776,9 @@ protected:
 	/** Theme getEvaluator (changed from GUI::Eval to add functionality) */
 	GUI::ThemeEval *_themeEval;
 
+	/** Records the parsed theme, so the next start can skip parsing it */
+	GUI::ThemeCache *_themeCache;
+
 	/** Main screen surface. This is blitted straight into the overlay. */
 	Graphics::ManagedSurface _screen;
 
@@ -807,6 +830,9 @@ protected:
 	/** List of all the dirty screens that must be blitted to the overlay. */
 	Common::List<Common::Rect> _dirtyScreen;
 
+	/** Results of drawing the cacheable DrawData items. */
+	DrawDataCache *_drawDataCache;
+
 	bool _initOk;  ///< Class and renderer properly initialized
 	bool _themeOk; ///< Theme data successfully loaded.
 	bool _enabled; ///< Whether the Theme is currently shown on the overlay
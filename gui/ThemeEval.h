@@ -30,6 +30,7 @@
 #include "common/textconsole.h"
 #include "graphics/font.h"
 
+#include "gui/ThemeCache.h"
 #include "gui/ThemeLayout.h"
 
 namespace GUI {
@@ -40,7 +41,7 @@ class ThemeEval {
 	typedef Common::HashMap<Common::String, ThemeLayout *> LayoutsMap;
 
 public:
-	ThemeEval() : _scaleFactor(1.0f) {
+	ThemeEval() : _scaleFactor(1.0f), _useRTL(false), _cache(nullptr) {
 		buildBuiltinVars();
 	}
 
@@ -70,8 +71,20 @@ public:
 	}
 
 	void setScaleFactor(float s) { _scaleFactor = s; }
+	float getScaleFactor() const { return _scaleFactor; }
 
-	void setVar(const Common::String &name, int val) { _vars[name] = val; }
+	/** Mirror the dialogs on the X axis, see GuiManager::useRTL(). */
+	void setRTL(bool useRTL) { _useRTL = useRTL; }
+	bool useRTL() const { return _useRTL; }
+
+	/** Set the cache which records the layouts added while it is recording. */
+	void setCache(ThemeCache *cache) { _cache = cache; }
+
+	void setVar(const Common::String &name, int val) {
+		if (_cache)
+			_cache->recordVar(name, val);
+		_vars[name] = val;
+	}
 
 	bool hasVar(const Common::String &name) { return _vars.contains(name) || _builtin.contains(name); }
 
@@ -83,8 +96,22 @@ public:
 
 	ThemeEval &addPadding(int16 l, int16 r, int16 t, int16 b);
 
-	ThemeEval &closeLayout() { _curLayout.pop(); return *this; }
-	ThemeEval &closeDialog() { _curLayout.pop(); _curDialog.clear(); return *this; }
+	ThemeEval &closeLayout() {
+		if (_cache)
+			_cache->recordCloseLayout();
+		_curLayout.pop();
+		return *this;
+	}
+
+	ThemeEval &closeDialog() {
+		if (_cache)
+			_cache->recordCloseDialog();
+		_curLayout.pop();
+		_curDialog.clear();
+		return *this;
+	}
+
+	bool hasOpenLayout() const { return !_curLayout.empty(); }
 
 	bool hasDialog(const Common::String &name);
 
@@ -120,6 +147,8 @@ private:
 	Common::String _curDialog;
 
 	float _scaleFactor;
+	bool _useRTL;
+	ThemeCache *_cache;
 };
 
 } // End of namespace GUI
@@ -22,7 +22,6 @@
 #include "common/util.h"
 #include "common/system.h"
 
-#include "gui/gui-manager.h"
 #include "gui/widget.h"
 #include "gui/ThemeEval.h"
 #include "gui/ThemeLayout.h"
@@ -234,13 +233,13 @@ void ThemeLayoutMain::reflowLayout(Widget *widgetChain) {
 	SafeAreaType safeAreaType;
 
 	// With RTL, we just flip everything on the X axis, so do the same with the safeArea
-	if (g_gui.useRTL()) {
+	if (_eval->useRTL()) {
 		int16 tmp = safeArea.left;
 		safeArea.left = screenW - safeArea.right;
 		safeArea.right = screenW - tmp;
 	}
 
-	int inset = _inset * g_gui.getScaleFactor();
+	int inset = _inset * _eval->getScaleFactor();
 
 	if (_overlays == "screen") {
 		_x = MAX(inset, (int)safeArea.left);
@@ -258,7 +257,7 @@ void ThemeLayoutMain::reflowLayout(Widget *widgetChain) {
 		_h = _defaultH > 0 ? MIN(_defaultH - 2*inset, (int)safeArea.height()) : -1;
 		safeAreaType = kSafeAreaMove;
 	} else {
-		if (!g_gui.xmlEval()->getWidgetData(_overlays, _x, _y, _w, _h)) {
+		if (!_eval->getWidgetData(_overlays, _x, _y, _w, _h)) {
 			warning("Unable to retrieve overlayed dialog position %s", _overlays.c_str());
 		}
 
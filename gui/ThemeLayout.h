@@ -36,6 +36,7 @@ struct Surface;
 
 namespace GUI {
 
+class ThemeEval;
 class Widget;
 
 class ThemeLayout {
@@ -142,8 +143,9 @@ protected:
 
 class ThemeLayoutMain : public ThemeLayout {
 public:
-	ThemeLayoutMain(const Common::String &name, const Common::String &overlays, int16 width, int16 height, int inset) :
+	ThemeLayoutMain(ThemeEval *eval, const Common::String &name, const Common::String &overlays, int16 width, int16 height, int inset) :
 			ThemeLayout(nullptr),
+			_eval(eval),
 			_name(name),
 			_overlays(overlays),
 			_inset(inset) {
@@ -169,6 +171,7 @@ protected:
 	int16 _defaultX;
 	int16 _defaultY;
 
+	ThemeEval *_eval; ///< The evaluator holding this dialog, and the one it overlays
 	Common::String _name;
 	Common::String _overlays;
 	int _inset;
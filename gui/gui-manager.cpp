@@ -320,6 +320,7 @@ bool GuiManager::loadNewTheme(Common::String id, ThemeEngine::GraphicsMode gfx,
 	newTheme = new ThemeEngine(id, gfx);
 	assert(newTheme);
 	newTheme->setBaseResolution(_baseWidth, _baseHeight, _scaleFactor);
+	newTheme->getEvaluator()->setRTL(_useRTL);
 
 	if (!newTheme->init()) {
 		delete newTheme;
@@ -923,19 +924,23 @@ void GuiManager::setLastMousePos(int16 x, int16 y) {
 }
 
 void GuiManager::setLanguageRTL() {
-	if (ConfMan.hasKey("guiRTL")) {		// Put guiRTL = yes to your scummvm.ini to force RTL GUI
-		_useRTL = ConfMan.getBool("guiRTL");
-		return;
-	}
+	_useRTL = isLanguageRTL();
+
+	// The dialog layouts of the theme are mirrored too
+	if (_theme)
+		_theme->getEvaluator()->setRTL(_useRTL);
+}
+
+bool GuiManager::isLanguageRTL() const {
+	if (ConfMan.hasKey("guiRTL"))		// Put guiRTL = yes to your scummvm.ini to force RTL GUI
+		return ConfMan.getBool("guiRTL");
 #ifdef USE_TRANSLATION
 	Common::String language = TransMan.getCurrentLanguage();
-	if (language.equals("he") || language.equals("ar")) {		// GUI TODO: modify when we'll support other RTL languages, such as Arabic and Farsi
-		_useRTL = true;
-		return;
-	}
+	if (language.equals("he") || language.equals("ar"))		// GUI TODO: modify when we'll support other RTL languages, such as Arabic and Farsi
+		return true;
 #endif // USE_TRANSLATION
 
-	_useRTL = false;
+	return false;
 }
 
 void GuiManager::initTextToSpeech() {
@@ -239,6 +239,8 @@ protected:
 	void giveFocusToDialog(Dialog *dialog);
 	void setLastMousePos(int16 x, int16 y);
 
+	bool isLanguageRTL() const;
+
 	void emptyTrash(Dialog *const activeDialog);
 };
 
@@ -7,6 +7,7 @@ MODULE_OBJS := \
 	console.o \
 	debugger.o \
 	dialog.o \
+	DrawDataCache.o \
 	dump-all-dialogs.o \
 	editgamedialog.o \
 	error.o \
@@ -27,6 +28,7 @@ MODULE_OBJS := \
 	shaderbrowser-dialog.o \
 	textviewer.o \
 	themebrowser.o \
+	ThemeCache.o \
 	ThemeEngine.o \
 	ThemeEval.o \
 	ThemeLayout.o \
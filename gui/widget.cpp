@@ -168,16 +168,6 @@ Widget *Widget::findWidgetInChain(Widget *w, int x, int y) {
 	return w;
 }
 
-Widget *Widget::findWidgetInChain(Widget *w, const char *name) {
-	while (w) {
-		if (w->_name == name) {
-			return w;
-		}
-		w = w->_next;
-	}
-	return nullptr;
-}
-
 Widget *Widget::findWidgetInChain(Widget *w, uint32 type) {
 	while (w) {
 		if (w->_type == type) {
@@ -114,7 +114,11 @@ private:
 
 public:
 	static Widget *findWidgetInChain(Widget *start, int x, int y);
-	static Widget *findWidgetInChain(Widget *start, const char *name);
+	static Widget *findWidgetInChain(Widget *start, const char *name) {
+		while (start && start->_name != name)
+			start = start->_next;
+		return start;
+	}
 	static Widget *findWidgetInChain(Widget *w, uint32 type);
 	static bool containsWidgetInChain(Widget *start, Widget *search);
 
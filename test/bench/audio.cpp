@@ -0,0 +1,77 @@
+#include "bench.h"
+
+#include "audio/audiostream.h"
+#include "audio/mixer.h"
+#include "audio/rate.h"
+
+namespace Bench {
+
+namespace {
+
+/** An endless square wave, which costs next to nothing to generate. */
+class SquareWaveStream : public Audio::AudioStream {
+public:
+	SquareWaveStream(int rate, bool stereo) : _rate(rate), _stereo(stereo), _pos(0) {}
+
+	int readBuffer(int16 *buffer, const int numSamples) override {
+		for (int i = 0; i < numSamples; i++)
+			buffer[i] = ((_pos++ >> 6) & 1) ? 8000 : -8000;
+		return numSamples;
+	}
+
+	bool isStereo() const override { return _stereo; }
+	int getRate() const override { return _rate; }
+	bool endOfData() const override { return false; }
+
+private:
+	int _rate;
+	bool _stereo;
+	uint _pos;
+};
+
+/** Convert one mixer buffer's worth of audio per iteration. */
+class RateConverterBenchmark : public Benchmark {
+public:
+	RateConverterBenchmark(const char *name, int inRate, int outRate, bool inStereo)
+		: Benchmark(name, kOutputFrames * 2 * sizeof(int16)),
+		  _inRate(inRate), _outRate(outRate), _inStereo(inStereo), _stream(nullptr), _converter(nullptr) {}
+
+	void setUp() override {
+		_stream = new SquareWaveStream(_inRate, _inStereo);
+		_converter = Audio::makeRateConverter(_inRate, _outRate, _inStereo, true, false);
+	}
+
+	void run(uint iterations) override {
+		for (uint n = 0; n < iterations; n++) {
+			memset(_buffer, 0, sizeof(_buffer));
+			_converter->convert(*_stream, _buffer, kOutputFrames, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume);
+		}
+		doNotOptimize(_buffer[0]);
+	}
+
+	void tearDown() override {
+		delete _converter;
+		delete _stream;
+	}
+
+private:
+	enum {
+		kOutputFrames = 2048
+	};
+
+	int _inRate, _outRate;
+	bool _inStereo;
+	Audio::AudioStream *_stream;
+	Audio::RateConverter *_converter;
+	Audio::st_sample_t _buffer[kOutputFrames * 2];
+};
+
+} // End of anonymous namespace
+
+void addAudioBenchmarks(BenchmarkList &list) {
+	list.push_back(new RateConverterBenchmark("audio/rate_copy_44100_stereo", 44100, 44100, true));
+	list.push_back(new RateConverterBenchmark("audio/rate_up_22050_mono", 22050, 44100, false));
+	list.push_back(new RateConverterBenchmark("audio/rate_up_11025_stereo", 11025, 48000, true));
+}
+
+} // End of namespace Bench
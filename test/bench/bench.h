@@ -0,0 +1,55 @@
+#ifndef TEST_BENCH_BENCH_H
+#define TEST_BENCH_BENCH_H
+
+#include "common/array.h"
+#include "common/str.h"
+
+namespace Bench {
+
+/**
+ * A micro-benchmark. The harness calls run() with an increasing number of
+ * iterations until a call takes long enough to be timed reliably, then
+ * times a number of calls with that iteration count.
+ *
+ * Anything which should not be timed, like creating the input data,
+ * belongs in setUp() and tearDown().
+ */
+class Benchmark {
+public:
+	/**
+	 * @param name                Name of the benchmark, "group/case" by convention.
+	 * @param bytesPerIteration   Amount of data one iteration processes,
+	 *                            to report a throughput; 0 if meaningless.
+	 */
+	Benchmark(const Common::String &name, uint64 bytesPerIteration = 0)
+		: _name(name), _bytesPerIteration(bytesPerIteration) {}
+	virtual ~Benchmark() {}
+
+	virtual void setUp() {}
+	virtual void run(uint iterations) = 0;
+	virtual void tearDown() {}
+
+	const Common::String &getName() const { return _name; }
+	uint64 getBytesPerIteration() const { return _bytesPerIteration; }
+
+protected:
+	Common::String _name;
+	uint64 _bytesPerIteration;
+};
+
+typedef Common::Array<Benchmark *> BenchmarkList;
+
+/**
+ * Keep the compiler from optimizing away a computation whose result is
+ * otherwise unused.
+ */
+void doNotOptimize(uint32 value);
+
+// Each benchmark file provides one of these, called by the runner.
+void addCommonBenchmarks(BenchmarkList &list);
+void addGraphicsBenchmarks(BenchmarkList &list);
+void addAudioBenchmarks(BenchmarkList &list);
+
+} // End of namespace Bench
+
+#endif
@@ -0,0 +1,306 @@
+#include "bench.h"
+
+#include "common/bufferedstream.h"
+#include "common/crc.h"
+#include "common/flat-hashmap.h"
+#include "common/frame-arena.h"
+#include "common/hash-str.h"
+#include "common/md5.h"
+#include "common/memstream.h"
+#include "common/compression/deflate.h"
+
+namespace Bench {
+
+namespace {
+
+/** Fill data with bytes which compress about as well as typical game data. */
+void fillCompressible(byte *data, uint size) {
+	uint32 seed = 1;
+	for (uint i = 0; i < size; i++) {
+		seed = seed * 1103515245 + 12345;
+		data[i] = (seed >> 24) < 64 ? (byte)(seed >> 16) : (byte)(i / 16);
+	}
+}
+
+Common::String resourceName(uint i) {
+	return Common::String::format("resource/%04u/file%u.dat", i / 16, i);
+}
+
+/** Look up every key of a map holding count string keys. */
+template<class Map>
+class StringLookupBenchmark : public Benchmark {
+public:
+	StringLookupBenchmark(const char *name, uint count) : Benchmark(name), _count(count) {}
+
+	void setUp() override {
+		for (uint i = 0; i < _count; i++) {
+			_keys.push_back(resourceName(i));
+			_map[_keys[i]] = i;
+			_missing.push_back(resourceName(i) + ".bak");
+		}
+	}
+
+	void run(uint iterations) override {
+		uint32 sum = 0;
+		for (uint n = 0; n < iterations; n++) {
+			const uint i = n % _count;
+			sum += _map.getValOrDefault(_keys[i]);
+			sum += _map.contains(_missing[i]);
+		}
+		doNotOptimize(sum);
+	}
+
+	void tearDown() override {
+		_map.clear(true);
+		_keys.clear();
+		_missing.clear();
+	}
+
+private:
+	uint _count;
+	Map _map;
+	Common::Array<Common::String> _keys, _missing;
+};
+
+/** Fill a map with count integer keys, iterate over it and empty it again. */
+template<class Map>
+class IntChurnBenchmark : public Benchmark {
+public:
+	IntChurnBenchmark(const char *name, uint count) : Benchmark(name), _count(count) {}
+
+	void run(uint iterations) override {
+		uint32 sum = 0;
+		for (uint n = 0; n < iterations; n++) {
+			Map map;
+			for (uint i = 0; i < _count; i++)
+				map[i * 7919] = i;
+			for (typename Map::const_iterator i = map.begin(); i != map.end(); ++i)
+				sum += i->_value;
+			for (uint i = 0; i < _count; i += 2)
+				map.erase(i * 7919);
+			sum += map.size();
+		}
+		doNotOptimize(sum);
+	}
+
+private:
+	uint _count;
+};
+
+class ArrayPushBackBenchmark : public Benchmark {
+public:
+	ArrayPushBackBenchmark() : Benchmark("array/push_back_1k", 1024 * sizeof(uint32)) {}
+
+	void run(uint iterations) override {
+		uint32 sum = 0;
+		for (uint n = 0; n < iterations; n++) {
+			Common::Array<uint32> array;
+			for (uint32 i = 0; i < 1024; i++)
+				array.push_back(i);
+			sum += array[n & 1023];
+		}
+		doNotOptimize(sum);
+	}
+};
+
+/** Allocate and release 256 small objects of varying size, as a frame would. */
+class SmallAllocBenchmark : public Benchmark {
+public:
+	SmallAllocBenchmark(const char *name, bool useArena) : Benchmark(name), _useArena(useArena) {}
+
+	void run(uint iterations) override {
+		void *objects[kCount];
+		uint32 sum = 0;
+
+		for (uint n = 0; n < iterations; n++) {
+			for (uint i = 0; i < kCount; i++) {
+				const size_t size = 16 + (i & 7) * 8;
+				objects[i] = _useArena ? _arena.allocate(size) : malloc(size);
+				*(uint32 *)objects[i] = i;
+			}
+			for (uint i = 0; i < kCount; i++)
+				sum += *(uint32 *)objects[i];
+
+			if (_useArena) {
+				_arena.reset();
+			} else {
+				for (uint i = 0; i < kCount; i++)
+					free(objects[i]);
+			}
+		}
+		doNotOptimize(sum);
+	}
+
+private:
+	enum {
+		kCount = 256
+	};
+
+	bool _useArena;
+	Common::FrameArena _arena;
+};
+
+class StringBuildBenchmark : public Benchmark {
+public:
+	StringBuildBenchmark() : Benchmark("string/build_compare") {}
+
+	void run(uint iterations) override {
+		uint32 sum = 0;
+		for (uint n = 0; n < iterations; n++) {
+			Common::String path("engines/");
+			path += "scumm";
+			path += '/';
+			path += resourceName(n & 255);
+			sum += path.hasSuffixIgnoreCase(".DAT");
+			sum += path.equalsIgnoreCase("ENGINES/SCUMM/RESOURCE/0000/FILE0.DAT");
+			sum += path.hash();
+		}
+		doNotOptimize(sum);
+	}
+};
+
+/** Base for benchmarks working on a buffer of compressible data. */
+class DataBenchmark : public Benchmark {
+public:
+	DataBenchmark(const char *name, uint size) : Benchmark(name, size), _size(size), _data(nullptr) {}
+
+	void setUp() override {
+		_data = new byte[_size];
+		fillCompressible(_data, _size);
+	}
+
+	void tearDown() override {
+		delete[] _data;
+		_data = nullptr;
+	}
+
+protected:
+	uint _size;
+	byte *_data;
+};
+
+class MemoryReadStreamBenchmark : public DataBenchmark {
+public:
+	MemoryReadStreamBenchmark() : DataBenchmark("stream/memory_read_uint32", 256 * 1024) {}
+
+	void run(uint iterations) override {
+		uint32 sum = 0;
+		for (uint n = 0; n < iterations; n++) {
+			Common::MemoryReadStream stream(_data, _size);
+			for (uint i = 0; i < _size / 4; i++)
+				sum += stream.readUint32LE();
+		}
+		doNotOptimize(sum);
+	}
+};
+
+class BufferedReadStreamBenchmark : public DataBenchmark {
+public:
+	BufferedReadStreamBenchmark() : DataBenchmark("stream/buffered_read_byte", 256 * 1024) {}
+
+	void run(uint iterations) override {
+		uint32 sum = 0;
+		for (uint n = 0; n < iterations; n++) {
+			Common::SeekableReadStream *stream = Common::wrapBufferedSeekableReadStream(
+				new Common::MemoryReadStream(_data, _size), 4096, DisposeAfterUse::YES);
+			for (uint i = 0; i < _size; i++)
+				sum += stream->readByte();
+			delete stream;
+		}
+		doNotOptimize(sum);
+	}
+};
+
+class InflateBenchmark : public DataBenchmark {
+public:
+	InflateBenchmark() : DataBenchmark("compression/inflate_gzip", 256 * 1024), _compressed(nullptr), _compressedSize(0) {}
+
+	void setUp() override {
+		DataBenchmark::setUp();
+
+		// The compressed stream owns the one it wraps
+		Common::MemoryWriteStreamDynamic *output = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::NO);
+		Common::WriteStream *gzip = Common::wrapCompressedWriteStream(output);
+		gzip->write(_data, _size);
+		gzip->finalize();
+
+		_compressed = output->getData();
+		_compressedSize = output->size();
+		delete gzip;
+	}
+
+	void run(uint iterations) override {
+		uint32 sum = 0;
+		for (uint n = 0; n < iterations; n++) {
+			Common::SeekableReadStream *stream = Common::wrapCompressedReadStream(
+				new Common::MemoryReadStream(_compressed, _compressedSize), DisposeAfterUse::YES, _size);
+			sum += stream->read(_data, _size);
+			delete stream;
+		}
+		doNotOptimize(sum);
+	}
+
+	void tearDown() override {
+		free(_compressed);
+		_compressed = nullptr;
+		DataBenchmark::tearDown();
+	}
+
+private:
+	byte *_compressed;
+	uint32 _compressedSize;
+};
+
+class MD5Benchmark : public DataBenchmark {
+public:
+	MD5Benchmark() : DataBenchmark("checksum/md5", 256 * 1024) {}
+
+	void run(uint iterations) override {
+		uint32 sum = 0;
+		for (uint n = 0; n < iterations; n++) {
+			Common::MemoryReadStream stream(_data, _size);
+			uint8 digest[16];
+			Common::computeStreamMD5(stream, digest);
+			sum += digest[0];
+		}
+		doNotOptimize(sum);
+	}
+};
+
+class CRC32Benchmark : public DataBenchmark {
+public:
+	CRC32Benchmark() : DataBenchmark("checksum/crc32", 256 * 1024) {}
+
+	void run(uint iterations) override {
+		uint32 sum = 0;
+		for (uint n = 0; n < iterations; n++)
+			sum += _crc.crcFast(_data, _size);
+		doNotOptimize(sum);
+	}
+
+private:
+	Common::CRC32 _crc;
+};
+
+} // End of anonymous namespace
+
+void addCommonBenchmarks(BenchmarkList &list) {
+	typedef Common::HashMap<Common::String, uint, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> StringMap;
+	typedef Common::FlatHashMap<Common::String, uint, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> FlatStringMap;
+
+	list.push_back(new StringLookupBenchmark<StringMap>("hashmap/string_lookup_4k", 4096));
+	list.push_back(new StringLookupBenchmark<FlatStringMap>("flathashmap/string_lookup_4k", 4096));
+	list.push_back(new IntChurnBenchmark<Common::HashMap<uint, uint> >("hashmap/int_churn_1k", 1024));
+	list.push_back(new IntChurnBenchmark<Common::FlatHashMap<uint, uint> >("flathashmap/int_churn_1k", 1024));
+	list.push_back(new ArrayPushBackBenchmark());
+	list.push_back(new SmallAllocBenchmark("alloc/malloc_256", false));
+	list.push_back(new SmallAllocBenchmark("alloc/frame_arena_256", true));
+	list.push_back(new StringBuildBenchmark());
+	list.push_back(new MemoryReadStreamBenchmark());
+	list.push_back(new BufferedReadStreamBenchmark());
+	list.push_back(new InflateBenchmark());
+	list.push_back(new MD5Benchmark());
+	list.push_back(new CRC32Benchmark());
+}
+
+} // End of namespace Bench
@@ -0,0 +1,206 @@
+#include "bench.h"
+#include "test/instrset_detect.h"
+
+#include "common/jobsystem.h"
+#include "graphics/blit.h"
+#include "graphics/pixelformat.h"
+
+#ifdef USE_SCALERS
+#include "graphics/scaler/normal.h"
+#endif
+#ifdef USE_HQ_SCALERS
+#include "graphics/scaler/hq.h"
+#endif
+
+#ifdef USE_PTHREADS
+#include "backends/jobs/pthread/pthread-jobsystem.h"
+#endif
+
+namespace Bench {
+
+namespace {
+
+void fillPattern(byte *data, uint size) {
+	for (uint i = 0; i < size; i++)
+		data[i] = (byte)((i * 7) ^ (i >> 9));
+}
+
+class CrossBlitBenchmark : public Benchmark {
+public:
+	CrossBlitBenchmark(const char *name, const Graphics::PixelFormat &dstFormat, const Graphics::PixelFormat &srcFormat)
+		: Benchmark(name, kWidth * kHeight * srcFormat.bytesPerPixel),
+		  _dstFormat(dstFormat), _srcFormat(srcFormat), _src(nullptr), _dst(nullptr) {}
+
+	void setUp() override {
+		_src = new byte[kWidth * kHeight * _srcFormat.bytesPerPixel];
+		_dst = new byte[kWidth * kHeight * _dstFormat.bytesPerPixel];
+		fillPattern(_src, kWidth * kHeight * _srcFormat.bytesPerPixel);
+	}
+
+	void run(uint iterations) override {
+		for (uint n = 0; n < iterations; n++) {
+			Graphics::crossBlit(_dst, _src, kWidth * _dstFormat.bytesPerPixel, kWidth * _srcFormat.bytesPerPixel,
+			                    kWidth, kHeight, _dstFormat, _srcFormat);
+		}
+		doNotOptimize(_dst[0]);
+	}
+
+	void tearDown() override {
+		delete[] _src;
+		delete[] _dst;
+	}
+
+private:
+	enum {
+		kWidth = 640,
+		kHeight = 480
+	};
+
+	Graphics::PixelFormat _dstFormat, _srcFormat;
+	byte *_src, *_dst;
+};
+
+#ifdef USE_SCALERS
+/**
+ * Scale a whole 320x200 screen with the given scaler and factor, optionally
+ * in bands on a pool of workers.
+ */
+template<class ScalerType>
+class ScalerBenchmark : public Benchmark {
+public:
+	ScalerBenchmark(const char *name, const Graphics::PixelFormat &format, uint factor, uint workers = 0)
+		: Benchmark(name, kWidth * kHeight * format.bytesPerPixel),
+		  _format(format), _factor(factor), _workers(workers), _jobSystem(nullptr), _scaler(nullptr), _src(nullptr), _dst(nullptr) {}
+
+	void setUp() override {
+#ifdef USE_PTHREADS
+		if (_workers)
+			_jobSystem = createPthreadJobSystem(_workers);
+#endif
+		_scaler = new ScalerType(_format);
+		_scaler->setFactor(_factor);
+
+		// Scalers read one pixel around the rect
+		_srcPitch = (kWidth + 2) * _format.bytesPerPixel;
+		_src = new byte[_srcPitch * (kHeight + 2)];
+		fillPattern(_src, _srcPitch * (kHeight + 2));
+
+		_dstPitch = kWidth * _factor * _format.bytesPerPixel;
+		_dst = new byte[_dstPitch * kHeight * _factor];
+	}
+
+	void run(uint iterations) override {
+		const byte *src = _src + _srcPitch + _format.bytesPerPixel;
+		for (uint n = 0; n < iterations; n++)
+			_scaler->scaleInBands(_jobSystem, 1, src, _srcPitch, _dst, _dstPitch, kWidth, kHeight, 0, 0);
+		doNotOptimize(_dst[0]);
+	}
+
+	void tearDown() override {
+		delete _jobSystem;
+		_jobSystem = nullptr;
+		delete _scaler;
+		delete[] _src;
+		delete[] _dst;
+	}
+
+private:
+	enum {
+		kWidth = 320,
+		kHeight = 200
+	};
+
+	Graphics::PixelFormat _format;
+	uint _factor;
+	uint _workers;
+	Common::JobSystem *_jobSystem;
+	Scaler *_scaler;
+	byte *_src, *_dst;
+	uint _srcPitch, _dstPitch;
+};
+#endif
+
+#ifdef USE_HQ_SCALERS
+/**
+ * Find the HQx patterns of a screen worth of YUV values, three rows at a time.
+ */
+class HQPatternsBenchmark : public Benchmark {
+public:
+	HQPatternsBenchmark(const char *name, HQScaler::FindPatternsFunc func)
+		: Benchmark(name, kWidth * kHeight * sizeof(uint32)), _func(func) {}
+
+	void setUp() override {
+		// Mostly small differences, so the thresholds matter
+		uint32 seed = 1;
+		for (uint i = 0; i < ARRAYSIZE(_yuv); i++) {
+			seed = seed * 1103515245 + 12345;
+			_yuv[i] = 0x804080 + ((seed >> 8) & 0x070307);
+		}
+	}
+
+	void run(uint iterations) override {
+		for (uint n = 0; n < iterations; n++) {
+			for (uint y = 0; y < kHeight; y++) {
+				const uint32 *above = _yuv + (y % 3) * (kWidth + 2);
+				const uint32 *center = _yuv + ((y + 1) % 3) * (kWidth + 2);
+				const uint32 *below = _yuv + ((y + 2) % 3) * (kWidth + 2);
+				_func(above, center, below, _patterns, kWidth);
+			}
+		}
+		doNotOptimize(_patterns[0]);
+	}
+
+private:
+	enum {
+		kWidth = 320,
+		kHeight = 200
+	};
+
+	HQScaler::FindPatternsFunc _func;
+	uint32 _yuv[(kWidth + 2) * 3];
+	uint8 _patterns[kWidth];
+};
+#endif
+
+} // End of anonymous namespace
+
+void addGraphicsBenchmarks(BenchmarkList &list) {
+	const Graphics::PixelFormat rgb565(2, 5, 6, 5, 0, 11, 5, 0, 0);
+	const Graphics::PixelFormat argb8888(4, 8, 8, 8, 8, 16, 8, 0, 24);
+	const Graphics::PixelFormat abgr8888(4, 8, 8, 8, 8, 0, 8, 16, 24);
+
+	list.push_back(new CrossBlitBenchmark("blit/cross_565_to_8888", argb8888, rgb565));
+	list.push_back(new CrossBlitBenchmark("blit/cross_8888_swap", abgr8888, argb8888));
+
+#ifdef USE_SCALERS
+	list.push_back(new ScalerBenchmark<NormalScaler>("scaler/normal2x_16", rgb565, 2));
+	list.push_back(new ScalerBenchmark<NormalScaler>("scaler/normal3x_32", argb8888, 3));
+#endif
+#ifdef USE_HQ_SCALERS
+	// The null backend knows nothing about the CPU, so pick the pattern finder here
+	HQScaler::findPatternsFunc = HQScaler::findPatternsGeneric;
+	list.push_back(new HQPatternsBenchmark("scaler/hq_patterns_generic", HQScaler::findPatternsGeneric));
+#ifdef SCUMMVM_NEON
+	HQScaler::findPatternsFunc = HQScaler::findPatternsNEON;
+	list.push_back(new HQPatternsBenchmark("scaler/hq_patterns_neon", HQScaler::findPatternsNEON));
+#endif
+#ifdef SCUMMVM_SSE2
+	if (instrset_detect() >= 2) {
+		HQScaler::findPatternsFunc = HQScaler::findPatternsSSE2;
+		list.push_back(new HQPatternsBenchmark("scaler/hq_patterns_sse2", HQScaler::findPatternsSSE2));
+	}
+#endif
+#ifdef SCUMMVM_AVX2
+	if (instrset_detect() >= 8) {
+		HQScaler::findPatternsFunc = HQScaler::findPatternsAVX2;
+		list.push_back(new HQPatternsBenchmark("scaler/hq_patterns_avx2", HQScaler::findPatternsAVX2));
+	}
+#endif
+
+	list.push_back(new ScalerBenchmark<HQScaler>("scaler/hq2x_16", rgb565, 2));
+	list.push_back(new ScalerBenchmark<HQScaler>("scaler/hq3x_32", argb8888, 3));
+	list.push_back(new ScalerBenchmark<HQScaler>("scaler/hq3x_32_bands", argb8888, 3, 3));
+#endif
+}
+
+} // End of namespace Bench
@@ -0,0 +1,244 @@
+// The runner prints its results and reads the clock directly
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "bench.h"
+#include "../null_osystem.h"
+
+#include "common/algorithm.h"
+#include "common/system.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+namespace Bench {
+
+static volatile uint32 g_sink;
+
+void doNotOptimize(uint32 value) {
+	g_sink += value;
+}
+
+namespace {
+
+uint64 getNanos() {
+#ifdef WIN32
+	LARGE_INTEGER counter, frequency;
+	QueryPerformanceCounter(&counter);
+	QueryPerformanceFrequency(&frequency);
+	return (uint64)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#endif
+}
+
+enum OutputFormat {
+	kFormatText,
+	kFormatCSV,
+	kFormatJSON
+};
+
+struct Options {
+	Options() : filter(nullptr), format(kFormatText), warmup(2), repetitions(15), minSampleMillis(10), list(false) {}
+
+	const char *filter;
+	OutputFormat format;
+	uint warmup;
+	uint repetitions;
+	uint minSampleMillis;
+	bool list;
+};
+
+struct Result {
+	uint iterations;
+	double median, p10, p90, min, max; ///< Nanoseconds per iteration
+};
+
+/** Return the nearest-rank percentile of sorted samples. */
+double percentile(const Common::Array<double> &sorted, uint percent) {
+	uint rank = (percent * sorted.size() + 99) / 100;
+	return sorted[rank ? rank - 1 : 0];
+}
+
+double timeRun(Benchmark *bench, uint iterations) {
+	uint64 start = getNanos();
+	bench->run(iterations);
+	return (double)(getNanos() - start);
+}
+
+Result measure(Benchmark *bench, const Options &options) {
+	Result result;
+	const double minSample = options.minSampleMillis * 1e6;
+
+	// Calibrate the number of iterations per sample, which also warms up
+	// the caches and the branch predictors
+	uint iterations = 1;
+	for (;;) {
+		double time = timeRun(bench, iterations);
+		if (time >= minSample || iterations >= (1U << 30))
+			break;
+
+		double factor = time > 0 ? minSample / time * 1.2 : 10.0;
+		iterations = (uint)MIN<double>(iterations * CLIP<double>(factor, 1.5, 10.0), 1U << 30);
+	}
+
+	for (uint i = 0; i < options.warmup; i++)
+		timeRun(bench, iterations);
+
+	Common::Array<double> samples;
+	for (uint i = 0; i < options.repetitions; i++)
+		samples.push_back(timeRun(bench, iterations) / iterations);
+	Common::sort(samples.begin(), samples.end());
+
+	result.iterations = iterations;
+	result.median = percentile(samples, 50);
+	result.p10 = percentile(samples, 10);
+	result.p90 = percentile(samples, 90);
+	result.min = samples.front();
+	result.max = samples.back();
+	return result;
+}
+
+/** Return the throughput in MiB/s at the given time per iteration, or 0. */
+double throughput(const Benchmark *bench, double nanos) {
+	if (!bench->getBytesPerIteration() || nanos <= 0)
+		return 0;
+	return bench->getBytesPerIteration() / (nanos / 1e9) / (1024.0 * 1024.0);
+}
+
+void printHeader(const Options &options) {
+	switch (options.format) {
+	case kFormatText:
+		printf("%-40s %12s %12s %12s %10s %10s\n", "benchmark", "median ns", "p10 ns", "p90 ns", "MiB/s", "iters");
+		break;
+	case kFormatCSV:
+		printf("name,iterations,repetitions,median_ns,p10_ns,p90_ns,min_ns,max_ns,bytes_per_iteration,median_mib_s\n");
+		break;
+	case kFormatJSON:
+		printf("[\n");
+		break;
+	}
+}
+
+void printResult(const Options &options, const Benchmark *bench, const Result &result, bool first) {
+	const double mibs = throughput(bench, result.median);
+
+	switch (options.format) {
+	case kFormatText:
+		printf("%-40s %12.1f %12.1f %12.1f %10.1f %10u\n", bench->getName().c_str(),
+		       result.median, result.p10, result.p90, mibs, result.iterations);
+		break;
+	case kFormatCSV:
+		printf("%s,%u,%u,%.2f,%.2f,%.2f,%.2f,%.2f,%llu,%.2f\n", bench->getName().c_str(),
+		       result.iterations, options.repetitions, result.median, result.p10, result.p90,
+		       result.min, result.max, (unsigned long long)bench->getBytesPerIteration(), mibs);
+		break;
+	case kFormatJSON:
+		printf("%s  {\"name\": \"%s\", \"iterations\": %u, \"repetitions\": %u, \"median_ns\": %.2f, "
+		       "\"p10_ns\": %.2f, \"p90_ns\": %.2f, \"min_ns\": %.2f, \"max_ns\": %.2f, "
+		       "\"bytes_per_iteration\": %llu, \"median_mib_s\": %.2f}",
+		       first ? "" : ",\n", bench->getName().c_str(), result.iterations, options.repetitions,
+		       result.median, result.p10, result.p90, result.min, result.max,
+		       (unsigned long long)bench->getBytesPerIteration(), mibs);
+		break;
+	}
+	fflush(stdout);
+}
+
+void printFooter(const Options &options) {
+	if (options.format == kFormatJSON)
+		printf("\n]\n");
+}
+
+void usage(const char *argv0) {
+	printf("Usage: %s [options] [filter]\n"
+	       "  filter              only run benchmarks whose name contains this string\n"
+	       "  --list              list the benchmarks instead of running them\n"
+	       "  --format=FORMAT     text (default), csv or json\n"
+	       "  --repetitions=N     number of timed samples (default 15)\n"
+	       "  --warmup=N          number of untimed samples (default 2)\n"
+	       "  --min-time=MS       minimal duration of one sample (default 10)\n", argv0);
+}
+
+bool parseOptions(int argc, char *argv[], Options &options) {
+	for (int i = 1; i < argc; i++) {
+		const char *arg = argv[i];
+
+		if (!strcmp(arg, "--list")) {
+			options.list = true;
+		} else if (!strcmp(arg, "--format=text")) {
+			options.format = kFormatText;
+		} else if (!strcmp(arg, "--format=csv")) {
+			options.format = kFormatCSV;
+		} else if (!strcmp(arg, "--format=json")) {
+			options.format = kFormatJSON;
+		} else if (!strncmp(arg, "--repetitions=", 14)) {
+			options.repetitions = MAX(atoi(arg + 14), 1);
+		} else if (!strncmp(arg, "--warmup=", 9)) {
+			options.warmup = MAX(atoi(arg + 9), 0);
+		} else if (!strncmp(arg, "--min-time=", 11)) {
+			options.minSampleMillis = MAX(atoi(arg + 11), 1);
+		} else if (arg[0] != '-' && !options.filter) {
+			options.filter = arg;
+		} else {
+			usage(argv[0]);
+			return false;
+		}
+	}
+	return true;
+}
+
+} // End of anonymous namespace
+
+} // End of namespace Bench
+
+int main(int argc, char *argv[]) {
+	Bench::Options options;
+	if (!Bench::parseOptions(argc, argv, options))
+		return 1;
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+	Common::install_null_g_system();
+#endif
+
+	Bench::BenchmarkList list;
+	Bench::addCommonBenchmarks(list);
+	Bench::addGraphicsBenchmarks(list);
+	Bench::addAudioBenchmarks(list);
+
+	if (!options.list)
+		Bench::printHeader(options);
+
+	bool first = true;
+	for (uint i = 0; i < list.size(); i++) {
+		Bench::Benchmark *bench = list[i];
+
+		if (!options.filter || strstr(bench->getName().c_str(), options.filter)) {
+			if (options.list) {
+				printf("%s\n", bench->getName().c_str());
+			} else {
+				bench->setUp();
+				Bench::Result result = Bench::measure(bench, options);
+				bench->tearDown();
+
+				Bench::printResult(options, bench, result, first);
+				first = false;
+			}
+		}
+
+		delete bench;
+	}
+
+	if (!options.list)
+		Bench::printFooter(options);
+
+	return 0;
+}
@@ -0,0 +1,193 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "common/memstream.h"
+#include "common/compression/deflate.h"
+
+namespace {
+
+/**
+ * Writes deflate blocks with the fixed Huffman codes, or stored blocks, in
+ * the Clickteam flavour: the block type comes before the last block flag,
+ * and stored blocks have no complemented length.
+ */
+class FixedDeflateWriter {
+public:
+	FixedDeflateWriter() : _bits(0), _count(0) {}
+
+	void beginFixedBlock(bool last) {
+		putBits(5, 3);
+		putBits(last ? 1 : 0, 1);
+	}
+
+	void literal(byte value) {
+		if (value < 144)
+			putCode(0x30 + value, 8);
+		else
+			putCode(0x190 + value - 144, 9);
+	}
+
+	void match(uint length, uint distance) {
+		static const uint16 lengthBase[] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+		static const byte lengthExtra[] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+		static const uint16 distBase[] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+
+		uint code = 28;
+		while (lengthBase[code] > length)
+			code--;
+		putSymbol(257 + code);
+		putBits(length - lengthBase[code], lengthExtra[code]);
+
+		code = 29;
+		while (distBase[code] > distance)
+			code--;
+		putCode(code, 5);
+		putBits(distance - distBase[code], code < 4 ? 0 : code / 2 - 1);
+	}
+
+	void endFixedBlock() {
+		putSymbol(256);
+	}
+
+	void storedBlock(const byte *data, uint size, bool last) {
+		putBits(7, 3);
+		putBits(last ? 1 : 0, 1);
+		flush();
+		putBits(size, 16);
+		for (uint i = 0; i < size; i++)
+			putBits(data[i], 8);
+	}
+
+	void flush() {
+		if (_count)
+			putBits(0, 8 - _count);
+	}
+
+	const Common::Array<byte> &data() const { return _data; }
+
+private:
+	void putSymbol(uint symbol) {
+		if (symbol < 280)
+			putCode(symbol - 256, 7);
+		else
+			putCode(0xC0 + symbol - 280, 8);
+	}
+
+	/** Huffman codes are sent starting with their most significant bit. */
+	void putCode(uint code, uint length) {
+		uint reversed = 0;
+		for (uint i = 0; i < length; i++)
+			reversed |= ((code >> i) & 1) << (length - 1 - i);
+		putBits(reversed, length);
+	}
+
+	void putBits(uint value, uint count) {
+		for (uint i = 0; i < count; i++) {
+			_bits |= ((value >> i) & 1) << _count;
+			if (++_count == 8) {
+				_data.push_back(_bits);
+				_bits = 0;
+				_count = 0;
+			}
+		}
+	}
+
+	Common::Array<byte> _data;
+	byte _bits;
+	uint _count;
+};
+
+/** Encode a fixed block of random literals and matches, appending the expected output. */
+void writeFixedBlock(FixedDeflateWriter &writer, Common::Array<byte> &expected, uint size, uint32 &seed, bool last) {
+	writer.beginFixedBlock(last);
+	const uint end = expected.size() + size;
+
+	while (expected.size() < end) {
+		seed = seed * 1103515245 + 12345;
+		const uint choice = (seed >> 16) % 8;
+
+		if (choice < 3 || expected.size() < 3) {
+			const byte value = (byte)(seed >> 8);
+			writer.literal(value);
+			expected.push_back(value);
+			continue;
+		}
+
+		// Mostly short matches, some overlapping or reaching far back
+		uint distance = choice == 3 ? 1 + (seed >> 4) % 4 : 1 + (seed >> 4) % (choice == 7 ? 32768 : 300);
+		uint length = choice == 4 ? 258 : 3 + (seed >> 2) % 40;
+		distance = MIN<uint>(distance, expected.size());
+
+		writer.match(length, distance);
+		for (uint i = 0; i < length; i++) {
+			const byte value = expected[expected.size() - distance];
+			expected.push_back(value);
+		}
+	}
+
+	writer.endFixedBlock();
+}
+
+} // End of anonymous namespace
+
+class DeflateTestSuite : public CxxTest::TestSuite {
+public:
+	void test_fixed_and_stored_blocks() {
+		FixedDeflateWriter writer;
+		Common::Array<byte> expected;
+		uint32 seed = 1;
+
+		writeFixedBlock(writer, expected, 100000, seed, false);
+
+		// Longer than the window, and starting with bytes already in the bit buffer
+		byte stored[40000];
+		for (uint i = 0; i < sizeof(stored); i++)
+			stored[i] = (byte)(i * 7 + i / 256);
+		writer.storedBlock(stored, sizeof(stored), false);
+		for (uint i = 0; i < sizeof(stored); i++)
+			expected.push_back(stored[i]);
+
+		writeFixedBlock(writer, expected, 100000, seed, true);
+		writer.flush();
+
+		Common::Array<byte> output;
+		output.resize(expected.size());
+		uint outputSize = output.size();
+		TS_ASSERT(Common::inflateClickteam(output.begin(), &outputSize, writer.data().begin(), writer.data().size()));
+		TS_ASSERT_EQUALS(outputSize, expected.size());
+		TS_ASSERT(output == expected);
+	}
+
+	void test_stream_reads_and_seeks() {
+		FixedDeflateWriter writer;
+		Common::Array<byte> expected;
+		uint32 seed = 7;
+
+		writeFixedBlock(writer, expected, 150000, seed, true);
+		writer.flush();
+
+		Common::SeekableReadStream *stream = Common::wrapClickteamReadStream(
+			new Common::MemoryReadStream(writer.data().begin(), writer.data().size()), DisposeAfterUse::YES, expected.size());
+		TS_ASSERT(stream);
+
+		// Odd chunk sizes, so reads end in the middle of matches
+		byte buffer[1237];
+		uint pos = 0;
+		while (pos < expected.size()) {
+			const uint32 size = stream->read(buffer, MIN<uint>(sizeof(buffer), expected.size() - pos));
+			TS_ASSERT(size > 0);
+			if (!size)
+				break;
+			TS_ASSERT_SAME_DATA(buffer, expected.begin() + pos, size);
+			pos += size;
+		}
+		TS_ASSERT(!stream->err());
+
+		// Seeking back restarts decompression from the beginning
+		TS_ASSERT(stream->seek(12345));
+		TS_ASSERT_EQUALS(stream->read(buffer, sizeof(buffer)), sizeof(buffer));
+		TS_ASSERT_SAME_DATA(buffer, expected.begin() + 12345, sizeof(buffer));
+
+		delete stream;
+	}
+};
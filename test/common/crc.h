@@ -21,6 +21,34 @@ public:
 		TS_ASSERT_EQUALS(crc.finalize(running), 0x414fa339U);
 	}
 
+	void test_crc32_slices() {
+		Common::CRC32 crc;
+		byte data[64];
+		uint32 seed = 1;
+		for (int i = 0; i < 64; i++) {
+			seed = seed * 1103515245 + 12345;
+			data[i] = seed >> 24;
+		}
+
+		// All lengths and alignments, compared to the byte-wise table
+		for (int offset = 0; offset < 8; offset++) {
+			for (int len = 0; len <= 40; len++) {
+				uint32 expected = crc.getInitRemainder();
+				for (int i = 0; i < len; i++)
+					expected = crc.processByte(data[offset + i], expected);
+				TS_ASSERT_EQUALS(crc.crcFast(data + offset, len), crc.finalize(expected));
+			}
+		}
+
+		// The tables are shared, so check them against the bitwise version
+		Common::CRC32_Slow slow;
+		TS_ASSERT_EQUALS(Common::CRC32().crcFast(data, 64), slow.crcSlow(data, 64));
+
+		uint32 running = crc.update(crc.getInitRemainder(), testStringCRC, 13);
+		running = crc.update(running, testStringCRC + 13, testLenCRC - 13);
+		TS_ASSERT_EQUALS(crc.finalize(running), 0x414fa339U);
+	}
+
 	void test_crc16() {
 		Common::CRC16 crc;
 		TS_ASSERT_EQUALS(crc.crcFast(testStringCRC, testLenCRC), 0xfcdfU);
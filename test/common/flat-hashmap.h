@@ -0,0 +1,235 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/flat-hashmap.h"
+#include "common/hash-str.h"
+#include "common/array.h"
+#include "common/debug.h"
+#include "common/system.h"
+
+#include "../null_osystem.h"
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+#define BENCHMARK_TIME 1
+#else
+#define BENCHMARK_TIME 0
+#endif
+
+namespace {
+
+#if BENCHMARK_TIME
+/** Time insert/lookup/iterate/erase of count keys on one map type, in milliseconds. */
+template<class Map, class Key>
+void benchmarkMap(const char *name, const Common::Array<Key> &keys, const Common::Array<Key> &missing, int rounds) {
+	uint32 insertTime = 0, hitTime = 0, missTime = 0, iterateTime = 0, eraseTime = 0;
+	uint checksum = 0;
+
+	for (int round = 0; round < rounds; round++) {
+		Map map;
+
+		uint32 start = g_system->getMillis();
+		for (uint i = 0; i < keys.size(); i++)
+			map[keys[i]] = i;
+		insertTime += g_system->getMillis() - start;
+
+		start = g_system->getMillis();
+		for (int pass = 0; pass < 4; pass++) {
+			for (uint i = 0; i < keys.size(); i++)
+				checksum += map.getValOrDefault(keys[i]);
+		}
+		hitTime += g_system->getMillis() - start;
+
+		start = g_system->getMillis();
+		for (int pass = 0; pass < 4; pass++) {
+			for (uint i = 0; i < missing.size(); i++)
+				checksum += map.contains(missing[i]);
+		}
+		missTime += g_system->getMillis() - start;
+
+		start = g_system->getMillis();
+		for (int pass = 0; pass < 4; pass++) {
+			for (typename Map::const_iterator i = map.begin(); i != map.end(); ++i)
+				checksum += i->_value;
+		}
+		iterateTime += g_system->getMillis() - start;
+
+		start = g_system->getMillis();
+		for (uint i = 0; i < keys.size(); i++)
+			map.erase(keys[i]);
+		eraseTime += g_system->getMillis() - start;
+	}
+
+	debug("%-32s insert %4u  hit %4u  miss %4u  iterate %4u  erase %4u ms (%u)",
+		name, insertTime, hitTime, missTime, iterateTime, eraseTime, checksum & 1);
+}
+#endif
+
+} // End of anonymous namespace
+
+class FlatHashMapTestSuite : public CxxTest::TestSuite
+{
+	public:
+	void test_empty_clear() {
+		Common::FlatHashMap<int, int> container;
+		TS_ASSERT(container.empty());
+		container[0] = 17;
+		container[1] = 33;
+		TS_ASSERT(!container.empty());
+		container.clear();
+		TS_ASSERT(container.empty());
+		TS_ASSERT(!container.contains(0));
+
+		Common::FlatHashMap<Common::String, Common::String, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> container2;
+		container2["foo"] = "bar";
+		container2["quux"] = "blub";
+		TS_ASSERT(container2.contains("FOO"));
+		container2.clear(true);
+		TS_ASSERT(container2.empty());
+		TS_ASSERT(!container2.contains("foo"));
+	}
+
+	void test_add_remove_lookup() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = 33;
+		container[2] = 45;
+		TS_ASSERT_EQUALS(container.size(), 3u);
+		TS_ASSERT_EQUALS(container[1], 33);
+		TS_ASSERT(!container.contains(17));
+
+		container.erase(1);
+		TS_ASSERT(!container.contains(1));
+		TS_ASSERT_EQUALS(container.size(), 2u);
+		container.erase(1);
+		TS_ASSERT_EQUALS(container.size(), 2u);
+
+		container.setVal(1, 42);
+		TS_ASSERT_EQUALS(container.getVal(1), 42);
+		TS_ASSERT_EQUALS(container.getValOrDefault(5), 0);
+		TS_ASSERT_EQUALS(container.getValOrDefault(5, -1), -1);
+
+		int out = 0;
+		TS_ASSERT(container.tryGetVal(2, out));
+		TS_ASSERT_EQUALS(out, 45);
+		TS_ASSERT(!container.tryGetVal(3, out));
+
+		TS_ASSERT(container.find(3) == container.end());
+		TS_ASSERT_EQUALS(container.find(0)->_value, 17);
+	}
+
+	void test_iterator_and_erase_while_iterating() {
+		Common::FlatHashMap<int, int> container;
+		for (int i = 0; i < 1000; i++)
+			container[i] = i * 2;
+
+		int sum = 0, count = 0;
+		for (Common::FlatHashMap<int, int>::const_iterator i = container.begin(); i != container.end(); ++i) {
+			TS_ASSERT_EQUALS(i->_value, i->_key * 2);
+			sum += i->_key;
+			count++;
+		}
+		TS_ASSERT_EQUALS(count, 1000);
+		TS_ASSERT_EQUALS(sum, 999 * 1000 / 2);
+
+		for (Common::FlatHashMap<int, int>::iterator i = container.begin(); i != container.end(); ++i) {
+			if (i->_key & 1)
+				container.erase(i);
+		}
+		TS_ASSERT_EQUALS(container.size(), 500u);
+		for (int i = 0; i < 1000; i++)
+			TS_ASSERT_EQUALS(container.contains(i), (i & 1) == 0);
+
+		Common::FlatHashMap<int, int> empty;
+		TS_ASSERT(empty.begin() == empty.end());
+	}
+
+	void test_copy() {
+		Common::FlatHashMap<Common::String, int> map1;
+		for (int i = 0; i < 100; i++)
+			map1[Common::String::format("key%d", i)] = i;
+		map1.erase("key5");
+
+		Common::FlatHashMap<Common::String, int> map2(map1);
+		Common::FlatHashMap<Common::String, int> map3;
+		map3["other"] = 1;
+		map3 = map1;
+
+		map1["key6"] = 600;
+		TS_ASSERT_EQUALS(map2.size(), 99u);
+		TS_ASSERT_EQUALS(map3.size(), 99u);
+		TS_ASSERT_EQUALS(map2["key6"], 6);
+		TS_ASSERT(!map3.contains("key5"));
+		TS_ASSERT(!map3.contains("other"));
+	}
+
+	void test_rehash_moves_entries() {
+		// Long strings own heap buffers, which moving must hand over
+		Common::FlatHashMap<Common::String, Common::String> map;
+		for (int i = 0; i < 1000; i++)
+			map[Common::String::format("a long key which is not stored inline %d", i)] = Common::String::format("a long value which is not stored inline %d", i);
+		map.reserve(10000);
+
+		TS_ASSERT_EQUALS(map.size(), 1000u);
+		uint count = 0;
+		for (Common::FlatHashMap<Common::String, Common::String>::const_iterator i = map.begin(); i != map.end(); ++i, ++count) {
+			TS_ASSERT(i->_key.hasPrefix("a long key"));
+			TS_ASSERT_EQUALS(i->_value, "a long value" + i->_key.substr(10));
+		}
+		TS_ASSERT_EQUALS(count, 1000u);
+	}
+
+	void test_matches_hashmap_under_churn() {
+		// Mixed inserts and erases exercise erased slot reuse and rehashing
+		// in place, which the other tests do not reach
+		Common::FlatHashMap<uint, uint> flat;
+		Common::HashMap<uint, uint> reference;
+		uint32 seed = 12345;
+
+		for (int i = 0; i < 20000; i++) {
+			seed = seed * 1103515245 + 12345;
+			uint key = ((seed >> 16) & 511) * 64;
+			if (seed & 0x80000000) {
+				flat[key] = i;
+				reference[key] = i;
+			} else {
+				flat.erase(key);
+				reference.erase(key);
+			}
+		}
+
+		TS_ASSERT_EQUALS(flat.size(), reference.size());
+		for (Common::HashMap<uint, uint>::const_iterator i = reference.begin(); i != reference.end(); ++i)
+			TS_ASSERT_EQUALS(flat.getValOrDefault(i->_key, (uint)-1), i->_value);
+
+		flat.reserve(5000);
+		TS_ASSERT_EQUALS(flat.size(), reference.size());
+		for (Common::FlatHashMap<uint, uint>::const_iterator i = flat.begin(); i != flat.end(); ++i)
+			TS_ASSERT_EQUALS(reference.getValOrDefault(i->_key, (uint)-1), i->_value);
+	}
+
+	void test_benchmark() {
+#if BENCHMARK_TIME
+		Common::install_null_g_system();
+
+		const uint count = 50000;
+		const int rounds = 3;
+
+		Common::Array<uint> intKeys, intMissing;
+		Common::Array<Common::String> strKeys, strMissing, longKeys, longMissing;
+		for (uint i = 0; i < count; i++) {
+			intKeys.push_back(i * 2654435761U);
+			intMissing.push_back(i * 2654435761U + 1);
+			strKeys.push_back(Common::String::format("res%05u.dat", i));
+			strMissing.push_back(Common::String::format("RES%05u.bin", i));
+			longKeys.push_back(Common::String::format("engines/some/long/resource/path/%08u/file.dat", i));
+			longMissing.push_back(Common::String::format("engines/some/long/resource/path/%08u/file.bin", i));
+		}
+
+		benchmarkMap<Common::HashMap<uint, uint> >("HashMap<uint>", intKeys, intMissing, rounds);
+		benchmarkMap<Common::FlatHashMap<uint, uint> >("FlatHashMap<uint>", intKeys, intMissing, rounds);
+		benchmarkMap<Common::HashMap<Common::String, uint> >("HashMap<String>", strKeys, strMissing, rounds);
+		benchmarkMap<Common::FlatHashMap<Common::String, uint> >("FlatHashMap<String>", strKeys, strMissing, rounds);
+		benchmarkMap<Common::HashMap<Common::String, uint, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> >("HashMap<String, IgnoreCase>", longKeys, longMissing, rounds);
+		benchmarkMap<Common::FlatHashMap<Common::String, uint, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> >("FlatHashMap<String, IgnoreCase>", longKeys, longMissing, rounds);
+#endif
+	}
+};
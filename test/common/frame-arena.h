@@ -0,0 +1,108 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/frame-arena.h"
+#include "common/str.h"
+
+namespace {
+
+struct ArenaObject {
+	ArenaObject(int value_) : value(value_) {}
+	int value;
+	double padding;
+};
+
+} // End of anonymous namespace
+
+class FrameArenaTestSuite : public CxxTest::TestSuite {
+public:
+	void test_allocate_and_reset() {
+		Common::FrameArena arena(256);
+		TS_ASSERT_EQUALS(arena.getCapacity(), 0u);
+
+		byte *first = (byte *)arena.allocate(10);
+		byte *second = (byte *)arena.allocate(10);
+		TS_ASSERT_EQUALS((uintptr)first % Common::FrameArena::kDefaultAlignment, 0u);
+		TS_ASSERT_EQUALS((uintptr)second % Common::FrameArena::kDefaultAlignment, 0u);
+		TS_ASSERT_LESS_THAN_EQUALS(first + 10, second);
+		TS_ASSERT_EQUALS(arena.getCapacity(), 256u);
+
+		// Allocations spill over into new blocks, and large ones get their own
+		for (int i = 0; i < 40; i++)
+			memset(arena.allocate(24, 8), i, 24);
+		byte *large = (byte *)arena.allocate(1000, 64);
+		TS_ASSERT_EQUALS((uintptr)large % 64, 0u);
+		memset(large, 0xFF, 1000);
+		TS_ASSERT_LESS_THAN(256u * 4, arena.getCapacity());
+
+		const size_t used = arena.getBytesUsed();
+		const size_t capacity = arena.getCapacity();
+		TS_ASSERT_LESS_THAN_EQUALS(20u + 40 * 24 + 1000, used);
+
+		// After a reset, the same blocks are handed out again
+		arena.reset();
+		TS_ASSERT_EQUALS(arena.getBytesUsed(), 0u);
+		TS_ASSERT_EQUALS(arena.getPeakBytesUsed(), used);
+		TS_ASSERT_EQUALS(arena.allocate(10), (void *)first);
+		TS_ASSERT_EQUALS(arena.allocate(10), (void *)second);
+		for (int i = 0; i < 40; i++)
+			arena.allocate(24, 8);
+		arena.allocate(1000, 64);
+		TS_ASSERT_EQUALS(arena.getCapacity(), capacity);
+
+		arena.reset();
+		arena.freeUnusedBlocks();
+		TS_ASSERT_EQUALS(arena.getCapacity(), 0u);
+		TS_ASSERT(arena.allocate(10));
+	}
+
+	void test_marks() {
+		Common::FrameArena arena(128);
+		char *kept = arena.copyString("kept");
+		Common::FrameArena::Mark mark = arena.getMark();
+
+		{
+			Common::FrameArenaScope scope(arena);
+			for (int i = 0; i < 20; i++)
+				arena.copyString("temporary string");
+			TS_ASSERT_LESS_THAN(128u, arena.getBytesUsed());
+		}
+		TS_ASSERT_EQUALS(arena.getBytesUsed(), mark.offset);
+		TS_ASSERT_EQUALS(Common::String(kept), "kept");
+
+		char *next = arena.copyString("next");
+		TS_ASSERT_EQUALS(next, kept + 5);
+	}
+
+	void test_placement_new() {
+		Common::FrameArena arena;
+		ArenaObject *object = new (arena) ArenaObject(42);
+		TS_ASSERT_EQUALS(object->value, 42);
+		TS_ASSERT_EQUALS((uintptr)object % alignof(ArenaObject), 0u);
+
+		int *values = arena.allocateArray<int>(100);
+		for (int i = 0; i < 100; i++)
+			values[i] = i;
+		TS_ASSERT_EQUALS(object->value, 42);
+	}
+
+	void test_poisoning() {
+		Common::FrameArena arena(64);
+		arena.setPoisoning(true);
+
+		byte *data = (byte *)arena.allocate(16);
+		TS_ASSERT_EQUALS(data[0], 0xCD);
+		TS_ASSERT_EQUALS(data[15], 0xCD);
+		memset(data, 0, 16);
+
+		Common::FrameArena::Mark mark = arena.getMark();
+		byte *spill = (byte *)arena.allocate(60);
+		memset(spill, 0, 60);
+		arena.rewind(mark);
+		TS_ASSERT_EQUALS(spill[0], 0xDD);
+		TS_ASSERT_EQUALS(spill[59], 0xDD);
+		TS_ASSERT_EQUALS(data[0], 0);
+
+		arena.reset();
+		TS_ASSERT_EQUALS(data[0], 0xDD);
+	}
+};
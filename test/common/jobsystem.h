@@ -0,0 +1,191 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "common/jobsystem.h"
+
+#ifdef USE_PTHREADS
+#include "backends/jobs/pthread/pthread-jobsystem.h"
+#endif
+
+namespace {
+
+struct JobOrder {
+	int order[8];
+	int count;
+};
+
+void recordJob(void *param) {
+	JobOrder *jobOrder = (JobOrder *)param;
+	jobOrder->order[jobOrder->count] = jobOrder->count;
+	jobOrder->count++;
+}
+
+void markRange(void *param, uint begin, uint end) {
+	int *marks = (int *)param;
+	for (uint i = begin; i < end; i++)
+		marks[i]++;
+}
+
+int answer(void *param) {
+	return *(int *)param * 2;
+}
+
+struct NestedJob {
+	Common::JobSystem *system;
+	int marks[64];
+};
+
+void runNested(void *param) {
+	NestedJob *nested = (NestedJob *)param;
+	nested->system->parallelFor(0, 64, 1, &markRange, nested->marks);
+}
+
+class CountingProfiler : public Common::JobProfiler {
+public:
+	CountingProfiler() : started(0), finished(0), lastName(nullptr) {}
+
+	void jobStarted(const char *name, uint worker) override {
+		started++;
+		lastName = name;
+	}
+
+	void jobFinished(const char *name, uint worker) override {
+		finished++;
+	}
+
+	int started;
+	int finished;
+	const char *lastName;
+};
+
+} // End of anonymous namespace
+
+class JobSystemTestSuite : public CxxTest::TestSuite {
+public:
+	void test_inline_jobs_run_in_order() {
+		Common::JobSystem system;
+		JobOrder jobOrder;
+		jobOrder.count = 0;
+
+		TS_ASSERT_EQUALS(system.getWorkerCount(), 0u);
+
+		Common::JobGroup group(&system);
+		for (int i = 0; i < 8; i++) {
+			group.run(&recordJob, &jobOrder);
+			// Inline jobs are done as soon as they are queued
+			TS_ASSERT_EQUALS(jobOrder.count, i + 1);
+			TS_ASSERT(group.isDone());
+		}
+		group.wait();
+
+		for (int i = 0; i < 8; i++)
+			TS_ASSERT_EQUALS(jobOrder.order[i], i);
+	}
+
+	void test_inline_parallel_for_is_one_call() {
+		Common::JobSystem system;
+		Common::Array<uint> calls;
+
+		system.parallelFor(3, 1000, 10, [&calls](uint begin, uint end) {
+			calls.push_back(begin);
+			calls.push_back(end);
+		});
+
+		TS_ASSERT_EQUALS(calls.size(), 2u);
+		TS_ASSERT_EQUALS(calls[0], 3u);
+		TS_ASSERT_EQUALS(calls[1], 1000u);
+
+		calls.clear();
+		system.parallelFor(5, 5, 1, [&calls](uint begin, uint end) {
+			calls.push_back(begin);
+		});
+		TS_ASSERT(calls.empty());
+	}
+
+	void test_inline_future() {
+		Common::JobSystem system;
+		int value = 21;
+
+		Common::Future<int> future(&answer, &value, "answer", &system);
+		TS_ASSERT(future.isReady());
+		TS_ASSERT_EQUALS(future.get(), 42);
+	}
+
+	void test_profiler_hooks() {
+		Common::JobSystem system;
+		CountingProfiler profiler;
+		JobOrder jobOrder;
+		jobOrder.count = 0;
+
+		system.setProfiler(&profiler);
+		{
+			Common::JobGroup group(&system);
+			group.run(&recordJob, &jobOrder, "first");
+			group.run(&recordJob, &jobOrder, "second");
+		}
+		TS_ASSERT_EQUALS(profiler.started, 2);
+		TS_ASSERT_EQUALS(profiler.finished, 2);
+		TS_ASSERT_EQUALS(Common::String(profiler.lastName), "second");
+
+		int marks[16] = {};
+		system.parallelFor(0, 16, 1, &markRange, marks, "range");
+		TS_ASSERT_EQUALS(profiler.started, 3);
+		TS_ASSERT_EQUALS(profiler.finished, 3);
+
+		system.setProfiler(nullptr);
+		system.parallelFor(0, 16, 1, &markRange, marks);
+		TS_ASSERT_EQUALS(profiler.started, 3);
+	}
+
+#ifdef USE_PTHREADS
+	void test_threaded_parallel_for_covers_range_once() {
+		Common::JobSystem *system = createPthreadJobSystem(3);
+		TS_ASSERT_EQUALS(system->getWorkerCount(), 3u);
+
+		const uint count = 100003;
+		Common::Array<int> marks;
+		marks.resize(count);
+
+		for (int pass = 0; pass < 20; pass++) {
+			for (uint i = 0; i < count; i++)
+				marks[i] = 0;
+
+			system->parallelFor(7, count, 100, &markRange, marks.begin());
+
+			for (uint i = 0; i < count; i++)
+				TS_ASSERT_EQUALS(marks[i], i < 7 ? 0 : 1);
+		}
+
+		delete system;
+	}
+
+	void test_threaded_groups_and_futures() {
+		Common::JobSystem *system = createPthreadJobSystem(2);
+
+		NestedJob nested[8];
+		{
+			Common::JobGroup group(system);
+			for (int i = 0; i < 8; i++) {
+				nested[i].system = system;
+				for (int j = 0; j < 64; j++)
+					nested[i].marks[j] = 0;
+				group.run(&runNested, &nested[i]);
+			}
+			group.wait();
+			TS_ASSERT(group.isDone());
+		}
+
+		for (int i = 0; i < 8; i++)
+			for (int j = 0; j < 64; j++)
+				TS_ASSERT_EQUALS(nested[i].marks[j], 1);
+
+		int value = 50;
+		{
+			Common::Future<int> future(&answer, &value, nullptr, system);
+			TS_ASSERT_EQUALS(future.get(), 100);
+		}
+
+		delete system;
+	}
+#endif
+};
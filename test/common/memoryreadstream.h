@@ -1,6 +1,8 @@
 #include <cxxtest/TestSuite.h>
 
+#include "common/file.h"
 #include "common/memstream.h"
+#include "common/substream.h"
 
 class MemoryReadStreamTestSuite : public CxxTest::TestSuite {
 	public:
@@ -104,4 +106,77 @@ class MemoryReadStreamTestSuite : public CxxTest::TestSuite {
 		ms.seek(0, SEEK_SET);
 		TS_ASSERT(!ms.eos());
 	}
+
+	void test_read_stream_copies_unshared_buffers() {
+		byte contents[] = { 1, 2, 3, 4, 5, 6, 7 };
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+		TS_ASSERT(!ms.supportsZeroCopy());
+
+		ms.seek(2);
+		Common::MemoryReadStream *part = dynamic_cast<Common::MemoryReadStream *>(ms.readStream(3));
+		TS_ASSERT(part);
+		TS_ASSERT_EQUALS(part->size(), 3);
+		TS_ASSERT_EQUALS(part->readByte(), 3);
+		TS_ASSERT(!part->getSharedData());
+		TS_ASSERT_EQUALS(ms.pos(), 5);
+		delete part;
+	}
+
+	void test_read_stream_views_shared_buffers() {
+		byte *contents = new byte[16];
+		for (int i = 0; i < 16; i++)
+			contents[i] = i;
+		Common::SharedPtr<byte> data(contents, Common::ArrayDeleter<byte>());
+
+		Common::MemoryReadStream *ms = new Common::MemoryReadStream(data, 16);
+		TS_ASSERT(ms->supportsZeroCopy());
+		ms->seek(4);
+
+		Common::MemoryReadStream *view = dynamic_cast<Common::MemoryReadStream *>(ms->readStream(8));
+		TS_ASSERT(view);
+		TS_ASSERT_EQUALS(ms->pos(), 12);
+		TS_ASSERT_EQUALS(view->getSharedData().get(), contents + 4);
+
+		// Views work like any other stream, and outlive their parent
+		delete ms;
+		data.reset();
+
+		TS_ASSERT_EQUALS(view->size(), 8);
+		view->seek(2);
+		TS_ASSERT_EQUALS(view->readByte(), 6);
+		view->seek(0, SEEK_END);
+		TS_ASSERT_EQUALS(view->pos(), 8);
+
+		// Sub streams of views hand out views as well
+		Common::SeekableSubReadStream sub(view, 1, 7, DisposeAfterUse::YES);
+		TS_ASSERT(sub.supportsZeroCopy());
+		sub.seek(1);
+		Common::MemoryReadStream *subView = dynamic_cast<Common::MemoryReadStream *>(sub.readStream(100));
+		TS_ASSERT(subView);
+		TS_ASSERT_EQUALS(subView->size(), 5);
+		TS_ASSERT_EQUALS(subView->getSharedData().get(), contents + 6);
+		TS_ASSERT(sub.eos());
+		delete subView;
+	}
+
+	void test_file_forwards_views() {
+		byte *contents = new byte[16];
+		for (int i = 0; i < 16; i++)
+			contents[i] = i;
+		Common::SharedPtr<byte> data(contents, Common::ArrayDeleter<byte>());
+
+		Common::File file;
+		TS_ASSERT(file.open(new Common::MemoryReadStream(data, 16), "shared"));
+		TS_ASSERT(file.supportsZeroCopy());
+		file.seek(3);
+
+		Common::MemoryReadStream *view = dynamic_cast<Common::MemoryReadStream *>(file.readStream(4));
+		TS_ASSERT(view);
+		TS_ASSERT_EQUALS(view->getSharedData().get(), contents + 3);
+		TS_ASSERT_EQUALS(file.pos(), 7);
+		delete view;
+
+		file.close();
+		TS_ASSERT(!file.supportsZeroCopy());
+	}
 };
@@ -0,0 +1,98 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/profiler.h"
+#include "common/str.h"
+
+#include "../null_osystem.h"
+
+namespace {
+
+#if defined(ENABLE_PROFILER) && NULL_OSYSTEM_IS_AVAILABLE
+const Common::ProfileZoneStats *findZone(const Common::Array<Common::ProfileZoneStats> &stats, const char *name) {
+	for (uint i = 0; i < stats.size(); i++) {
+		if (!strcmp(stats[i].name, name))
+			return &stats[i];
+	}
+	return nullptr;
+}
+#endif
+
+} // End of anonymous namespace
+
+class ProfilerTestSuite : public CxxTest::TestSuite {
+public:
+	void test_zones_and_frames() {
+#if defined(ENABLE_PROFILER) && NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+		Common::Profiler &profiler = Common::Profiler::instance();
+		PROFILE_THREAD("Test");
+		PROFILE_FRAME();
+
+		for (int frame = 0; frame < 3; frame++) {
+			{
+				PROFILE_ZONE("outer");
+				{
+					PROFILE_ZONE("inner");
+				}
+				{
+					PROFILE_ZONE("inner");
+				}
+			}
+			PROFILE_FRAME();
+		}
+
+		Common::Array<float> frameTimes;
+		profiler.getFrameTimes(frameTimes);
+		TS_ASSERT_EQUALS(frameTimes.size(), 3u);
+
+		Common::Array<Common::ProfileZoneStats> stats;
+		profiler.getZoneStats(stats);
+		TS_ASSERT_EQUALS(stats.size(), 2u);
+		const Common::ProfileZoneStats *outer = findZone(stats, "outer");
+		const Common::ProfileZoneStats *inner = findZone(stats, "inner");
+		TS_ASSERT(outer && inner);
+		if (outer && inner) {
+			TS_ASSERT_EQUALS(outer->calls, 1u);
+			TS_ASSERT_EQUALS(inner->calls, 2u);
+			TS_ASSERT_LESS_THAN_EQUALS(inner->last, outer->last);
+		}
+
+		// Nothing is recorded while paused
+		profiler.setPaused(true);
+		{
+			PROFILE_ZONE("paused");
+		}
+		PROFILE_FRAME();
+		profiler.setPaused(false);
+
+		profiler.getFrameTimes(frameTimes);
+		TS_ASSERT_EQUALS(frameTimes.size(), 3u);
+		profiler.getZoneStats(stats);
+		TS_ASSERT(!findZone(stats, "paused"));
+
+		Common::MemoryWriteStreamDynamic trace(DisposeAfterUse::YES);
+		TS_ASSERT(profiler.exportChromeTrace(trace));
+		Common::String json((const char *)trace.getData(), trace.size());
+		TS_ASSERT(json.hasPrefix("{\"traceEvents\":["));
+		TS_ASSERT(json.contains("\"args\":{\"name\":\"Test\"}"));
+		TS_ASSERT(json.contains("{\"name\":\"inner\",\"ph\":\"X\""));
+		TS_ASSERT(!json.contains("\"paused\""));
+		TS_ASSERT(json.hasSuffix("]}\n"));
+
+		profiler.reset();
+		profiler.getZoneStats(stats);
+		TS_ASSERT(stats.empty());
+
+		Common::Profiler::destroy();
+#endif
+	}
+
+	void test_disabled_macros() {
+		// The macros must be usable as statements in any configuration
+		if (true)
+			PROFILE_ZONE("statement");
+		PROFILE_FRAME();
+		PROFILE_THREAD("Test");
+	}
+};
@@ -0,0 +1,182 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "common/jobsystem.h"
+#include "common/memstream.h"
+#include "common/compression/deflate.h"
+
+#include "backends/saves/default/async-save-writer.h"
+
+#ifdef USE_PTHREADS
+#include "backends/jobs/pthread/pthread-jobsystem.h"
+#endif
+
+namespace {
+
+/** A save file on the disk; its contents are recorded once it is complete. */
+class RecordingWriteStream : public Common::MemoryWriteStreamDynamic {
+public:
+	RecordingWriteStream(Common::Array<byte> &contents, bool fail = false, Common::Array<const Common::Array<byte> *> *completed = nullptr)
+		: Common::MemoryWriteStreamDynamic(DisposeAfterUse::YES), _contents(contents), _fail(fail), _completed(completed) {}
+
+	bool err() const override { return _fail; }
+
+	void finalize() override {
+		if (_fail)
+			return;
+		_contents.resize(size());
+		if (size())
+			memcpy(&_contents[0], getData(), size());
+		if (_completed)
+			_completed->push_back(&_contents);
+	}
+
+private:
+	Common::Array<byte> &_contents;
+	bool _fail;
+	Common::Array<const Common::Array<byte> *> *_completed;
+};
+
+byte *createSaveData(uint32 size, uint32 seed) {
+	byte *data = (byte *)malloc(size);
+	for (uint32 i = 0; i < size; i++) {
+		seed = seed * 1103515245 + 12345;
+		data[i] = (byte)(seed >> 16);
+	}
+	return data;
+}
+
+bool matchesSaveData(const Common::Array<byte> &contents, uint32 size, uint32 seed) {
+	if (contents.size() != size)
+		return false;
+
+	byte *expected = createSaveData(size, seed);
+	const bool match = !memcmp(&contents[0], expected, size);
+	free(expected);
+	return match;
+}
+
+bool matchesSaveData(Common::SeekableReadStream *stream, uint32 size, uint32 seed) {
+	Common::Array<byte> contents;
+	contents.resize(stream->size());
+	if (!contents.empty())
+		stream->read(&contents[0], contents.size());
+	delete stream;
+
+	return matchesSaveData(contents, size, seed);
+}
+
+Common::JobSystem *createJobSystem() {
+#ifdef USE_PTHREADS
+	return createPthreadJobSystem(2);
+#else
+	return new Common::JobSystem();
+#endif
+}
+
+} // End of anonymous namespace
+
+class AsyncSaveWriterTestSuite : public CxxTest::TestSuite {
+public:
+	void test_failed_write_is_reported() {
+		Common::JobSystem *jobSystem = createJobSystem();
+		Common::Array<byte> good, bad;
+
+		{
+			AsyncSaveWriter writer(jobSystem);
+			writer.queue(new RecordingWriteStream(good), Common::FSNode(), "good.s00", createSaveData(1000, 1), 1000, false);
+			writer.queue(new RecordingWriteStream(bad, true), Common::FSNode(), "bad.s00", createSaveData(1000, 2), 1000, false);
+
+			TS_ASSERT(writer.wait("good.s00"));
+			TS_ASSERT(writer.takeFailedFiles().empty());
+
+			TS_ASSERT(!writer.wait("BAD.s00"));
+			TS_ASSERT(!writer.isPending("bad.s00"));
+
+			Common::StringArray failedFiles = writer.takeFailedFiles();
+			TS_ASSERT_EQUALS(failedFiles.size(), 1u);
+			if (!failedFiles.empty())
+				TS_ASSERT_EQUALS(failedFiles[0], "bad.s00");
+			TS_ASSERT(writer.takeFailedFiles().empty());
+
+			// Failures of writes nobody waited for are kept until taken
+			writer.queue(new RecordingWriteStream(bad, true), Common::FSNode(), "bad.s01", createSaveData(10, 3), 10, false);
+			TS_ASSERT(!writer.wait());
+			TS_ASSERT_EQUALS(writer.takeFailedFiles().size(), 1u);
+		}
+
+		TS_ASSERT(matchesSaveData(good, 1000, 1));
+		TS_ASSERT(bad.empty());
+		delete jobSystem;
+	}
+
+	void test_pending_save_is_complete_after_wait() {
+		Common::JobSystem *jobSystem = createJobSystem();
+		const uint32 size = 4 * 1024 * 1024;
+		Common::Array<byte> first, second, compressed;
+
+		{
+			AsyncSaveWriter writer(jobSystem);
+			writer.queue(new RecordingWriteStream(first), Common::FSNode(), "slot.s00", createSaveData(size, 4), size, false);
+			writer.queue(new RecordingWriteStream(second), Common::FSNode(), "slot.s01", createSaveData(size, 5), size, false);
+			writer.queue(new RecordingWriteStream(compressed), Common::FSNode(), "slot.s02", createSaveData(size, 6), size, true);
+
+			// Waiting for a save file does not wait for the others
+			TS_ASSERT(writer.wait("slot.s01"));
+			TS_ASSERT(!writer.isPending("slot.s01"));
+			TS_ASSERT(matchesSaveData(second, size, 5));
+
+			TS_ASSERT(writer.wait("slot.s02"));
+			Common::SeekableReadStream *stream = Common::wrapCompressedReadStream(
+				new Common::MemoryReadStream(&compressed[0], compressed.size()));
+			Common::Array<byte> contents;
+			contents.resize(size);
+			TS_ASSERT_EQUALS(stream->read(&contents[0], size), size);
+			delete stream;
+			TS_ASSERT(matchesSaveData(contents, size, 6));
+		}
+
+		// Destroying the writer completes the remaining writes
+		TS_ASSERT(matchesSaveData(first, size, 4));
+		delete jobSystem;
+	}
+
+	void test_writes_to_same_file_keep_order() {
+		Common::JobSystem *jobSystem = createJobSystem();
+		const uint32 size = 1024 * 1024;
+		Common::Array<byte> first, second, third, dropped;
+		Common::Array<const Common::Array<byte> *> completed;
+
+		{
+			AsyncSaveWriter writer(jobSystem);
+			writer.queue(new RecordingWriteStream(first, false, &completed), Common::FSNode(), "slot.s00", createSaveData(size, 7), size, false);
+			writer.queue(new RecordingWriteStream(second, false, &completed), Common::FSNode(), "SLOT.s00", createSaveData(size, 8), size, true);
+
+			// The latest contents are read back without waiting for them,
+			// either as written by the engine or as stored on the disk
+			TS_ASSERT(matchesSaveData(writer.createReadStream("slot.s00", false), size, 8));
+			TS_ASSERT(matchesSaveData(Common::wrapCompressedReadStream(writer.createReadStream("slot.s00", true)), size, 8));
+			TS_ASSERT(!writer.createReadStream("slot.s01", false));
+
+			TS_ASSERT(writer.wait());
+			TS_ASSERT(!writer.isPending("slot.s00"));
+
+			// Writes which did not start yet can be dropped
+			writer.queue(new RecordingWriteStream(third, false, &completed), Common::FSNode(), "slot.s00", createSaveData(size, 9), size, false);
+			writer.queue(new RecordingWriteStream(dropped, false, &completed), Common::FSNode(), "slot.s00", createSaveData(size, 10), size, false);
+			writer.cancel("slot.s00");
+			TS_ASSERT(matchesSaveData(writer.createReadStream("slot.s00", false), size, 9));
+		}
+
+		TS_ASSERT_EQUALS(completed.size(), 3u);
+		if (completed.size() == 3) {
+			TS_ASSERT_EQUALS(completed[0], &first);
+			TS_ASSERT_EQUALS(completed[1], &second);
+			TS_ASSERT_EQUALS(completed[2], &third);
+		}
+		TS_ASSERT(matchesSaveData(first, size, 7));
+		TS_ASSERT(matchesSaveData(third, size, 9));
+		TS_ASSERT(dropped.empty());
+		delete jobSystem;
+	}
+};
@@ -0,0 +1,185 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/memstream.h"
+#include "common/str-array.h"
+
+namespace {
+
+/** Archive holding empty members; each stream contains the archive name. */
+class NamedArchive : public Common::Archive {
+public:
+	NamedArchive(const char *name) : _name(name) {}
+
+	void addFile(const char *path) { _files.push_back(path); }
+	void removeFile(const char *path) {
+		for (Common::StringArray::iterator i = _files.begin(); i != _files.end(); ++i) {
+			if (*i == path) {
+				_files.erase(i);
+				return;
+			}
+		}
+	}
+
+	bool hasFile(const Common::Path &path) const override {
+		for (const Common::String &file : _files) {
+			if (path == Common::Path(file))
+				return true;
+		}
+		return false;
+	}
+
+	int listMembers(Common::ArchiveMemberList &list) const override {
+		for (const Common::String &file : _files)
+			list.push_back(Common::ArchiveMemberPtr(new Common::GenericArchiveMember(Common::Path(file), *this)));
+		return _files.size();
+	}
+
+	const Common::ArchiveMemberPtr getMember(const Common::Path &path) const override {
+		return Common::ArchiveMemberPtr(new Common::GenericArchiveMember(path, *this));
+	}
+
+	Common::SeekableReadStream *createReadStreamForMember(const Common::Path &path) const override {
+		if (!hasFile(path))
+			return nullptr;
+		return new Common::MemoryReadStream((const byte *)_name, strlen(_name));
+	}
+
+private:
+	const char *_name;
+	Common::StringArray _files;
+};
+
+Common::String readAll(Common::SeekableReadStream *stream) {
+	if (!stream)
+		return Common::String();
+	Common::String result = stream->readString(0, stream->size());
+	delete stream;
+	return result;
+}
+
+} // End of anonymous namespace
+
+class SearchSetTestSuite : public CxxTest::TestSuite {
+public:
+	void test_priority_order() {
+		Common::SearchSet set;
+		set.setMemberIndexEnabled(true);
+
+		NamedArchive *low = new NamedArchive("low");
+		NamedArchive *high = new NamedArchive("high");
+		low->addFile("a.txt");
+		low->addFile("b.txt");
+		high->addFile("a.txt");
+
+		set.add("low", low, 0);
+		set.add("high", high, 10);
+
+		for (int pass = 0; pass < 2; pass++) {
+			TS_ASSERT_EQUALS(readAll(set.createReadStreamForMember("a.txt")), "high");
+			TS_ASSERT_EQUALS(readAll(set.createReadStreamForMember("b.txt")), "low");
+			TS_ASSERT(!set.createReadStreamForMember("c.txt"));
+
+			Common::Archive *container = nullptr;
+			TS_ASSERT(set.getMember("b.txt", &container));
+			TS_ASSERT_EQUALS(container, low);
+		}
+
+		// Reprioritizing must not serve stale index entries
+		set.setPriority("low", 20);
+		TS_ASSERT_EQUALS(readAll(set.createReadStreamForMember("a.txt")), "low");
+
+		set.remove("low");
+		TS_ASSERT_EQUALS(readAll(set.createReadStreamForMember("a.txt")), "high");
+		TS_ASSERT(!set.hasFile("b.txt"));
+	}
+
+	void test_index_hits_and_stats() {
+		Common::SearchSet set;
+		set.setMemberIndexEnabled(true);
+
+		NamedArchive *archives[4];
+		for (int i = 0; i < 4; i++) {
+			archives[i] = new NamedArchive("arc");
+			set.add(Common::String::format("arc%d", i), archives[i], 4 - i);
+		}
+		archives[3]->addFile("last.txt");
+
+		TS_ASSERT(set.hasFile("last.txt"));
+		TS_ASSERT_EQUALS(set.getMemberIndexStats().lookups, 1u);
+		TS_ASSERT_EQUALS(set.getMemberIndexStats().archiveProbes, 4u);
+		TS_ASSERT_EQUALS(set.getMemberIndexStats().indexHits, 0u);
+
+		set.resetMemberIndexStats();
+		TS_ASSERT(set.hasFile("last.txt"));
+		TS_ASSERT(set.getMember("last.txt"));
+		TS_ASSERT_EQUALS(set.getMemberIndexStats().lookups, 2u);
+		TS_ASSERT_EQUALS(set.getMemberIndexStats().archiveProbes, 2u);
+		TS_ASSERT_EQUALS(set.getMemberIndexStats().indexHits, 2u);
+
+		// A member which went away falls back to the full search
+		archives[3]->removeFile("last.txt");
+		archives[2]->addFile("last.txt");
+		set.resetMemberIndexStats();
+		TS_ASSERT(set.hasFile("last.txt"));
+		TS_ASSERT_EQUALS(set.getMemberIndexStats().indexHits, 0u);
+
+		Common::Archive *container = nullptr;
+		set.getMember("last.txt", &container);
+		TS_ASSERT_EQUALS(container, archives[2]);
+	}
+
+	void test_index_follows_archive_changes() {
+		Common::SearchSet set;
+		set.setMemberIndexEnabled(true);
+
+		NamedArchive *low = new NamedArchive("low");
+		low->addFile("a.txt");
+		set.add("low", low, 0);
+		TS_ASSERT_EQUALS(readAll(set.createReadStreamForMember("a.txt")), "low");
+		TS_ASSERT(set.hasFile("a.txt"));
+
+		// Adding an archive which shadows the member drops the index
+		NamedArchive *high = new NamedArchive("high");
+		high->addFile("a.txt");
+		set.add("high", high, 10);
+
+		Common::Archive *container = nullptr;
+		TS_ASSERT(set.getMember("a.txt", &container));
+		TS_ASSERT_EQUALS(container, high);
+		TS_ASSERT_EQUALS(readAll(set.createReadStreamForMember("a.txt")), "high");
+
+		// So does removing the archive which was remembered
+		set.remove("high");
+		TS_ASSERT(set.getMember("a.txt", &container));
+		TS_ASSERT_EQUALS(container, low);
+		TS_ASSERT_EQUALS(readAll(set.createReadStreamForMember("a.txt")), "low");
+
+		// Entries whose archive lost the member are dropped
+		low->removeFile("a.txt");
+		set.resetMemberIndexStats();
+		TS_ASSERT(!set.hasFile("a.txt"));
+		TS_ASSERT(!set.createReadStreamForMember("a.txt"));
+		TS_ASSERT_EQUALS(set.getMemberIndexStats().archiveProbes, 4u);
+
+		set.resetMemberIndexStats();
+		TS_ASSERT(!set.hasFile("a.txt"));
+		TS_ASSERT(!set.createReadStreamForMember("a.txt"));
+		TS_ASSERT_EQUALS(set.getMemberIndexStats().archiveProbes, 2u);
+		TS_ASSERT_EQUALS(set.getMemberIndexStats().indexHits, 0u);
+	}
+
+	void test_index_disabled() {
+		Common::SearchSet set;
+		NamedArchive *archive = new NamedArchive("arc");
+		archive->addFile("file");
+		set.add("arc", new NamedArchive("empty"), 1);
+		set.add("arc2", archive, 0);
+
+		TS_ASSERT(set.hasFile("file"));
+		TS_ASSERT(set.hasFile("file"));
+		TS_ASSERT_EQUALS(set.getMemberIndexStats().lookups, 2u);
+		TS_ASSERT_EQUALS(set.getMemberIndexStats().archiveProbes, 4u);
+		TS_ASSERT_EQUALS(set.getMemberIndexStats().indexHits, 0u);
+	}
+};
@@ -0,0 +1,70 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/path.h"
+#include "common/str-intern.h"
+
+class InternedStringTestSuite : public CxxTest::TestSuite {
+public:
+	void test_identity() {
+		Common::InternedString a("SomeSymbol");
+		Common::InternedString b(Common::String("Some") + "Symbol");
+		Common::InternedString c("someSymbol");
+
+		TS_ASSERT(a == b);
+		TS_ASSERT_EQUALS(a.c_str(), b.c_str());
+		TS_ASSERT(a != c);
+		TS_ASSERT_EQUALS(a.hash(), Common::String("SomeSymbol").hash());
+		TS_ASSERT_EQUALS(a.toString(), "SomeSymbol");
+		TS_ASSERT_EQUALS(a.size(), 10u);
+
+		TS_ASSERT(Common::InternedString().empty());
+		TS_ASSERT(Common::InternedString() == Common::InternedString(""));
+
+		Common::InternedString path(Common::Path("dir/file.txt"));
+		TS_ASSERT(path == Common::InternedString("dir/file.txt"));
+	}
+
+	void test_ignore_case() {
+		Common::InternedString a("MixedCase");
+		Common::InternedString b("MIXEDCASE");
+		Common::InternedString lower("mixedcase");
+
+		TS_ASSERT(a.equalsIgnoreCase(b));
+		TS_ASSERT(a.lower() == lower);
+		TS_ASSERT(lower.lower() == lower);
+		TS_ASSERT(!a.equalsIgnoreCase(Common::InternedString("MixedCase2")));
+	}
+
+	void test_table_does_not_grow_for_known_strings() {
+		Common::InternedString first("table-test-string");
+		uint size = Common::InternedString::getTableSize();
+
+		for (int i = 0; i < 10; i++)
+			Common::InternedString again("table-test-string");
+		TS_ASSERT_EQUALS(Common::InternedString::getTableSize(), size);
+	}
+
+	void test_maps() {
+		Common::InternedStringMap<int> map;
+		map[Common::InternedString("x")] = 1;
+		map[Common::InternedString("X")] = 2;
+		TS_ASSERT_EQUALS(map.size(), 2u);
+		TS_ASSERT_EQUALS(map[Common::InternedString("x")], 1);
+
+		Common::InternedStringMapIgnoreCase<int> icMap;
+		icMap[Common::InternedString("Key")] = 1;
+		icMap[Common::InternedString("KEY")] = 2;
+		TS_ASSERT_EQUALS(icMap.size(), 1u);
+		TS_ASSERT_EQUALS(icMap[Common::InternedString("key")], 2);
+		TS_ASSERT(!icMap.contains(Common::InternedString("other")));
+	}
+
+	void test_ordering() {
+		Common::InternedString b("order-b");
+		Common::InternedString a("order-a");
+
+		TS_ASSERT(a < b);
+		TS_ASSERT(!(b < a));
+		TS_ASSERT(!(a < a));
+	}
+};
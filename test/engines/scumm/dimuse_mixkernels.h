@@ -0,0 +1,150 @@
+#include <cxxtest/TestSuite.h>
+
+#include "scumm/imuse_digi/dimuse_mixkernels.h"
+
+/**
+ * Checks the vectorized iMUSE mixing kernels against lookups in amplitude
+ * tables built the same way as IMuseDigiInternalMixer::init() builds them.
+ */
+class IMuseDigiMixKernelsTestSuite : public CxxTest::TestSuite {
+	int16 _amp8Table[17 * 256];
+	int16 _amp12Table[17 * 4096];
+
+	uint32 _seed;
+
+	uint32 nextRandom() {
+		_seed = _seed * 1103515245 + 12345;
+		return _seed >> 8;
+	}
+
+	void buildTables() {
+		int zeroCenterOffset = 0;
+		for (int i = 0; i < 17; i++) {
+			int amplitudeValue = -2048 * zeroCenterOffset;
+			for (int j = 0; j < 256; j++) {
+				_amp8Table[i * 256 + j] = (int16)(amplitudeValue / 127);
+				amplitudeValue += 16 * zeroCenterOffset;
+			}
+
+			zeroCenterOffset += 8;
+			if (zeroCenterOffset == 8)
+				zeroCenterOffset = 7;
+		}
+
+		zeroCenterOffset = 0;
+		for (int i = 0; i < 17; i++) {
+			int amplitudeValue = -2048 * zeroCenterOffset;
+			for (int j = 0; j < 4096; j++) {
+				_amp12Table[i * 4096 + j] = (int16)(amplitudeValue / 127);
+				amplitudeValue += zeroCenterOffset;
+			}
+
+			zeroCenterOffset += 8;
+			if (zeroCenterOffset == 8)
+				zeroCenterOffset = 7;
+		}
+	}
+
+	int16 amp8(int volume, uint8 sample) const {
+		return _amp8Table[volume * 256 + sample];
+	}
+
+	int16 amp16(int volume, int16 sample) const {
+		return _amp12Table[volume * 4096 + (sample >> 4) + 2048];
+	}
+
+	void fillMixBuffer(uint16 *buf, int count) {
+		for (int i = 0; i < count; i++)
+			buf[i] = (uint16)nextRandom();
+	}
+
+	void checkKernels(const Scumm::IMuseDigiMixKernels *kernels) {
+		// Odd lengths exercise the scalar tails as well
+		const int kCount = 1029;
+		uint8 src8[kCount];
+		int16 src16[kCount];
+		uint16 expected[2 * kCount];
+		uint16 result[2 * kCount];
+
+		for (int i = 0; i < kCount; i++) {
+			src8[i] = (uint8)nextRandom();
+			src16[i] = (int16)nextRandom();
+		}
+		// Include the extremes of both sample formats
+		src8[0] = 0;
+		src8[1] = 255;
+		src16[0] = -32768;
+		src16[1] = 32767;
+
+		for (int volume = 0; volume < 17; volume++) {
+			int scale = Scumm::IMuseDigiMixKernels::getAmpScale(volume);
+			int otherVolume = 16 - volume;
+			int otherScale = Scumm::IMuseDigiMixKernels::getAmpScale(otherVolume);
+
+			fillMixBuffer(expected, kCount);
+			memcpy(result, expected, kCount * sizeof(uint16));
+			for (int i = 0; i < kCount; i++)
+				expected[i] += amp8(volume, src8[i]);
+			kernels->mixBits8(result, src8, kCount, scale);
+			TS_ASSERT_SAME_DATA(expected, result, kCount * sizeof(uint16));
+
+			fillMixBuffer(expected, kCount);
+			memcpy(result, expected, kCount * sizeof(uint16));
+			for (int i = 0; i < kCount; i++)
+				expected[i] += amp16(volume, src16[i]);
+			kernels->mixBits16(result, src16, kCount, scale);
+			TS_ASSERT_SAME_DATA(expected, result, kCount * sizeof(uint16));
+
+			fillMixBuffer(expected, 2 * kCount);
+			memcpy(result, expected, 2 * kCount * sizeof(uint16));
+			for (int i = 0; i < kCount; i++) {
+				expected[2 * i] += amp8(volume, src8[i]);
+				expected[2 * i + 1] += amp8(otherVolume, src8[i]);
+			}
+			kernels->mixBits8ToStereo(result, src8, kCount, scale, otherScale);
+			TS_ASSERT_SAME_DATA(expected, result, 2 * kCount * sizeof(uint16));
+
+			fillMixBuffer(expected, 2 * kCount);
+			memcpy(result, expected, 2 * kCount * sizeof(uint16));
+			for (int i = 0; i < kCount; i++) {
+				expected[2 * i] += amp16(volume, src16[i]);
+				expected[2 * i + 1] += amp16(otherVolume, src16[i]);
+			}
+			kernels->mixBits16ToStereo(result, src16, kCount, scale, otherScale);
+			TS_ASSERT_SAME_DATA(expected, result, 2 * kCount * sizeof(uint16));
+		}
+
+		// Every 16-bit sample value at full volume
+		static uint16 allExpected[65536];
+		static uint16 allResult[65536];
+		static int16 allSamples[65536];
+		for (int i = 0; i < 65536; i++) {
+			allSamples[i] = (int16)(i - 32768);
+			allExpected[i] = allResult[i] = 0;
+		}
+		for (int i = 0; i < 65536; i++)
+			allExpected[i] += amp16(16, allSamples[i]);
+		kernels->mixBits16(allResult, allSamples, 65536, Scumm::IMuseDigiMixKernels::getAmpScale(16));
+		TS_ASSERT_SAME_DATA(allExpected, allResult, sizeof(allResult));
+	}
+
+public:
+	void setUp() {
+		_seed = 0x5C077;
+		buildTables();
+	}
+
+	void test_scale_matches_tables() {
+		for (int volume = 0; volume < 17; volume++) {
+			int scale = Scumm::IMuseDigiMixKernels::getAmpScale(volume);
+			TS_ASSERT_EQUALS(amp8(volume, 255), (int16)((16 * 127 * scale) / 127));
+			TS_ASSERT_EQUALS(amp16(volume, 32767), (int16)((2047 * scale) / 127));
+		}
+	}
+
+#ifdef SCUMMVM_SSE2
+	void test_sse2_kernels() {
+		checkKernels(&Scumm::g_imuseDigiMixKernelsSSE2);
+	}
+#endif
+};
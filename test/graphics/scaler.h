@@ -0,0 +1,210 @@
+#include <cxxtest/TestSuite.h>
+
+#include "test/instrset_detect.h"
+
+#include "common/array.h"
+#include "common/crc.h"
+#include "common/jobsystem.h"
+#include "graphics/scalerplugin.h"
+
+#ifdef USE_SCALERS
+#include "graphics/scaler/normal.h"
+#include "graphics/scaler/scalebit.h"
+#endif
+#ifdef USE_HQ_SCALERS
+#include "graphics/scaler/hq.h"
+#endif
+
+#ifdef USE_PTHREADS
+#include "backends/jobs/pthread/pthread-jobsystem.h"
+#endif
+
+namespace {
+
+/** A source image with a border of margin pixels, filled with a noisy pattern. */
+class ScalerSource {
+public:
+	ScalerSource(const Graphics::PixelFormat &format, int width, int height, int margin)
+		: _format(format), _width(width), _height(height), _margin(margin) {
+		_pitch = (width + margin * 2) * format.bytesPerPixel;
+		_pixels.resize(_pitch * (height + margin * 2));
+
+		uint32 seed = 1;
+		for (uint i = 0; i < _pixels.size(); i++) {
+			seed = seed * 1103515245 + 12345;
+			// Runs of equal pixels, so the scalers find edges to smooth
+			_pixels[i] = (seed >> 28) < 3 ? (byte)(seed >> 16) : (byte)(i / 64);
+		}
+	}
+
+	const byte *getRect(int x, int y) const {
+		return _pixels.begin() + (y + _margin) * _pitch + (x + _margin) * _format.bytesPerPixel;
+	}
+
+	uint getPitch() const { return _pitch; }
+
+private:
+	Graphics::PixelFormat _format;
+	int _width, _height, _margin;
+	uint _pitch;
+	Common::Array<byte> _pixels;
+};
+
+/** Scale a rect once directly and once in bands, and compare the results. */
+bool bandsMatchSerial(Scaler &scaler, Common::JobSystem *jobSystem, const Graphics::PixelFormat &format, uint factor, uint margin) {
+	const int width = 160, height = 120;
+	const int x = 8, y = 4;
+	ScalerSource source(format, 200, 140, margin);
+	scaler.setFactor(factor);
+
+	const uint dstPitch = width * factor * format.bytesPerPixel;
+	Common::Array<byte> serial, bands;
+	serial.resize(dstPitch * height * factor);
+	bands.resize(dstPitch * height * factor);
+
+	scaler.scale(source.getRect(x, y), source.getPitch(), serial.begin(), dstPitch, width, height, x, y);
+	scaler.scaleInBands(jobSystem, margin, source.getRect(x, y), source.getPitch(), bands.begin(), dstPitch, width, height, x, y);
+
+	return serial == bands;
+}
+
+/** Scale a rect and return the CRC32 of the output. */
+uint32 scaleChecksum(Scaler &scaler, const Graphics::PixelFormat &format, uint factor) {
+	// An odd width, so the vector code leaves pixels for the scalar code
+	const int width = 157, height = 61;
+	ScalerSource source(format, width, height, 1);
+	scaler.setFactor(factor);
+
+	const uint dstPitch = width * factor * format.bytesPerPixel;
+	Common::Array<byte> output;
+	output.resize(dstPitch * height * factor);
+
+	scaler.scale(source.getRect(0, 0), source.getPitch(), output.begin(), dstPitch, width, height, 0, 0);
+	return Common::CRC32().crcFast(output.begin(), output.size());
+}
+
+} // End of anonymous namespace
+
+class ScalerTestSuite : public CxxTest::TestSuite {
+public:
+	void test_bands_without_workers() {
+#ifdef USE_SCALERS
+		const Graphics::PixelFormat rgb565(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		Common::JobSystem inlineJobs;
+		NormalScaler scaler(rgb565);
+
+		TS_ASSERT(scaler.canScaleInBands());
+		TS_ASSERT(bandsMatchSerial(scaler, &inlineJobs, rgb565, 2, 1));
+		TS_ASSERT(bandsMatchSerial(scaler, nullptr, rgb565, 3, 1));
+#endif
+	}
+
+	void test_bands_match_serial() {
+#if defined(USE_SCALERS) && defined(USE_PTHREADS)
+		const Graphics::PixelFormat rgb565(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		const Graphics::PixelFormat argb8888(4, 8, 8, 8, 8, 16, 8, 0, 24);
+		Common::JobSystem *jobSystem = createPthreadJobSystem(3);
+
+		NormalScaler normal(argb8888);
+		TS_ASSERT(bandsMatchSerial(normal, jobSystem, argb8888, 4, 1));
+
+		// Scale4x reads two rows around each band
+		AdvMameScaler advMame(rgb565);
+		for (uint factor = 2; factor <= 4; factor++)
+			TS_ASSERT(bandsMatchSerial(advMame, jobSystem, rgb565, factor, 4));
+
+#ifdef USE_HQ_SCALERS
+		// Keep the scalers from asking g_system for the CPU features
+		HQScaler::findPatternsFunc = HQScaler::findPatternsGeneric;
+		HQScaler hq16(rgb565);
+		HQScaler hq32(argb8888);
+		for (uint factor = 2; factor <= 3; factor++) {
+			TS_ASSERT(bandsMatchSerial(hq16, jobSystem, rgb565, factor, 1));
+			TS_ASSERT(bandsMatchSerial(hq32, jobSystem, argb8888, factor, 1));
+		}
+#endif
+
+		delete jobSystem;
+#endif
+	}
+};
+
+class HQScalerTestSuite : public CxxTest::TestSuite {
+public:
+	void test_golden_images() {
+#ifdef USE_HQ_SCALERS
+		HQScaler::findPatternsFunc = HQScaler::findPatternsGeneric;
+
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0)
+		};
+		// The output of the scalers before their patterns were found with vector code
+		const uint32 golden[][2] = {
+			{ 0xD6D4E064, 0xC57B42B5 },
+			{ 0x60AA0C50, 0xE9F23580 },
+			{ 0x3838D322, 0x46721829 },
+			{ 0x48FCAD3B, 0xD995AB6D }
+		};
+
+		for (uint i = 0; i < ARRAYSIZE(formats); i++) {
+			HQScaler scaler(formats[i]);
+			for (uint factor = 2; factor <= 3; factor++)
+				TS_ASSERT_EQUALS(scaleChecksum(scaler, formats[i], factor), golden[i][factor - 2]);
+		}
+#endif
+	}
+
+	void test_vector_patterns_match_generic() {
+#ifdef USE_HQ_SCALERS
+		Common::Array<HQScaler::FindPatternsFunc> funcs;
+#ifdef SCUMMVM_NEON
+		funcs.push_back(HQScaler::findPatternsNEON);
+#endif
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			funcs.push_back(HQScaler::findPatternsSSE2);
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8)
+			funcs.push_back(HQScaler::findPatternsAVX2);
+#endif
+
+		// Values right at and just past each threshold of diffYUV()
+		const uint32 yuvs[] = { 0x804020, 0xB04020, 0xB14020, 0x4F4020, 0x804720, 0x804820, 0x803820, 0x804026, 0x804027, 0x804019, 0x000000, 0xFFFFFF };
+		uint32 rows[3][64 + 2];
+		uint32 seed = 1;
+		for (uint row = 0; row < 3; row++) {
+			for (uint i = 0; i < ARRAYSIZE(rows[row]); i++) {
+				seed = seed * 1103515245 + 12345;
+				rows[row][i] = yuvs[(seed >> 16) % ARRAYSIZE(yuvs)];
+			}
+		}
+
+		uint8 expected[64], patterns[64];
+		for (int width = 1; width <= 64; width += 7) {
+			HQScaler::findPatternsGeneric(rows[0], rows[1], rows[2], expected, width);
+			for (uint i = 0; i < funcs.size(); i++) {
+				funcs[i](rows[0], rows[1], rows[2], patterns, width);
+				TS_ASSERT_SAME_DATA(patterns, expected, width);
+			}
+		}
+
+		const Graphics::PixelFormat rgb565(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		const Graphics::PixelFormat argb8888(4, 8, 8, 8, 8, 16, 8, 0, 24);
+		HQScaler::findPatternsFunc = HQScaler::findPatternsGeneric;
+		HQScaler hq16(rgb565);
+		HQScaler hq32(argb8888);
+		const uint32 expected16 = scaleChecksum(hq16, rgb565, 2);
+		const uint32 expected32 = scaleChecksum(hq32, argb8888, 3);
+
+		for (uint i = 0; i < funcs.size(); i++) {
+			HQScaler::findPatternsFunc = funcs[i];
+			TS_ASSERT_EQUALS(scaleChecksum(hq16, rgb565, 2), expected16);
+			TS_ASSERT_EQUALS(scaleChecksum(hq32, argb8888, 3), expected32);
+		}
+#endif
+	}
+};
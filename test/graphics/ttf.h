@@ -0,0 +1,91 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/fs.h"
+
+#include "graphics/font.h"
+#include "graphics/surface.h"
+#include "graphics/fonts/ttf.h"
+
+#ifdef USE_FREETYPE2
+
+namespace {
+
+void drawAll(const Graphics::Font *font, Graphics::Surface &surface, const uint32 *chars, uint count) {
+	surface.fillRect(Common::Rect(surface.w, surface.h), 0);
+	for (uint i = 0; i < count; i++)
+		font->drawChar(&surface, chars[i], i * 16, 0, 255);
+}
+
+bool equalSurfaces(const Graphics::Surface &a, const Graphics::Surface &b) {
+	for (int y = 0; y < a.h; y++) {
+		if (memcmp(a.getBasePtr(0, y), b.getBasePtr(0, y), a.w))
+			return false;
+	}
+	return true;
+}
+
+Graphics::Font *loadTestFont(int size, const uint32 *mapping) {
+	// Copied there by the copy-dat rule
+	Common::SeekableReadStream *stream = Common::FSNode("test/engine-data/GoMono-Regular.ttf").createReadStream();
+	if (!stream)
+		return nullptr;
+
+	return Graphics::loadTTFFont(stream, DisposeAfterUse::YES, size, Graphics::kTTFSizeModeCharacter, 0, 0,
+	                             Graphics::kTTFRenderModeLight, mapping);
+}
+
+} // End of anonymous namespace
+
+#endif
+
+class TTFFontTestSuite : public CxxTest::TestSuite {
+public:
+	void test_mapped_font_survives_eviction() {
+#ifdef USE_FREETYPE2
+		// Code points which differ from the keys of the glyphs
+		uint32 mapping[256];
+		for (uint i = 0; i < 256; i++)
+			mapping[i] = 'A' + (i % 26);
+
+		Graphics::Font *mapped = loadTestFont(12, mapping);
+		TS_ASSERT(mapped);
+		if (!mapped)
+			return;
+
+		const uint32 chars[] = { 200, 1, 27 };
+		Graphics::Surface expected, actual;
+		expected.create(ARRAYSIZE(chars) * 16, 32, Graphics::PixelFormat::createFormatCLUT8());
+		actual.create(ARRAYSIZE(chars) * 16, 32, Graphics::PixelFormat::createFormatCLUT8());
+		drawAll(mapped, expected, chars, ARRAYSIZE(chars));
+
+		// Leave room for a single page, so loading another font drops
+		// the pages of the mapped one
+		Graphics::TTFGlyphCacheStats stats;
+		Graphics::getTTFGlyphCacheStats(stats);
+		const uint32 budget = stats.budget;
+		Graphics::setTTFGlyphCacheBudget(1);
+
+		Graphics::Font *other = loadTestFont(14, nullptr);
+		TS_ASSERT(other);
+
+		Graphics::resetTTFGlyphCacheStats();
+		drawAll(mapped, actual, chars, ARRAYSIZE(chars));
+		TS_ASSERT(equalSurfaces(expected, actual));
+
+		// The glyphs were rendered again instead of read from a dropped page
+		Graphics::getTTFGlyphCacheStats(stats);
+		TS_ASSERT_EQUALS(stats.misses, (uint32)ARRAYSIZE(chars));
+		TS_ASSERT_EQUALS(stats.hits, 0u);
+
+		Graphics::setTTFGlyphCacheBudget(budget);
+		delete other;
+
+		// Fonts may outlive the library
+		Graphics::shutdownTTF();
+		delete mapped;
+
+		expected.free();
+		actual.free();
+#endif
+	}
+};
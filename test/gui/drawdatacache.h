@@ -0,0 +1,152 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/managed_surface.h"
+#include "graphics/VectorRenderer.h"
+
+#include "gui/DrawDataCache.h"
+
+namespace {
+
+const Graphics::PixelFormat kFormat(4, 8, 8, 8, 8, 16, 8, 0, 24);
+
+void fillNoise(Graphics::ManagedSurface &surface, uint32 seed) {
+	for (int y = 0; y < surface.h; y++) {
+		for (int x = 0; x < surface.w; x++) {
+			seed = seed * 1103515245 + 12345;
+			surface.setPixel(x, y, kFormat.RGBToColor(seed >> 24, seed >> 16, seed >> 8));
+		}
+	}
+}
+
+bool equalSurfaces(const Graphics::ManagedSurface &a, const Graphics::ManagedSurface &b) {
+	for (int y = 0; y < a.h; y++) {
+		if (memcmp(a.getBasePtr(0, y), b.getBasePtr(0, y), a.w * kFormat.bytesPerPixel))
+			return false;
+	}
+	return true;
+}
+
+/** A button like item: a rounded gradient with a shadow, and a frame. */
+Common::List<Graphics::DrawStep> createButtonSteps() {
+	Common::List<Graphics::DrawStep> steps;
+
+	Graphics::DrawStep background;
+	background.drawingCall = &Graphics::VectorRenderer::drawCallback_ROUNDSQ;
+	background.autoWidth = background.autoHeight = true;
+	background.fillMode = Graphics::VectorRenderer::kFillGradient;
+	background.gradColor1.r = 200; background.gradColor1.g = 120; background.gradColor1.b = 40;
+	background.gradColor1.set = true;
+	background.gradColor2.r = 250; background.gradColor2.g = 200; background.gradColor2.b = 100;
+	background.gradColor2.set = true;
+	background.factor = 1;
+	background.radius = 5;
+	background.shadow = 3;
+	steps.push_back(background);
+
+	Graphics::DrawStep frame;
+	frame.drawingCall = &Graphics::VectorRenderer::drawCallback_ROUNDSQ;
+	frame.autoWidth = frame.autoHeight = true;
+	frame.fillMode = Graphics::VectorRenderer::kFillDisabled;
+	frame.fgColor.r = 30; frame.fgColor.g = 30; frame.fgColor.b = 30;
+	frame.fgColor.set = true;
+	frame.stroke = 1;
+	frame.radius = 5;
+	steps.push_back(frame);
+
+	return steps;
+}
+
+Common::Rect stepsRectFor(const Common::Rect &area) {
+	// Threshold of the dirty rects, plus the shadow
+	return Common::Rect(area.left - 2, area.top - 2, area.right + 2 + 3, area.bottom + 2 + 3);
+}
+
+void drawFresh(Graphics::VectorRenderer *renderer, Graphics::ManagedSurface &surface, const Common::List<Graphics::DrawStep> &steps,
+               const Common::Rect &area, const Common::Rect &clip) {
+	renderer->setSurface(&surface);
+	for (Common::List<Graphics::DrawStep>::const_iterator step = steps.begin(); step != steps.end(); ++step)
+		renderer->drawStep(area, clip, *step, 0);
+}
+
+} // End of anonymous namespace
+
+class DrawDataCacheTestSuite : public CxxTest::TestSuite {
+public:
+	void test_can_cache() {
+		Common::List<Graphics::DrawStep> steps = createButtonSteps();
+		TS_ASSERT(GUI::DrawDataCache::canCache(steps));
+
+		// Flat fills are cheaper to draw than to copy
+		Common::List<Graphics::DrawStep> flat;
+		Graphics::DrawStep square;
+		square.drawingCall = &Graphics::VectorRenderer::drawCallback_SQUARE;
+		square.autoWidth = square.autoHeight = true;
+		square.fillMode = Graphics::VectorRenderer::kFillForeground;
+		flat.push_back(square);
+		TS_ASSERT(!GUI::DrawDataCache::canCache(flat));
+
+		// Filling the surface draws outside of the item
+		Graphics::DrawStep fill;
+		fill.drawingCall = &Graphics::VectorRenderer::drawCallback_FILLSURFACE;
+		steps.push_back(fill);
+		TS_ASSERT(!GUI::DrawDataCache::canCache(steps));
+	}
+
+	void test_cached_output_matches_fresh_draw() {
+		Graphics::VectorRenderer *renderer = Graphics::createRenderer(GUI::ThemeEngine::kGfxStandard, kFormat);
+		TS_ASSERT(renderer);
+		if (!renderer)
+			return;
+
+		GUI::DrawDataCache cache(1024 * 1024);
+		const Common::List<Graphics::DrawStep> steps = createButtonSteps();
+
+		Graphics::ManagedSurface background(160, 100, kFormat), expected(160, 100, kFormat), actual(160, 100, kFormat);
+		fillNoise(background, 1);
+
+		const Common::Rect areas[] = {
+			Common::Rect(10, 10, 90, 40),
+			Common::Rect(10, 10, 90, 40),  // Hit
+			Common::Rect(30, 50, 110, 80), // Same size, other pixels below
+			Common::Rect(11, 10, 91, 40),  // Odd position, the gradient dithering differs
+			Common::Rect(10, 10, 90, 40)   // Hit
+		};
+		const Common::Rect clips[] = {
+			Common::Rect(),
+			Common::Rect(),
+			Common::Rect(),
+			Common::Rect(),
+			Common::Rect(0, 0, 60, 100)    // Clipped, but the unclipped result is kept
+		};
+
+		for (uint i = 0; i < ARRAYSIZE(areas); i++) {
+			expected.blitFrom(background);
+			drawFresh(renderer, expected, steps, areas[i], clips[i]);
+
+			actual.blitFrom(background);
+			renderer->setSurface(&actual);
+			cache.drawSteps(renderer, 0, steps, areas[i], stepsRectFor(areas[i]), clips[i], 0);
+
+			TS_ASSERT(equalSurfaces(expected, actual));
+		}
+
+		// The clipped draw has its own entry
+		TS_ASSERT_EQUALS(cache.getHitCount(), 1u);
+
+		actual.blitFrom(background);
+		cache.drawSteps(renderer, 0, steps, areas[4], stepsRectFor(areas[4]), clips[4], 0);
+		TS_ASSERT_EQUALS(cache.getHitCount(), 2u);
+
+		// Nothing is reused over other pixels
+		expected.blitFrom(background);
+		expected.fillRect(Common::Rect(20, 20, 40, 30), kFormat.RGBToColor(0, 0, 255));
+		actual.blitFrom(expected);
+		drawFresh(renderer, expected, steps, areas[0], Common::Rect());
+		renderer->setSurface(&actual);
+		cache.drawSteps(renderer, 0, steps, areas[0], stepsRectFor(areas[0]), Common::Rect(), 0);
+		TS_ASSERT(equalSurfaces(expected, actual));
+		TS_ASSERT_EQUALS(cache.getHitCount(), 2u);
+
+		delete renderer;
+	}
+};
@@ -0,0 +1,193 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+
+#include "gui/ThemeCache.h"
+#include "gui/ThemeEngine.h"
+#include "gui/ThemeEval.h"
+#include "gui/ThemeParser.h"
+
+namespace {
+
+/** A small theme without fonts or bitmaps, which need files. */
+const char *kThemeXML =
+	"<?xml version = '1.0'?>"
+	"<render_info>"
+		"<palette>"
+			"<color name='black' rgb='0, 0, 0'/>"
+			"<color name='white' rgb='255, 255, 255'/>"
+			"<color name='orange' rgb='240, 160, 40'/>"
+		"</palette>"
+		"<fonts>"
+			"<text_color id='color_normal' color='black'/>"
+			"<text_color id='color_alternative' color='120, 80, 20'/>"
+		"</fonts>"
+		"<defaults fill='foreground' fg_color='black' bg_color='white' shadow='0' stroke='1'/>"
+		"<drawdata id='mainmenu_bg' cache='false'>"
+			"<drawstep func='fill' fill='gradient' gradient_start='orange' gradient_end='white' gradient_factor='2'/>"
+		"</drawdata>"
+		"<drawdata id='button_idle' cache='true'>"
+			"<drawstep func='roundedsq' radius='5' shadow='2' fill='gradient' gradient_start='orange' gradient_end='white'/>"
+			"<drawstep func='triangle' fg_color='black' fill='foreground' width='8' height='6' xpos='right' ypos='center' orientation='bottom' padding='0, 0, 4, 0'/>"
+		"</drawdata>"
+		"<drawdata id='separator' cache='false'>"
+			"<drawstep func='square' fill='foreground' height='1' ypos='center' fg_color='orange' clip='2, 0, 2, 0'/>"
+		"</drawdata>"
+	"</render_info>"
+	"<layout_info>"
+		"<globals>"
+			"<def var='Line.Height' value='16'/>"
+			"<def var='Layout.Spacing' value='8'/>"
+			"<widget name='Button' size='108, 24'/>"
+		"</globals>"
+		"<dialog name='Test' overlays='screen' inset='16'>"
+			"<layout type='vertical' padding='8, 8, 8, 8' spacing='4'>"
+				"<widget name='Title' height='Globals.Line.Height' textalign='center'/>"
+				"<layout type='horizontal' padding='0, 0, 16, 0'>"
+					"<space/>"
+					"<widget name='Close' type='Button' rtl='no'/>"
+				"</layout>"
+			"</layout>"
+		"</dialog>"
+	"</layout_info>";
+
+GUI::ThemeCache::Key createKey() {
+	GUI::ThemeCache::Key key;
+	key.themeId = "test";
+	key.themeHash = 0x12345678;
+	key.baseWidth = 640;
+	key.baseHeight = 480;
+	key.scaleFactor = 1.0f;
+	key.format = Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24);
+	return key;
+}
+
+/** Write what the engine cache recorded, the same way for both engines. */
+bool saveRecording(GUI::ThemeEngine &engine, const Common::String &themeName, Common::MemoryWriteStreamDynamic &out) {
+	return engine.getThemeCache()->save(out, createKey(), themeName, engine);
+}
+
+/** Parse kThemeXML into the engine, recording it. */
+bool recordTheme(GUI::ThemeEngine &engine, Common::MemoryWriteStreamDynamic &out) {
+	GUI::ThemeParser parser(&engine);
+	if (!parser.loadBuffer((const byte *)kThemeXML, strlen(kThemeXML)))
+		return false;
+
+	engine.getThemeCache()->startRecording();
+	const bool parsed = parser.parse();
+	parser.close();
+	engine.getThemeCache()->stopRecording();
+
+	return parsed && saveRecording(engine, "Test theme", out);
+}
+
+bool loadCache(const byte *data, uint32 size, const GUI::ThemeCache::Key &key) {
+	GUI::ThemeEngine engine("builtin", GUI::ThemeEngine::kGfxDisabled);
+	Common::MemoryReadStream in(data, size);
+	Common::String themeName;
+	return GUI::ThemeCache::load(in, key, engine, themeName);
+}
+
+} // End of anonymous namespace
+
+class ThemeCacheTestSuite : public CxxTest::TestSuite {
+public:
+	void test_replay_matches_parsed_theme() {
+		GUI::ThemeEngine parsed("builtin", GUI::ThemeEngine::kGfxDisabled);
+		Common::MemoryWriteStreamDynamic recorded(DisposeAfterUse::YES);
+		TS_ASSERT(recordTheme(parsed, recorded));
+
+		// Replay into a fresh engine, recording the replay in turn
+		GUI::ThemeEngine replayed("builtin", GUI::ThemeEngine::kGfxDisabled);
+		Common::MemoryReadStream in(recorded.getData(), recorded.size());
+		Common::String themeName;
+		replayed.getThemeCache()->startRecording();
+		TS_ASSERT(GUI::ThemeCache::load(in, createKey(), replayed, themeName));
+		replayed.getThemeCache()->stopRecording();
+		TS_ASSERT_EQUALS(themeName, "Test theme");
+
+		// Every draw step, layout element and variable is written with all
+		// of its fields, so both recordings are the same if nothing was lost
+		Common::MemoryWriteStreamDynamic rerecorded(DisposeAfterUse::YES);
+		TS_ASSERT(saveRecording(replayed, themeName, rerecorded));
+		TS_ASSERT_EQUALS(rerecorded.size(), recorded.size());
+		TS_ASSERT(rerecorded.size() == recorded.size() && !memcmp(rerecorded.getData(), recorded.getData(), recorded.size()));
+
+		GUI::ThemeEval *parsedEval = parsed.getEvaluator();
+		GUI::ThemeEval *replayedEval = replayed.getEvaluator();
+
+		static const char *const vars[] = {
+			"Globals.Line.Height", "Globals.Layout.Spacing", "Globals.Button.Width", "Globals.Button.Height"
+		};
+		for (int i = 0; i < ARRAYSIZE(vars); i++) {
+			TS_ASSERT(replayedEval->hasVar(vars[i]));
+			TS_ASSERT_EQUALS(replayedEval->getVar(vars[i], -1), parsedEval->getVar(vars[i], -1));
+		}
+		TS_ASSERT_EQUALS(replayedEval->getVar("Globals.Button.Width", -1), 108);
+
+		static const char *const widgets[] = { "Test.Title", "Test.Close" };
+		for (int i = 0; i < ARRAYSIZE(widgets); i++) {
+			int16 x1, y1, w1, h1, x2, y2, w2, h2;
+			bool rtl1, rtl2;
+			TS_ASSERT(parsedEval->getWidgetData(widgets[i], x1, y1, w1, h1, rtl1));
+			TS_ASSERT(replayedEval->getWidgetData(widgets[i], x2, y2, w2, h2, rtl2));
+			TS_ASSERT_EQUALS(w2, w1);
+			TS_ASSERT_EQUALS(h2, h1);
+			TS_ASSERT_EQUALS(rtl2, rtl1);
+			TS_ASSERT_EQUALS(replayedEval->getWidgetTextHAlign(widgets[i]), parsedEval->getWidgetTextHAlign(widgets[i]));
+		}
+		TS_ASSERT(replayedEval->hasDialog("Dialog.Test"));
+		TS_ASSERT(!replayedEval->hasOpenLayout());
+
+		const GUI::TextColorData *color = replayed.getTextColorData(GUI::kTextColorAlternative);
+		TS_ASSERT(color);
+		if (color) {
+			TS_ASSERT_EQUALS(color->r, 120);
+			TS_ASSERT_EQUALS(color->g, 80);
+			TS_ASSERT_EQUALS(color->b, 20);
+		}
+	}
+
+	void test_truncated_cache_is_rejected() {
+		GUI::ThemeEngine parsed("builtin", GUI::ThemeEngine::kGfxDisabled);
+		Common::MemoryWriteStreamDynamic recorded(DisposeAfterUse::YES);
+		TS_ASSERT(recordTheme(parsed, recorded));
+
+		// Cut anywhere, including between two elements and before the end marker
+		for (uint32 size = 0; size < recorded.size(); size++)
+			TS_ASSERT(!loadCache(recorded.getData(), size, createKey()));
+
+		TS_ASSERT(loadCache(recorded.getData(), recorded.size(), createKey()));
+	}
+
+	void test_wrong_key_is_rejected() {
+		GUI::ThemeEngine parsed("builtin", GUI::ThemeEngine::kGfxDisabled);
+		Common::MemoryWriteStreamDynamic recorded(DisposeAfterUse::YES);
+		TS_ASSERT(recordTheme(parsed, recorded));
+
+		GUI::ThemeCache::Key key = createKey();
+		key.themeHash++;
+		TS_ASSERT(!loadCache(recorded.getData(), recorded.size(), key));
+
+		key = createKey();
+		key.themeId = "other";
+		TS_ASSERT(!loadCache(recorded.getData(), recorded.size(), key));
+
+		key = createKey();
+		key.baseWidth = 320;
+		TS_ASSERT(!loadCache(recorded.getData(), recorded.size(), key));
+
+		key = createKey();
+		key.scaleFactor = 2.0f;
+		TS_ASSERT(!loadCache(recorded.getData(), recorded.size(), key));
+
+		key = createKey();
+		key.format = Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		TS_ASSERT(!loadCache(recorded.getData(), recorded.size(), key));
+
+		// And a file which is not a theme cache at all
+		Common::Array<byte> garbage(recorded.getData(), recorded.size());
+		garbage[0] ^= 0xFF;
+		TS_ASSERT(!loadCache(garbage.begin(), garbage.size(), createKey()));
+	}
+};
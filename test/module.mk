@@ -5,8 +5,9 @@
 #
 ######################################################################
 
-TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/common/formats/*.h $(srcdir)/test/audio/*.h $(srcdir)/test/math/*.h $(srcdir)/test/image/*.h
-TEST_LIBS    :=
+TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/common/compression/*.h $(srcdir)/test/common/formats/*.h $(srcdir)/test/graphics/*.h $(srcdir)/test/audio/*.h $(srcdir)/test/math/*.h $(srcdir)/test/image/*.h $(srcdir)/test/gui/*.h
+TEST_LIBS    := backends/saves/default/async-save-writer.o base/version.o \
+	gui/DrawDataCache.o gui/ThemeCache.o gui/ThemeEngine.o gui/ThemeEval.o gui/ThemeLayout.o gui/ThemeParser.o
 
 ifdef POSIX
 TEST_LIBS += test/null_osystem.o \
@@ -16,6 +17,10 @@ TEST_LIBS += test/null_osystem.o \
 	backends/fs/abstract-fs.o \
 	backends/fs/stdiostream.o \
 	backends/modular-backend.o
+
+ifdef USE_PTHREADS
+TEST_LIBS += backends/jobs/pthread/pthread-jobsystem.o
+endif
 endif
 
 ifdef WIN32
@@ -29,6 +34,8 @@ TEST_LIBS += test/null_osystem.o \
 endif
 
 TEST_LIBS +=	audio/libaudio.a math/libmath.a common/formats/libformats.a common/compression/libcompression.a common/libcommon.a image/libimage.a graphics/libgraphics.a
+# libgraphics depends on these again
+TEST_LIBS +=	common/compression/libcompression.a common/libcommon.a
 
 ifeq ($(ENABLE_WINTERMUTE), STATIC_PLUGIN)
 	TESTS += $(srcdir)/test/engines/wintermute/*.h
@@ -45,6 +52,13 @@ endif
 	TEST_LIBS += engines/ultima/libultima.a
 endif
 
+ifeq ($(ENABLE_SCUMM), STATIC_PLUGIN)
+ifdef ENABLE_SCUMM_7_8
+	TESTS += $(srcdir)/test/engines/scumm/*.h
+	TEST_LIBS += engines/scumm/libscumm.a
+endif
+endif
+
 ifeq ($(ENABLE_TWINE), STATIC_PLUGIN)
 	TESTS += $(srcdir)/test/engines/twine/*.h
 	TEST_LIBS += engines/twine/libtwine.a
@@ -84,15 +98,30 @@ test/runner.cpp: $(TESTS) $(srcdir)/test/module.mk
 	@mkdir -p test
 	$(srcdir)/test/cxxtest/cxxtestgen.py $(TEST_FLAGS) -o $@ $+
 
+# Micro-benchmarks; use BENCH_FLAGS to pass options, e.g. a name filter
+# or --format=csv. Configure with --enable-release for meaningful numbers.
+# libcommon is listed again since libgraphics depends on it.
+BENCH_SRCS := $(wildcard $(srcdir)/test/bench/*.cpp)
+
+bench: test/bench/runner
+	./test/bench/runner $(BENCH_FLAGS)
+test/bench/runner: $(BENCH_SRCS) $(srcdir)/test/bench/bench.h $(TEST_LIBS)
+	@mkdir -p test/bench
+	+$(QUIET_CXX)$(LD) $(TEST_CXXFLAGS) $(CPPFLAGS) $(TEST_CFLAGS) -o $@ $(BENCH_SRCS) $(TEST_LIBS) common/libcommon.a $(TEST_LDFLAGS)
+
 clean: clean-test
 clean-test:
-	-$(RM) test/runner.cpp test/runner test/engine-data/encoding.dat test/null_osystem.o
+	-$(RM) test/runner.cpp test/runner test/bench/runner test/engine-data/encoding.dat test/engine-data/GoMono-Regular.ttf test/null_osystem.o
 	-rmdir test/engine-data
 
 test/engine-data/encoding.dat: $(srcdir)/dists/engine-data/encoding.dat
 	$(MKDIR) test/engine-data
 	$(CP) $(srcdir)/dists/engine-data/encoding.dat test/engine-data/encoding.dat
 
-copy-dat: test/engine-data/encoding.dat
+test/engine-data/GoMono-Regular.ttf: $(srcdir)/gui/themes/fonts/GoMono-Regular.ttf
+	$(MKDIR) test/engine-data
+	$(CP) $(srcdir)/gui/themes/fonts/GoMono-Regular.ttf test/engine-data/GoMono-Regular.ttf
+
+copy-dat: test/engine-data/encoding.dat test/engine-data/GoMono-Regular.ttf
 
-.PHONY: test clean-test copy-dat
+.PHONY: test bench clean-test copy-dat